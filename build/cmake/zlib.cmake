@@ -20,3 +20,5 @@ target_compile_definitions(z
 target_include_directories(z PUBLIC ${ZLIB_INCLUDE_DIR})
 
 endif()
+
+target_link_libraries(rainbow z)
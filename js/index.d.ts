@@ -125,6 +125,7 @@ declare namespace Rainbow {
     constructor();
     alignment(): TextAlignment;
     alignment(alignment: TextAlignment): Label;
+    append(text: string): Label;
     angle(): number;
     angle(r: number): Label;
     color(): Color;
@@ -351,6 +352,10 @@ declare namespace Rainbow {
     const pointersUp: ReadonlyArray<Readonly<Pointer>>;
   }
 
+  export namespace Prefetcher {
+    function prefetch(path: string): void;
+  }
+
   export namespace RenderQueue {
     function add(obj: Animation | Label | SpriteBatch): void;
     function disable(obj: Animation | Label | SpriteBatch | number | string): void;
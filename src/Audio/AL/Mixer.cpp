@@ -4,7 +4,10 @@
 
 #include "Audio/AL/Mixer.h"
 
+#include <array>
+#include <cinttypes>
 #include <cstdint>
+#include <cstdio>
 
 #include "Platform/Macros.h"
 #if defined(RAINBOW_OS_IOS) || defined(RAINBOW_OS_MACOS)
@@ -22,6 +25,7 @@
 #include "Audio/Mixer.h"
 #include "Common/Logging.h"
 #include "Common/TypeCast.h"
+#include "FileSystem/FileSystem.h"
 #include "FileSystem/Path.h"
 #include "Memory/SmallBuffer.h"
 
@@ -205,11 +209,27 @@ void ALMixer::suspend(bool should_suspend)
     }
 }
 
-auto ALMixer::create_sound(czstring path) -> Sound*
+auto ALMixer::create_sound(czstring path, bool is_stream) -> Sound*
 {
+    // Static sounds are read-only once loaded, so files with identical
+    // contents can share a buffer. PhysicsFS paths cannot contain ':', so
+    // the key does not collide with any path.
+    if (const auto content_hash =
+            is_stream ? std::nullopt : filesystem::content_hash(path)) {
+        std::array<char, 25> key{};
+        std::snprintf(
+            key.data(), key.size(), "content:%016" PRIx64, *content_hash);
+        auto [i, _] = sounds_.try_emplace(key.data());
+        NOT_USED(_);
+        i->second.key = i->first.c_str();
+        ++i->second.use_count;
+        return &i->second;
+    }
+
     auto [i, _] = sounds_.insert_or_assign(path, {});
     NOT_USED(_);
     i->second.key = i->first.c_str();
+    i->second.use_count = 1;
     return &i->second;
 }
 
@@ -254,7 +274,7 @@ ALMixer::~ALMixer()
 
 auto rainbow::audio::load_sound(czstring path) -> Sound*
 {
-    auto sound = al_mixer->create_sound(path);
+    auto sound = al_mixer->create_sound(path, false);
     if (sound == nullptr || sound->buffer > 0)
         return sound;
 
@@ -284,7 +304,7 @@ auto rainbow::audio::load_sound(czstring path) -> Sound*
 
 auto rainbow::audio::load_stream(czstring path) -> Sound*
 {
-    auto sound = al_mixer->create_sound(path);
+    auto sound = al_mixer->create_sound(path, true);
     if (sound == nullptr || sound->file != nullptr)
         return sound;
 
@@ -306,6 +326,10 @@ auto rainbow::audio::load_stream(czstring path) -> Sound*
 
 void rainbow::audio::release(Sound* sound)
 {
+    // Shared sounds are only released with their last user
+    if (--sound->use_count > 0)
+        return;
+
     const auto stream = sound->stream;
     const auto buffer = sound->buffer;
 
@@ -35,7 +35,12 @@ namespace rainbow::audio
         void process();
         void suspend(bool should_suspend);
 
-        auto create_sound(czstring path) -> Sound*;
+        /// <summary>
+        ///   Returns a new sound for <paramref name="path"/>. Static sounds
+        ///   with identical contents are shared, and may be returned already
+        ///   loaded.
+        /// </summary>
+        auto create_sound(czstring path, bool is_stream) -> Sound*;
         auto get_channel() -> Channel*;
         void release(Sound* sound);
 
@@ -17,6 +17,7 @@ namespace rainbow::audio
         unsigned int buffer = 0;
         std::unique_ptr<IAudioFile> file;
         czstring key = nullptr;
+        int use_count = 0;
     };
 }  // namespace rainbow::audio
 
@@ -8,8 +8,11 @@
 #include <cstddef>
 #include <cstdint>
 #include <type_traits>
+#include <utility>
 
 #include "Common/NonCopyable.h"
+#include "FileSystem/MemoryMappedFile.h"
+#include "Memory/BufferPool.h"
 #include "Platform/Macros.h"
 
 namespace rainbow
@@ -34,8 +37,19 @@ namespace rainbow
         enum class Ownership {
             Owner,
             Reference,
+            Mapped,  // Buffer is a read-only view of a memory mapped file
+            Pooled,  // Buffer is returned to the buffer pool on destruction
         };
 
+        /// <summary>
+        ///   Allocates a null-terminated buffer of <paramref name="size"/>
+        ///   bytes from the buffer pool.
+        /// </summary>
+        static auto allocate(size_t size)
+        {
+            return Data{buffer_pool::allocate(size), size, Ownership::Pooled};
+        }
+
         template <typename T, size_t N>
         static auto from_bytes(const T (&bytes)[N])
         {
@@ -60,6 +74,7 @@ namespace rainbow
         {
             d.data_ = nullptr;
             d.size_ = 0;
+            d.ownership_ = Ownership::Reference;
         }
 
         /// <summary>Constructs a wrapper around a buffer.</summary>
@@ -72,10 +87,28 @@ namespace rainbow
 
         ~Data()
         {
-            if (ownership_ != Ownership::Owner)
-                return;
+            switch (ownership_) {
+                case Ownership::Owner:
+                    operator delete(data_);
+                    break;
+                case Ownership::Reference:
+                    break;
+                case Ownership::Mapped:
+                    MemoryMappedFile::unmap(data_, size_);
+                    break;
+                case Ownership::Pooled:
+                    buffer_pool::deallocate(data_, size_);
+                    break;
+            }
+        }
 
-            operator delete(data_);
+        auto operator=(Data&& d) noexcept -> Data&
+        {
+            // The previous buffer is released when `d` goes out of scope.
+            std::swap(data_, d.data_);
+            std::swap(size_, d.size_);
+            std::swap(ownership_, d.ownership_);
+            return *this;
         }
 
         template <typename T>
@@ -90,6 +123,9 @@ namespace rainbow
         /// </returns>
         [[nodiscard]] auto bytes() const { return as<uint8_t*>(); }
 
+        /// <summary>Returns how the buffer is owned.</summary>
+        [[nodiscard]] auto ownership() const { return ownership_; }
+
         /// <summary>Returns the size of this buffer.</summary>
         [[nodiscard]] auto size() const { return size_; }
 
@@ -0,0 +1,48 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef COMMON_HASH_H_
+#define COMMON_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace rainbow
+{
+    constexpr uint64_t kFNV1aOffsetBasis = 0xcbf29ce484222325;
+    constexpr uint64_t kFNV1aPrime = 0x100000001b3;
+
+    /// <summary>
+    ///   Returns the 64-bit FNV-1a hash of <paramref name="size"/> bytes at
+    ///   <paramref name="data"/>. Pass a previous hash as
+    ///   <paramref name="hash"/> to continue hashing.
+    /// </summary>
+    /// <remarks>
+    ///   Unlike <c>std::hash</c> and <c>absl::Hash</c>, the result is stable
+    ///   across runs and platforms, and may be persisted.
+    /// </remarks>
+    constexpr auto fnv1a(const uint8_t* data,
+                         size_t size,
+                         uint64_t hash = kFNV1aOffsetBasis) -> uint64_t
+    {
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= data[i];
+            hash *= kFNV1aPrime;
+        }
+        return hash;
+    }
+
+    constexpr auto fnv1a(std::string_view str,
+                         uint64_t hash = kFNV1aOffsetBasis) -> uint64_t
+    {
+        for (auto c : str) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= kFNV1aPrime;
+        }
+        return hash;
+    }
+}  // namespace rainbow
+
+#endif
@@ -32,6 +32,9 @@ namespace
         uint64_t allow_hidpi;
         uint64_t suspend_on_focus_lost;
         uint64_t accelerometer;
+        uint64_t texture_memory_budget;
+        uint64_t texture_color_depth;
+        uint64_t texture_dithering;
     };
 
     template <typename F>
@@ -43,11 +46,47 @@ namespace
 
         f(value != "0"sv && value != "false"sv);
     }
+
+    auto to_packing(std::string_view value)
+    {
+        using rainbow::Image;
+
+        if (value == "RGBA4444"sv)
+            return Image::Packing::RGBA4444;
+        if (value == "RGB565"sv)
+            return Image::Packing::RGB565;
+        if (value == "RGBA5551"sv)
+            return Image::Packing::RGBA5551;
+
+        if (value != "RGBA8888"sv)
+            LOGW("Unknown texture colour depth: %.*s",
+                 static_cast<int>(value.size()),
+                 value.data());
+        return Image::Packing::None;
+    }
+
+    auto to_dithering(std::string_view value)
+    {
+        using rainbow::graphics::Dithering;
+
+        if (value == "ordered"sv)
+            return Dithering::Ordered;
+        if (value == "diffusion"sv)
+            return Dithering::FloydSteinberg;
+
+        if (value != "none"sv)
+            LOGW("Unknown texture dithering: %.*s",
+                 static_cast<int>(value.size()),
+                 value.data());
+        return Dithering::None;
+    }
 }  // namespace
 
 rainbow::Config::Config()
-    : width_(0), height_(0), msaa_(0), hidpi_(false), suspend_(true),
-      accelerometer_(false)
+    : width_(0), height_(0), msaa_(0), texture_memory_budget_(0),
+      texture_packing_(Image::Packing::None),
+      texture_dithering_(graphics::Dithering::None), hidpi_(false),
+      suspend_(true), accelerometer_(false)
 {
     if (!filesystem::exists(kConfigINI)) {
         LOGI("No config file was found");
@@ -67,6 +106,9 @@ rainbow::Config::Config()
         hash("AllowHiDPI"sv),
         hash("SuspendOnFocusLost"sv),
         hash("Accelerometer"sv),
+        hash("TextureMemoryBudget"sv),
+        hash("TextureColorDepth"sv),
+        hash("TextureDithering"sv),
     };
 
     panini::parse(  //
@@ -101,6 +143,14 @@ rainbow::Config::Config()
                 with_bool(value, [this](bool v) { suspend_ = v; });
             } else if (hashed_key == keys.accelerometer) {
                 with_bool(value, [this](bool v) { accelerometer_ = v; });
+            } else if (hashed_key == keys.texture_memory_budget) {
+                const auto megabytes = std::max(atoi(value.data()), 0);
+                texture_memory_budget_ =
+                    static_cast<size_t>(megabytes) * 1024 * 1024;
+            } else if (hashed_key == keys.texture_color_depth) {
+                texture_packing_ = to_packing(value);
+            } else if (hashed_key == keys.texture_dithering) {
+                texture_dithering_ = to_dithering(value);
             }
         });
 }
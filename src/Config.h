@@ -5,6 +5,10 @@
 #ifndef CONFIG_H_
 #define CONFIG_H_
 
+#include <cstddef>
+
+#include "Graphics/ColorDepth.h"
+
 namespace rainbow
 {
     /// <summary>Load game configuration.</summary>
@@ -23,7 +27,16 @@ namespace rainbow
     ///   AllowHiDPI = false
     ///   SuspendOnFocusLost = true
     ///   Accelerometer = false
+    ///   TextureMemoryBudget = 0
+    ///   TextureColorDepth = RGBA8888
+    ///   TextureDithering = none
     ///   </code>
+    ///
+    ///   <c>TextureMemoryBudget</c> is in megabytes; 0 means no limit.
+    ///   <c>TextureColorDepth</c> is one of <c>RGBA8888</c>,
+    ///   <c>RGBA4444</c>, <c>RGB565</c> or <c>RGBA5551</c>.
+    ///   <c>TextureDithering</c> is one of <c>none</c>, <c>ordered</c> or
+    ///   <c>diffusion</c>.
     /// </remarks>
     class Config
     {
@@ -58,10 +71,36 @@ namespace rainbow
         /// <summary>Returns whether to suspend when focus is lost.</summary>
         [[nodiscard]] auto suspend() const { return suspend_; }
 
+        /// <summary>
+        ///   Returns how decoded textures should be dithered when they are
+        ///   packed into 16 bits.
+        /// </summary>
+        [[nodiscard]] auto texture_dithering() const
+        {
+            return texture_dithering_;
+        }
+
+        /// <summary>
+        ///   Returns the amount of texture memory to stay within, in bytes.
+        /// </summary>
+        [[nodiscard]] auto texture_memory_budget() const
+        {
+            return texture_memory_budget_;
+        }
+
+        /// <summary>
+        ///   Returns how decoded textures should be packed into 16 bits, if at
+        ///   all.
+        /// </summary>
+        [[nodiscard]] auto texture_packing() const { return texture_packing_; }
+
     private:
         int width_;
         int height_;
         unsigned int msaa_;
+        size_t texture_memory_budget_;
+        Image::Packing texture_packing_;
+        graphics::Dithering texture_dithering_;
         bool hidpi_;
         bool suspend_;
         bool accelerometer_;
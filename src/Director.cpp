@@ -6,7 +6,12 @@
 
 #include "Common/Logging.h"
 #include "Common/Random.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Graphics/ImageCache.h"
+#include "Memory/BufferPool.h"
 #include "Script/NoGame.h"
+#include "Text/FontBaker.h"
 
 #ifdef USE_PHYSICS
 #    include "ThirdParty/Box2D/DebugDraw.h"
@@ -14,6 +19,7 @@
 
 namespace
 {
+    constexpr char kImageCacheDirectory[] = "texture-cache";
     constexpr int kMaxAudioChannels = 24;
 }  // namespace
 
@@ -24,10 +30,19 @@ namespace rainbow
     Director::Director()
         : active_(true), terminated_(false), error_(ErrorCode::Success)
     {
+        if (filesystem::create_directories(kImageCacheDirectory)) {
+            renderer_.texture_provider.set_image_cache(
+                std::make_unique<graphics::ImageCache>(
+                    filesystem::preferences_directory() /
+                    kImageCacheDirectory));
+        }
+
         if (std::error_code error = mixer_.initialize(kMaxAudioChannels))
             terminate(error);
         else if (std::error_code error = renderer_.initialize())
             terminate(error);
+        else if (filesystem::exists(text::kFontAtlasFile))
+            load_font_atlas();
 
         IF_DEBUG(make_global());
     }
@@ -78,6 +93,7 @@ namespace rainbow
         timer_manager_.update(dt);
         script_->update(dt);
 
+        texture_provider().update();
         graphics::update(*script_, render_queue_, dt);
         font_cache().update(texture_provider());
         mixer_.process();
@@ -95,15 +111,28 @@ namespace rainbow
     {
         active_ = false;
         mixer_.suspend(true);
+
+        // The app may be killed without notice while in the background.
+        file_writer_.flush();
     }
 
     void Director::on_memory_warning()
     {
         R_ASSERT(!terminated_, "App should have terminated by now");
 
+        prefetcher_.clear();
+        buffer_pool::clear();
+        texture_provider().purge();
         script_->on_memory_warning();
     }
 
+    void Director::load_font_atlas()
+    {
+        const auto atlas = File::read(text::kFontAtlasFile, FileType::Asset);
+        if (!font_cache().load(atlas))
+            LOGW("Failed to load '%s'", text::kFontAtlasFile);
+    }
+
     void Director::start()
     {
         script_ = GameBase::create(*this);
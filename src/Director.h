@@ -7,6 +7,8 @@
 
 #include "Audio/Mixer.h"
 #include "Common/Global.h"
+#include "FileSystem/FileWriter.h"
+#include "FileSystem/Prefetcher.h"
 #include "Graphics/RenderQueue.h"
 #include "Graphics/Renderer.h"
 #include "Input/Input.h"
@@ -35,6 +37,8 @@ namespace rainbow
         [[nodiscard]] auto active() const { return active_; }
         [[nodiscard]] auto error() const { return error_; }
 
+        [[nodiscard]] auto file_writer() -> FileWriter& { return file_writer_; }
+
         [[nodiscard]] auto font_cache() -> FontCache&
         {
             return typesetter_.font_cache();
@@ -47,6 +51,7 @@ namespace rainbow
 
         [[nodiscard]] auto input() -> Input& { return input_; }
         [[nodiscard]] auto mixer() -> audio::Mixer& { return mixer_; }
+        [[nodiscard]] auto prefetcher() -> Prefetcher& { return prefetcher_; }
 
         [[nodiscard]] auto render_queue() -> graphics::RenderQueue&
         {
@@ -120,6 +125,8 @@ namespace rainbow
         bool active_;
         bool terminated_;
         std::error_code error_;
+        FileWriter file_writer_;
+        Prefetcher prefetcher_;
         TimerManager timer_manager_;
         std::unique_ptr<GameBase> script_;
         graphics::RenderQueue render_queue_;
@@ -128,6 +135,7 @@ namespace rainbow
         audio::Mixer mixer_;
         Typesetter typesetter_;
 
+        void load_font_atlas();
         void start();
     };
 }  // namespace rainbow
@@ -6,6 +6,8 @@
 
 #include <array>
 
+#include "FileSystem/Pack.h"
+
 using rainbow::filesystem::Path;
 
 namespace
@@ -16,6 +18,12 @@ namespace
         auto header = rainbow::system::file_header(path.c_str());
         return memcmp(header.data(), kPKZIP.data(), kPKZIP.size()) == 0;
     }
+
+    auto is_pack_file(const Path& path)
+    {
+        auto header = rainbow::system::file_header(path.c_str());
+        return rainbow::Pack::is_pack(header.data(), header.size());
+    }
 }  // namespace
 
 Bundle::Bundle(ArrayView<zstring> args) : main_script_(nullptr)
@@ -34,7 +42,7 @@ Bundle::Bundle(ArrayView<zstring> args) : main_script_(nullptr)
         }
 
         if (system::is_regular_file(script_path.c_str())) {
-            if (is_zip_file(script_path)) {
+            if (is_zip_file(script_path) || is_pack_file(script_path)) {
                 assets_path_ = std::move(script_path);
                 return;
             }
@@ -15,6 +15,10 @@
 #include "Common/Logging.h"
 #include "Common/NonCopyable.h"
 #include "Common/String.h"
+#include "FileSystem/FileSystem.h"
+#include "FileSystem/MemoryMappedFile.h"
+#include "FileSystem/Pack.h"
+#include "FileSystem/Prefetcher.h"
 #include "Platform/Macros.h"
 
 #ifdef RAINBOW_OS_ANDROID
@@ -27,6 +31,12 @@ namespace rainbow
 {
     constexpr size_t kInvalidFileSize = std::numeric_limits<size_t>::max();
 
+    /// <summary>
+    ///   Files at least this large are mapped into memory instead of copied
+    ///   when read, if possible.
+    /// </summary>
+    constexpr size_t kMinMappedFileSize = 16 * 1024;
+
     enum class FileType {
         Asset,
         UserAsset,
@@ -79,12 +89,35 @@ namespace rainbow
 
         static auto read(czstring path, FileType file_type) -> Data
         {
+            if (file_type == FileType::Asset) {
+                if (auto prefetcher = Prefetcher::Get()) {
+                    if (auto data = prefetcher->take(path))
+                        return data;
+                }
+            }
+
+            return read_uncached(path, file_type);
+        }
+
+        /// <summary>
+        ///   Reads the whole file, bypassing <see cref="Prefetcher"/>.
+        /// </summary>
+        static auto read_uncached(czstring path, FileType file_type) -> Data
+        {
+            if (file_type == FileType::Asset) {
+                if (auto data = Pack::read_mounted(path))
+                    return data;
+            }
+
             const auto& file = open(path, file_type);
             if (!file) {
                 LOGW("No such file: %s", path);
                 return {};
             }
 
+            if (auto data = file.map(T::resolve_path(path, file_type).c_str()))
+                return data;
+
             return read(file);
         }
 
@@ -192,27 +225,67 @@ namespace rainbow
             U file;
             if (!is_empty(path)) {
                 const auto real_path = T::resolve_path(path, file_type);
-                if (!T::open(real_path.c_str(), file_type, std::ref(file)))
+                if (!T::open(real_path.c_str(), file_type, std::ref(file))) {
+                    // Files created outside of PhysicsFS, e.g. by another
+                    // process, are missing from the index until it is
+                    // rebuilt. Add them as they are found.
+                    const bool is_indexed =
+                        filesystem::exists(real_path.c_str());
                     file.set_handle(PHYSFS_openRead(real_path.c_str()));
+                    if (file && !is_indexed)
+                        filesystem::invalidate_index(real_path.c_str());
+                }
             }
 
             return file;
         }
 
+        /// <summary>
+        ///   Maps the file into memory if it is on the local filesystem, i.e.
+        ///   not inside an archive or an Android asset.
+        /// </summary>
+        /// <remarks>
+        ///   Like <see cref="read"/>, the returned buffer must be
+        ///   null-terminated. Mappings are zero-filled up to the next page
+        ///   boundary so this holds as long as the file size is not a
+        ///   multiple of the page size. Small files are cheaper to copy.
+        /// </remarks>
+        [[nodiscard]] auto map(czstring path) const -> Data
+        {
+            if CONSTEXPR (T::is_platform_handle()) {
+                return {};
+            } else {
+                const auto file_size = size();
+                if (file_size < kMinMappedFileSize ||
+                    file_size % MemoryMappedFile::page_size() == 0) {
+                    return {};
+                }
+
+                const auto real_path = filesystem::real_path(path);
+                if (!system::is_regular_file(real_path.c_str()))
+                    return {};
+
+                MemoryMappedFile mapping{real_path.c_str()};
+                if (mapping.size() != file_size)
+                    return {};
+
+                return mapping.release();
+            }
+        }
+
         static auto read(const TFile& file) -> Data
         {
             const size_t size = file.size();
             if (size == 0)
                 return {};
 
-            auto buffer = std::make_unique<uint8_t[]>(size + 1);
-            if (file.read(buffer.get(), size) != size)
+            // The buffer is null-terminated so it also can be used as a string
+            // without copying.
+            auto buffer = Data::allocate(size);
+            if (file.read(buffer.bytes(), size) != size)
                 return {};
 
-            // Ensure the buffer is null-terminated so it also can be used as a
-            // string without copying.
-            buffer[size] = 0;
-            return {buffer.release(), size, Data::Ownership::Owner};
+            return buffer;
         }
 
     private:
@@ -245,8 +318,13 @@ namespace rainbow
             if (!is_empty(path)) {
                 constexpr auto file_type = FileType::UserFile;
                 const auto real_path = T::resolve_path(path, file_type);
-                if (!T::open(real_path.c_str(), file_type, std::ref(file)))
+                if (!T::open(real_path.c_str(), file_type, std::ref(file))) {
                     file.set_handle(PHYSFS_openWrite(real_path.c_str()));
+
+                    // A new file was created in the write directory
+                    if (file && !filesystem::exists(real_path.c_str()))
+                        filesystem::invalidate_index(real_path.c_str());
+                }
             }
 
             return file;
@@ -0,0 +1,142 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/FileStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "FileSystem/Pack.h"
+#include "FileSystem/Prefetcher.h"
+
+using rainbow::czstring;
+using rainbow::Data;
+using rainbow::File;
+using rainbow::FileStream;
+using rainbow::FileType;
+using rainbow::Pack;
+using rainbow::Prefetcher;
+
+namespace
+{
+    auto read_in_memory(czstring path, FileType file_type) -> Data
+    {
+        if (file_type != FileType::Asset)
+            return {};
+
+        if (auto prefetcher = Prefetcher::Get()) {
+            if (auto data = prefetcher->take(path))
+                return data;
+        }
+
+        return Pack::map_mounted(path);
+    }
+}  // namespace
+
+FileStream::FileStream(czstring path, FileType file_type, size_t chunk_size)
+    : path_(path), file_type_(file_type),
+      data_(read_in_memory(path, file_type)),
+      file_(data_ ? File{} : File::open(path, file_type)),
+      chunk_size_(chunk_size)
+{
+    R_ASSERT(chunk_size > 0, "Chunk size must be greater than 0");
+
+    if (data_) {
+        size_ = data_.size();
+        end_ = size_;
+    } else if (file_) {
+        size_ = file_.size();
+        buffer_ = std::make_unique<uint8_t[]>(chunk_size_);
+    } else {
+        LOGW("No such file: %s", path);
+    }
+}
+
+auto FileStream::peek(size_t size) -> ArrayView<uint8_t>
+{
+    R_ASSERT(size <= chunk_size_, "Cannot peek past the chunk size");
+
+    if (end_ - begin_ < size && file_) {
+        // Move the remaining bytes to the front to make room for more.
+        const auto remaining = end_ - begin_;
+        memmove(buffer_.get(), buffer_.get() + begin_, remaining);
+        begin_ = 0;
+        end_ = remaining + fill(remaining);
+    }
+
+    const auto available = std::min(size, end_ - begin_);
+    if (available == 0)
+        return {};
+
+    return {buffer() + begin_, available};
+}
+
+auto FileStream::read(void* dst, size_t size) -> size_t
+{
+    auto out = static_cast<uint8_t*>(dst);
+    size_t total = 0;
+    while (total < size) {
+        if (begin_ == end_) {
+            if (!file_)
+                break;
+
+            // Large reads go straight to the destination; there is nothing
+            // to gain from reading ahead.
+            const auto wanted = size - total;
+            if (wanted >= chunk_size_) {
+                const auto read = file_.read(out + total, wanted);
+                if (read == 0 || read > wanted)
+                    break;
+
+                total += read;
+                continue;
+            }
+
+            begin_ = 0;
+            end_ = fill(0);
+            if (end_ == 0)
+                break;
+        }
+
+        const auto count = std::min(size - total, end_ - begin_);
+        memcpy(out + total, buffer() + begin_, count);
+        begin_ += count;
+        total += count;
+    }
+
+    position_ += total;
+    return total;
+}
+
+auto FileStream::read_all() -> Data
+{
+    if (!*this)
+        return {};
+
+    if (position_ == 0) {
+        position_ = size_;
+        begin_ = end_;
+        if (data_)
+            return std::move(data_);
+
+        return File::read_uncached(path_.c_str(), file_type_);
+    }
+
+    const auto remaining = size_ - position_;
+    if (remaining == 0)
+        return {};
+
+    auto buffer = Data::allocate(remaining);
+    if (read(buffer.bytes(), remaining) != remaining)
+        return {};
+
+    return buffer;
+}
+
+auto FileStream::fill(size_t offset) -> size_t
+{
+    const auto size = chunk_size_ - offset;
+    const auto read = file_.read(buffer_.get() + offset, size);
+    return read > size ? 0 : read;  // PhysicsFS returns -1 on error
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef FILESYSTEM_FILESTREAM_H_
+#define FILESYSTEM_FILESTREAM_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "Common/Data.h"
+#include "Common/NonCopyable.h"
+#include "Common/String.h"
+#include "FileSystem/File.h"
+#include "Memory/Array.h"
+
+namespace rainbow
+{
+    /// <summary>
+    ///   Reads a file sequentially through a fixed-size buffer, so that
+    ///   decoders can consume large assets without holding all of it in
+    ///   memory.
+    /// </summary>
+    /// <remarks>
+    ///   <para>
+    ///     The buffer is allocated once and refilled a whole chunk at a time,
+    ///     regardless of how much the consumer asks for. Reads larger than a
+    ///     chunk bypass the buffer altogether.
+    ///   </para>
+    ///   <para>
+    ///     Assets that are already in memory, i.e. prefetched or stored
+    ///     uncompressed in a mounted pack, are streamed from there instead.
+    ///     LZ4 compressed pack entries are decompressed a block at a time as
+    ///     they are read; deflated entries are inflated whole.
+    ///   </para>
+    /// </remarks>
+    class FileStream : private NonCopyable<FileStream>
+    {
+    public:
+        static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+        FileStream(czstring path,
+                   FileType file_type,
+                   size_t chunk_size = kDefaultChunkSize);
+
+        [[nodiscard]] auto chunk_size() const { return chunk_size_; }
+
+        /// <summary>Returns whether the whole file has been read.</summary>
+        [[nodiscard]] auto eof() const { return position_ >= size_; }
+
+        /// <summary>
+        ///   Returns up to <paramref name="size"/> bytes from the current
+        ///   position without consuming them. <paramref name="size"/> must
+        ///   not exceed the chunk size.
+        /// </summary>
+        [[nodiscard]] auto peek(size_t size) -> ArrayView<uint8_t>;
+
+        /// <summary>
+        ///   Reads <paramref name="size"/> bytes into <paramref name="dst"/>.
+        /// </summary>
+        /// <returns>
+        ///   Number of bytes read; less than requested only at end of file
+        ///   or on error.
+        /// </returns>
+        auto read(void* dst, size_t size) -> size_t;
+
+        /// <summary>
+        ///   Reads the rest of the file into a null-terminated buffer, for
+        ///   consumers that cannot work incrementally.
+        /// </summary>
+        /// <remarks>
+        ///   If nothing has been consumed yet, this is equivalent to
+        ///   <see cref="File::read"/>, i.e. in-memory assets are handed over
+        ///   without copying and large files are mapped.
+        /// </remarks>
+        [[nodiscard]] auto read_all() -> Data;
+
+        /// <summary>Returns the file size.</summary>
+        [[nodiscard]] auto size() const { return size_; }
+
+        /// <summary>Returns the number of bytes consumed.</summary>
+        [[nodiscard]] auto tell() const { return position_; }
+
+        explicit operator bool() const { return data_ || file_; }
+
+    private:
+        std::string path_;
+        FileType file_type_;
+        Data data_;
+        File file_;
+        std::unique_ptr<uint8_t[]> buffer_;
+        size_t chunk_size_;
+        size_t size_ = 0;
+        size_t position_ = 0;
+        size_t begin_ = 0;  // Start of unconsumed bytes in buffer
+        size_t end_ = 0;    // End of buffered bytes
+
+        [[nodiscard]] auto buffer() const
+        {
+            return data_ ? data_.bytes() : buffer_.get();
+        }
+
+        auto fill(size_t offset) -> size_t;
+    };
+}  // namespace rainbow
+
+#endif
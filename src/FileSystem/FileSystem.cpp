@@ -9,23 +9,287 @@
 #    include <filesystem>
 #else
 #    include <climits>
+#    include <cstdio>
 #    include <sys/stat.h>
 #    include <unistd.h>
 #endif
 
+#include <fcntl.h>
+#ifdef RAINBOW_OS_WINDOWS
+#    include <io.h>
+#else
+#    include <unistd.h>
+#endif
+
 #if defined(RAINBOW_OS_ANDROID)
 #    include <android/native_activity.h>
 extern ANativeActivity* g_native_activity;
 #endif
 
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <absl/container/flat_hash_map.h>
 #include <physfs.h>
 
 #include "Common/Logging.h"
 #include "FileSystem/Bundle.h"
+#include "FileSystem/Pack.h"
+
+using rainbow::czstring;
+using rainbow::filesystem::Path;
 
 namespace
 {
+    /// <summary>
+    ///   Type and location of every file and directory in the search path.
+    /// </summary>
+    /// <remarks>
+    ///   Paths the index cannot answer for, i.e. paths that are not in the
+    ///   canonical form PhysicsFS uses, or that may be behind a symbolic link,
+    ///   are passed on to PhysicsFS.
+    /// </remarks>
+    class PathIndex
+    {
+    public:
+        void invalidate()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            valid_ = false;
+        }
+
+        /// <summary>
+        ///   Updates the entry for a single file, rather than discarding the
+        ///   whole index.
+        /// </summary>
+        void invalidate(czstring path)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!valid_)
+                return;
+
+            const auto key = canonical(path);
+            if (!key) {
+                valid_ = false;
+                return;
+            }
+
+            std::string file{*key};
+            entries_.erase(file);
+
+            PHYSFS_Stat stat{};
+            if (PHYSFS_stat(file.c_str(), &stat) == 0)
+                return;
+
+            // New directories may contain anything
+            if (stat.filetype != PHYSFS_FILETYPE_REGULAR) {
+                valid_ = false;
+                return;
+            }
+
+            add(std::move(file), stat.filetype);
+        }
+
+        auto is_in_real_dir(std::string_view path, std::string_view real_dir)
+            -> bool
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (auto entry = find(path)) {
+                    return *entry != nullptr &&
+                           real_dirs_[(*entry)->real_dir] == real_dir;
+                }
+            }
+
+            const std::string file{path};
+            auto containing_dir = PHYSFS_getRealDir(file.c_str());
+            return containing_dir != nullptr && containing_dir == real_dir;
+        }
+
+        auto real_path(czstring path) -> Path
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (auto entry = find(path)) {
+                    if (*entry == nullptr)
+                        return path;
+
+                    Path resolved_path{real_dirs_[(*entry)->real_dir]};
+                    resolved_path /= path;
+                    return resolved_path;
+                }
+            }
+
+            auto containing_dir = PHYSFS_getRealDir(path);
+            if (containing_dir == nullptr) {
+                return path;
+            }
+
+            Path resolved_path{containing_dir};
+            resolved_path /= path;
+            return resolved_path;
+        }
+
+        auto type(czstring path) -> std::optional<PHYSFS_FileType>
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (auto entry = find(path)) {
+                    if (*entry == nullptr)
+                        return std::nullopt;
+
+                    return (*entry)->type;
+                }
+            }
+
+            PHYSFS_Stat stat{};
+            if (PHYSFS_stat(path, &stat) == 0)
+                return std::nullopt;
+
+            return stat.filetype;
+        }
+
+        void update()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            build();
+        }
+
+    private:
+        struct Entry {
+            PHYSFS_FileType type;
+            uint32_t real_dir;
+        };
+
+        std::mutex mutex_;
+        absl::flat_hash_map<std::string, Entry> entries_;
+        std::vector<std::string> real_dirs_;
+        bool valid_ = false;
+        bool complete_ = false;  // Whether misses can be trusted
+
+        /// <summary>
+        ///   Strips leading slashes; returns nothing if the path is in any
+        ///   other way different from how PhysicsFS stores it.
+        /// </summary>
+        static auto canonical(std::string_view path)
+            -> std::optional<std::string_view>
+        {
+            while (!path.empty() && path.front() == '/')
+                path.remove_prefix(1);
+
+            for (size_t begin = 0; begin < path.size();) {
+                auto end = path.find('/', begin);
+                if (end == std::string_view::npos)
+                    end = path.size();
+
+                const auto component = path.substr(begin, end - begin);
+                if (component.empty() || component == "." ||
+                    component == ".." ||
+                    component.find_first_of(":\\") != std::string_view::npos) {
+                    return std::nullopt;
+                }
+
+                begin = end + 1;
+            }
+
+            return path;
+        }
+
+        void build()
+        {
+            if (valid_)
+                return;
+
+            entries_.clear();
+            real_dirs_.clear();
+            complete_ = true;
+            valid_ = true;
+
+            std::vector<std::string> directories{""};
+            std::vector<std::string> children;
+            add("", PHYSFS_FILETYPE_DIRECTORY);
+            while (!directories.empty()) {
+                const auto directory = std::move(directories.back());
+                directories.pop_back();
+
+                children.clear();
+                PHYSFS_enumerate(
+                    directory.c_str(),
+                    [](void* data, const char*, const char* name) {
+                        static_cast<std::vector<std::string>*>(data)
+                            ->emplace_back(name);
+                        return PHYSFS_ENUM_OK;
+                    },
+                    &children);
+
+                for (auto&& child : children) {
+                    auto path = directory.empty() ? std::move(child)
+                                                  : directory + '/' + child;
+
+                    PHYSFS_Stat stat{};
+                    if (PHYSFS_stat(path.c_str(), &stat) == 0)
+                        continue;
+
+                    switch (stat.filetype) {
+                        case PHYSFS_FILETYPE_DIRECTORY:
+                            directories.push_back(path);
+                            break;
+                        case PHYSFS_FILETYPE_SYMLINK:
+                            // We don't know what's on the other side
+                            complete_ = false;
+                            break;
+                        default:
+                            break;
+                    }
+
+                    add(std::move(path), stat.filetype);
+                }
+            }
+        }
+
+        void add(std::string path, PHYSFS_FileType type)
+        {
+            const auto containing_dir = PHYSFS_getRealDir(path.c_str());
+            const std::string_view real_dir =
+                containing_dir == nullptr ? "" : containing_dir;
+            auto i = std::find(real_dirs_.begin(), real_dirs_.end(), real_dir);
+            if (i == real_dirs_.end())
+                i = real_dirs_.emplace(i, real_dir);
+
+            const auto index = static_cast<uint32_t>(i - real_dirs_.begin());
+            entries_.try_emplace(std::move(path), Entry{type, index});
+        }
+
+        /// <summary>
+        ///   Returns the entry at <paramref name="path"/>, which is
+        ///   <c>nullptr</c> if it does not exist, or nothing if the index
+        ///   cannot tell.
+        /// </summary>
+        auto find(std::string_view path) -> std::optional<const Entry*>
+        {
+            const auto key = canonical(path);
+            if (!key)
+                return std::nullopt;
+
+            build();
+
+            auto i = entries_.find(*key);
+            if (i != entries_.end())
+                return &i->second;
+
+            if (!complete_)
+                return std::nullopt;
+
+            return nullptr;
+        }
+    };
+
     const rainbow::Bundle* g_bundle{};
+    PathIndex g_path_index;
 }  // namespace
 
 auto rainbow::filesystem::bundle() -> const Bundle&
@@ -33,9 +297,19 @@ auto rainbow::filesystem::bundle() -> const Bundle&
     return *g_bundle;
 }
 
+auto rainbow::filesystem::content_hash(std::string_view path)
+    -> std::optional<uint64_t>
+{
+    return Pack::content_hash_mounted(path);
+}
+
 auto rainbow::filesystem::create_directories(czstring path) -> bool
 {
-    return PHYSFS_mkdir(path) != 0;
+    if (PHYSFS_mkdir(path) == 0)
+        return false;
+
+    g_path_index.invalidate();
+    return true;
 }
 
 auto rainbow::filesystem::exists(czstring path) -> bool
@@ -48,7 +322,7 @@ auto rainbow::filesystem::exists(czstring path) -> bool
         return true;
     }
 #endif
-    return PHYSFS_exists(path) != 0;
+    return g_path_index.type(path).has_value();
 }
 
 void rainbow::filesystem::initialize(const Bundle& bundle,
@@ -65,6 +339,7 @@ void rainbow::filesystem::initialize(const Bundle& bundle,
     }
 
     PHYSFS_permitSymbolicLinks(static_cast<int>(allow_symlinks));
+    Pack::register_archiver();
 
     if (!is_empty(bundle.assets_path()) &&
         PHYSFS_mount(bundle.assets_path(), nullptr, 0) == 0) {
@@ -81,20 +356,44 @@ void rainbow::filesystem::initialize(const Bundle& bundle,
         LOGF("PhysicsFS: Failed to mount preferences directory: %s",
              PHYSFS_getErrorByCode(error_code));
     }
+
+    g_path_index.invalidate();
+    g_path_index.update();
+}
+
+void rainbow::filesystem::invalidate_index()
+{
+    g_path_index.invalidate();
+}
+
+void rainbow::filesystem::invalidate_index(czstring path)
+{
+    g_path_index.invalidate(path);
 }
 
 auto rainbow::filesystem::is_directory(czstring path) -> bool
 {
-    PHYSFS_Stat stat{};
-    PHYSFS_stat(path, &stat);
-    return stat.filetype == PHYSFS_FILETYPE_DIRECTORY;
+    return g_path_index.type(path) == PHYSFS_FILETYPE_DIRECTORY;
+}
+
+auto rainbow::filesystem::is_in_real_dir(std::string_view path,
+                                         std::string_view real_dir) -> bool
+{
+    return g_path_index.is_in_real_dir(path, real_dir);
 }
 
 auto rainbow::filesystem::is_regular_file(czstring path) -> bool
 {
-    PHYSFS_Stat stat{};
-    PHYSFS_stat(path, &stat);
-    return stat.filetype == PHYSFS_FILETYPE_REGULAR;
+    return g_path_index.type(path) == PHYSFS_FILETYPE_REGULAR;
+}
+
+auto rainbow::filesystem::mount(czstring path) -> bool
+{
+    if (PHYSFS_mount(path, nullptr, 0) == 0)
+        return false;
+
+    g_path_index.invalidate();
+    return true;
 }
 
 auto rainbow::filesystem::path_separator() -> czstring
@@ -131,19 +430,97 @@ auto rainbow::filesystem::preferences_directory() -> const Path&
 
 auto rainbow::filesystem::real_path(czstring path) -> Path
 {
-    auto containing_dir = PHYSFS_getRealDir(path);
-    if (containing_dir == nullptr) {
-        return path;
-    }
-
-    Path resolved_path{containing_dir};
-    resolved_path /= path;
-    return resolved_path;
+    return g_path_index.real_path(path);
 }
 
 auto rainbow::filesystem::remove(czstring path) -> bool
 {
-    return PHYSFS_delete(path) != 0;
+    if (PHYSFS_delete(path) == 0)
+        return false;
+
+    g_path_index.invalidate();
+    return true;
+}
+
+auto rainbow::filesystem::rename(czstring from, czstring to) -> bool
+{
+    const auto write_dir = PHYSFS_getWriteDir();
+    if (write_dir == nullptr)
+        return false;
+
+    Path old_path{write_dir};
+    old_path /= from;
+    Path new_path{write_dir};
+    new_path /= to;
+
+#if HAS_FILESYSTEM
+    std::error_code error;
+    std::filesystem::rename(old_path.native(), new_path.native(), error);
+    if (error)
+        return false;
+#else
+    if (::rename(old_path.c_str(), new_path.c_str()) != 0)
+        return false;
+#endif
+
+    g_path_index.invalidate(from);
+    g_path_index.invalidate(to);
+    return true;
+}
+
+auto rainbow::filesystem::set_write_directory(czstring path) -> bool
+{
+    if (PHYSFS_setWriteDir(path) == 0)
+        return false;
+
+    g_path_index.invalidate();
+    return true;
+}
+
+auto rainbow::filesystem::sync(czstring path) -> bool
+{
+    const auto write_dir = PHYSFS_getWriteDir();
+    if (write_dir == nullptr)
+        return false;
+
+    Path real_path{write_dir};
+    real_path /= path;
+
+#ifdef RAINBOW_OS_WINDOWS
+    // Directory entries are journaled by NTFS and cannot be flushed.
+    if (system::is_directory(real_path.string().c_str()))
+        return true;
+
+    const auto fd = _wopen(real_path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0)
+        return false;
+
+    const auto result = _commit(fd);
+    _close(fd);
+#else
+    const auto fd = ::open(real_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+#    ifdef F_FULLFSYNC
+    // fsync() on Apple platforms does not flush the drive's cache.
+    const auto result = fcntl(fd, F_FULLFSYNC);
+#    else
+    const auto result = fsync(fd);
+#    endif
+    ::close(fd);
+#endif
+
+    return result == 0;
+}
+
+auto rainbow::filesystem::unmount(czstring path) -> bool
+{
+    if (PHYSFS_unmount(path) == 0)
+        return false;
+
+    g_path_index.invalidate();
+    return true;
 }
 
 auto rainbow::system::absolute_path(czstring path) -> std::string
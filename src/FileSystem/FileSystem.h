@@ -6,6 +6,9 @@
 #define FILESYSTEM_FILESYSTEM_H_
 
 #include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
 
 #include "Common/String.h"
 #include "FileSystem/Path.h"
@@ -20,6 +23,17 @@ namespace rainbow::filesystem
     /// <summary>Returns the currently loaded bundle.</summary>
     auto bundle() -> const Bundle&;
 
+    /// <summary>
+    ///   Returns a hash of the contents of the specified asset, such that
+    ///   files with identical contents have the same hash.
+    /// </summary>
+    /// <remarks>
+    ///   Content hashes are only known for files in mounted packs;
+    ///   <c>std::nullopt</c> is returned for all other files.
+    /// </remarks>
+    [[nodiscard]] auto content_hash(std::string_view path)
+        -> std::optional<uint64_t>;
+
     /// <summary>Creates new directories.</summary>
     auto create_directories(czstring path) -> bool;
     inline auto create_directories(const Path& path)
@@ -35,6 +49,26 @@ namespace rainbow::filesystem
     /// <summary>Initializes the file subsystem.</summary>
     void initialize(const Bundle& bundle, czstring argv0, bool allow_symlinks);
 
+    /// <summary>
+    ///   Discards the index of files in the search path. It is rebuilt the
+    ///   next time it is needed.
+    /// </summary>
+    /// <remarks>
+    ///   Existence checks and path resolution are answered from an index of
+    ///   every file and directory in the search path, built once rather than
+    ///   asking PhysicsFS every time. The functions in this namespace keep it
+    ///   up to date; this only needs to be called when the search path or the
+    ///   write directory is modified through PhysicsFS directly.
+    /// </remarks>
+    void invalidate_index();
+
+    /// <summary>
+    ///   Updates the index entry for the file at <paramref name="path"/>
+    ///   only. Cheaper than discarding the whole index when a single file was
+    ///   created or removed.
+    /// </summary>
+    void invalidate_index(czstring path);
+
     /// <summary>
     ///   Returns whether <paramref name="path"/> refers to a directory.
     /// </summary>
@@ -44,6 +78,14 @@ namespace rainbow::filesystem
         return is_directory(path.c_str());
     }
 
+    /// <summary>
+    ///   Returns whether <paramref name="path"/> is found in
+    ///   <paramref name="real_dir"/>, the directory or archive it was mounted
+    ///   from, and is not shadowed by a file earlier in the search path.
+    /// </summary>
+    [[nodiscard]] auto is_in_real_dir(std::string_view path,
+                                      std::string_view real_dir) -> bool;
+
     /// <summary>
     ///   Returns whether <paramref name="path"/> refers to a regular file.
     /// </summary>
@@ -53,6 +95,11 @@ namespace rainbow::filesystem
         return is_regular_file(path.c_str());
     }
 
+    /// <summary>
+    ///   Adds a directory or archive to the front of the search path.
+    /// </summary>
+    auto mount(czstring path) -> bool;
+
     /// <summary>Returns the platform specific path separator.</summary>
     [[nodiscard]] auto path_separator() -> czstring;
 
@@ -77,6 +124,28 @@ namespace rainbow::filesystem
     /// <summary>Removes a file or empty directory.</summary>
     auto remove(czstring path) -> bool;
     inline auto remove(const Path& path) { return remove(path.c_str()); }
+
+    /// <summary>
+    ///   Renames a file in the write directory, replacing
+    ///   <paramref name="to"/> if it exists. The replacement is atomic where
+    ///   the platform supports it.
+    /// </summary>
+    auto rename(czstring from, czstring to) -> bool;
+
+    /// <summary>
+    ///   Sets the directory that files are written to. Passing
+    ///   <c>nullptr</c> disables writing.
+    /// </summary>
+    auto set_write_directory(czstring path) -> bool;
+
+    /// <summary>
+    ///   Flushes a file or directory in the write directory to storage, so
+    ///   that it survives a power loss.
+    /// </summary>
+    auto sync(czstring path) -> bool;
+
+    /// <summary>Removes a directory or archive from the search path.</summary>
+    auto unmount(czstring path) -> bool;
 }  // namespace rainbow::filesystem
 
 namespace rainbow::system
@@ -0,0 +1,100 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/FileWriter.h"
+
+#include <cstring>
+
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+
+using rainbow::Data;
+using rainbow::FileWriter;
+
+namespace
+{
+    constexpr char kTemporarySuffix[] = ".tmp";
+
+    auto copy(const Data& data)
+    {
+        auto buffer = Data::allocate(data.size());
+        std::memcpy(buffer.bytes(), data.bytes(), data.size());
+        return buffer;
+    }
+}  // namespace
+
+FileWriter::FileWriter()
+    : worker_([this](const std::string& path) { write_pending(path); })
+{
+    make_global();
+}
+
+FileWriter::~FileWriter()
+{
+    flush();
+}
+
+auto FileWriter::stats() const -> Stats
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void FileWriter::write(std::string_view path, Data data)
+{
+    if (data.ownership() == Data::Ownership::Reference)
+        data = copy(data);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto [entry, inserted] = pending_.try_emplace(std::string{path});
+        entry->second = std::move(data);
+        if (!inserted) {
+            ++stats_.coalesced;
+            return;
+        }
+    }
+
+    worker_.post(std::string{path});
+}
+
+void FileWriter::write_pending(const std::string& path)
+{
+    Data data;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto entry = pending_.find(path);
+        if (entry == pending_.end())
+            return;
+
+        data = std::move(entry->second);
+        pending_.erase(entry);
+    }
+
+    const auto temp_path = path + kTemporarySuffix;
+    bool succeeded = false;
+    {
+        auto file = WriteableFile::open(temp_path.c_str());
+        succeeded = file && (data.size() == 0 ||
+                             file.write(data.bytes(), data.size()) ==
+                                 data.size());
+    }
+
+    // The destination is only replaced once the new data is on disk.
+    // Otherwise, some file systems may replace it with an empty file if the
+    // device loses power shortly after.
+    succeeded = succeeded && filesystem::sync(temp_path.c_str()) &&
+                filesystem::rename(temp_path.c_str(), path.c_str());
+    if (succeeded) {
+        // Make the rename itself durable
+        filesystem::sync(
+            filesystem::Path{path}.parent_path().generic_string().c_str());
+    } else {
+        LOGE("Failed to write '%s'", path.c_str());
+        filesystem::remove(temp_path.c_str());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++(succeeded ? stats_.writes : stats_.failures);
+}
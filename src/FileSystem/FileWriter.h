@@ -0,0 +1,84 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef FILESYSTEM_FILEWRITER_H_
+#define FILESYSTEM_FILEWRITER_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "Common/Data.h"
+#include "Common/Global.h"
+#include "Threading/Worker.h"
+
+namespace rainbow
+{
+    /// <summary>
+    ///   Writes user files on a background thread, so that saving does not
+    ///   stall the frame.
+    /// </summary>
+    /// <remarks>
+    ///   <para>
+    ///     Files are first written to a temporary file next to the
+    ///     destination, then renamed over it. A crash mid-write leaves the
+    ///     previous version intact.
+    ///   </para>
+    ///   <para>
+    ///     If a file is written again before the previous write has started,
+    ///     only the newest data is written. Pending writes are flushed when
+    ///     the writer is destroyed.
+    ///   </para>
+    /// </remarks>
+    class FileWriter : public Global<FileWriter>
+    {
+    public:
+        struct Stats {
+            /// <summary>Files written to disk.</summary>
+            uint64_t writes;
+
+            /// <summary>
+            ///   Writes that were replaced by a newer one before starting.
+            /// </summary>
+            uint64_t coalesced;
+
+            /// <summary>Writes that failed.</summary>
+            uint64_t failures;
+        };
+
+        FileWriter();
+        ~FileWriter();
+
+        /// <summary>Blocks until all queued writes have finished.</summary>
+        void flush() { worker_.wait(); }
+
+        [[nodiscard]] auto stats() const -> Stats;
+
+        /// <summary>
+        ///   Queues <paramref name="data"/> for writing to
+        ///   <paramref name="path"/> in the write directory.
+        /// </summary>
+        /// <remarks>
+        ///   Data that does not own its buffer is copied, so the caller may
+        ///   release it as soon as this returns.
+        /// </remarks>
+        void write(std::string_view path, Data data);
+
+    private:
+        mutable std::mutex mutex_;
+        absl::flat_hash_map<std::string, Data> pending_;
+        Stats stats_{};
+
+        // The worker must be initialised last, and destroyed first, as it
+        // uses the members above.
+        Worker<std::string> worker_;
+
+        void write_pending(const std::string& path);
+    };
+}  // namespace rainbow
+
+#endif
@@ -0,0 +1,162 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/LZ4.h"
+
+#include <cstring>
+
+using rainbow::lz4::Blocks;
+
+namespace
+{
+    constexpr size_t kMinMatch = 4;
+    constexpr size_t kMaxLength = 15;
+    constexpr size_t kShortCopy = 16;
+
+    /// <summary>
+    ///   Copies <paramref name="size"/> bytes, using a fixed-size copy that
+    ///   compilers can inline when both buffers have room for it.
+    /// </summary>
+    void copy(uint8_t* dst,
+              size_t dst_room,
+              const uint8_t* src,
+              size_t src_room,
+              size_t size)
+    {
+        if (size <= kShortCopy && dst_room >= kShortCopy &&
+            src_room >= kShortCopy) {
+            memcpy(dst, src, kShortCopy);
+        } else if (size > 0) {
+            memcpy(dst, src, size);
+        }
+    }
+
+    /// <summary>
+    ///   Reads the remainder of a length that did not fit in the token.
+    /// </summary>
+    auto read_length(const uint8_t*& src,
+                     const uint8_t* src_end,
+                     size_t& length) -> bool
+    {
+        uint8_t byte = 0;
+        do {
+            if (src == src_end)
+                return false;
+
+            byte = *src++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+}  // namespace
+
+auto rainbow::lz4::decompress(const uint8_t* src,
+                              size_t src_size,
+                              uint8_t* dst,
+                              size_t dst_size) -> bool
+{
+    const auto src_end = src + src_size;
+    const auto dst_begin = dst;
+    const auto dst_end = dst + dst_size;
+    while (src < src_end) {
+        const auto token = *src++;
+
+        size_t literals = token >> 4;
+        if (literals == kMaxLength && !read_length(src, src_end, literals))
+            return false;
+
+        if (literals > static_cast<size_t>(src_end - src) ||
+            literals > static_cast<size_t>(dst_end - dst)) {
+            return false;
+        }
+
+        copy(dst, dst_end - dst, src, src_end - src, literals);
+        src += literals;
+        dst += literals;
+
+        // The last sequence consists of literals only
+        if (src == src_end)
+            break;
+
+        if (src_end - src < 2)
+            return false;
+
+        const size_t offset = src[0] | (size_t{src[1]} << 8);
+        src += 2;
+        if (offset == 0 || offset > static_cast<size_t>(dst - dst_begin))
+            return false;
+
+        size_t match = token & 0x0f;
+        if (match == kMaxLength && !read_length(src, src_end, match))
+            return false;
+
+        match += kMinMatch;
+        if (match > static_cast<size_t>(dst_end - dst))
+            return false;
+
+        // Matches may overlap the bytes they produce, e.g. for runs
+        const auto ref = dst - offset;
+        if (offset >= match) {
+            copy(dst, dst_end - dst, ref, offset, match);
+        } else {
+            for (size_t i = 0; i < match; ++i)
+                dst[i] = ref[i];
+        }
+        dst += match;
+    }
+
+    return dst == dst_end;
+}
+
+Blocks::Blocks(ArrayView<uint8_t> data, size_t uncompressed_size)
+    : uncompressed_size_(uncompressed_size)
+{
+    const auto count = (uncompressed_size + kBlockSize - 1) / kBlockSize;
+    const auto table_size = count * sizeof(uint32_t);
+    if (data.size() < table_size)
+        return;
+
+    table_ = data.data();
+    blocks_ = table_ + table_size;
+    count_ = static_cast<uint32_t>(count);
+
+    uint32_t previous = 0;
+    for (uint32_t i = 0; i < count_; ++i) {
+        const auto current = end(i);
+        if (current < previous) {
+            table_ = nullptr;
+            return;
+        }
+        previous = current;
+    }
+
+    if (previous != data.size() - table_size)
+        table_ = nullptr;
+}
+
+auto Blocks::decompress(uint32_t index, uint8_t* dst) const -> bool
+{
+    const auto begin = index == 0 ? 0 : end(index - 1);
+    const auto src_size = end(index) - begin;
+    const auto dst_size = size(index);
+    if (src_size == dst_size) {
+        memcpy(dst, blocks_ + begin, dst_size);
+        return true;
+    }
+
+    return lz4::decompress(blocks_ + begin, src_size, dst, dst_size);
+}
+
+auto Blocks::size(uint32_t index) const -> size_t
+{
+    return index + 1 < count_ ? kBlockSize
+                              : uncompressed_size_ - size_t{index} * kBlockSize;
+}
+
+auto Blocks::end(uint32_t index) const -> uint32_t
+{
+    uint32_t end;  // NOLINT(cppcoreguidelines-init-variables)
+    memcpy(&end, table_ + size_t{index} * sizeof(uint32_t), sizeof(end));
+    return end;
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef FILESYSTEM_LZ4_H_
+#define FILESYSTEM_LZ4_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Memory/Array.h"
+
+namespace rainbow::lz4
+{
+    /// <summary>Uncompressed size of every block but the last.</summary>
+    constexpr size_t kBlockSize = 64 * 1024;
+
+    /// <summary>
+    ///   Decompresses a single LZ4 block (without frame) from
+    ///   <paramref name="src"/> into <paramref name="dst"/>.
+    /// </summary>
+    /// <returns>
+    ///   <c>true</c> if the block decompressed into exactly
+    ///   <paramref name="dst_size"/> bytes; <c>false</c> if it is malformed.
+    /// </returns>
+    auto decompress(const uint8_t* src,
+                    size_t src_size,
+                    uint8_t* dst,
+                    size_t dst_size) -> bool;
+
+    /// <summary>
+    ///   Data split into independently compressed blocks of
+    ///   <see cref="kBlockSize"/> bytes, as written by
+    ///   <c>tools/pack-assets.js</c>.
+    /// </summary>
+    /// <remarks>
+    ///   The data starts with a table of 32-bit offsets to the end of each
+    ///   block, relative to the end of the table. Blocks that did not compress
+    ///   are stored as is, and are recognised by their size.
+    /// </remarks>
+    class Blocks
+    {
+    public:
+        Blocks() = default;
+        Blocks(ArrayView<uint8_t> data, size_t uncompressed_size);
+
+        [[nodiscard]] auto count() const { return count_; }
+
+        /// <summary>
+        ///   Decompresses block <paramref name="index"/> into
+        ///   <paramref name="dst"/>, which must fit
+        ///   <see cref="size(uint32_t)"/> bytes.
+        /// </summary>
+        auto decompress(uint32_t index, uint8_t* dst) const -> bool;
+
+        /// <summary>
+        ///   Returns the uncompressed size of block <paramref name="index"/>.
+        /// </summary>
+        [[nodiscard]] auto size(uint32_t index) const -> size_t;
+
+        /// <summary>Returns whether the block table is valid.</summary>
+        explicit operator bool() const { return table_ != nullptr; }
+
+    private:
+        const uint8_t* table_ = nullptr;
+        const uint8_t* blocks_ = nullptr;
+        uint32_t count_ = 0;
+        size_t uncompressed_size_ = 0;
+
+        [[nodiscard]] auto end(uint32_t index) const -> uint32_t;
+    };
+}  // namespace rainbow::lz4
+
+#endif
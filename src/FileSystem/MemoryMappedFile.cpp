@@ -0,0 +1,162 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/MemoryMappedFile.h"
+
+#include "Platform/Macros.h"
+#ifdef RAINBOW_OS_WINDOWS
+#    include <Windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include "Common/Data.h"
+#include "Common/Logging.h"
+
+using rainbow::Data;
+using rainbow::MemoryMappedFile;
+
+auto MemoryMappedFile::page_size() -> size_t
+{
+#ifdef RAINBOW_OS_WINDOWS
+    static const size_t size = [] {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return static_cast<size_t>(info.dwPageSize);
+    }();
+#else
+    static const auto size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    return size;
+}
+
+void MemoryMappedFile::prefault(const void* data, size_t size)
+{
+    if (data == nullptr || size == 0)
+        return;
+
+    const auto page = page_size();
+    const auto bytes = static_cast<const uint8_t*>(data);
+
+#ifndef RAINBOW_OS_WINDOWS
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto offset = reinterpret_cast<uintptr_t>(bytes) % page;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    madvise(const_cast<uint8_t*>(bytes - offset), size + offset, MADV_WILLNEED);
+#endif
+
+    // The hint is only a hint; reading a byte from each page is what
+    // actually faults them in.
+    uint8_t checksum = bytes[size - 1];
+    for (size_t i = 0; i < size; i += page)
+        checksum ^= bytes[i];
+
+    [[maybe_unused]] volatile uint8_t sink = checksum;
+}
+
+void MemoryMappedFile::unmap(void* data, size_t size)
+{
+    if (data == nullptr)
+        return;
+
+#ifdef RAINBOW_OS_WINDOWS
+    static_cast<void>(size);
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+MemoryMappedFile::MemoryMappedFile(czstring path)
+{
+#ifdef RAINBOW_OS_WINDOWS
+    auto file = CreateFileA(path,
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+    if (file == INVALID_HANDLE_VALUE)  // NOLINT
+        return;
+
+    LARGE_INTEGER file_size;
+    if (GetFileSizeEx(file, &file_size) == 0 || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return;
+    }
+
+    // The view keeps a reference to the mapping so both handles can be closed
+    // once it has been created.
+    auto mapping =
+        CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+        return;
+
+    data_ =
+        static_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+    if (data_ == nullptr)
+        return;
+
+    size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return;
+
+    struct stat file_status;  // NOLINT(cppcoreguidelines-pro-type-member-init)
+    if (fstat(fd, &file_status) != 0 || file_status.st_size == 0) {
+        close(fd);
+        return;
+    }
+
+    // The mapping stays valid after the file descriptor is closed.
+    const auto size = static_cast<size_t>(file_status.st_size);
+    auto data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+        LOGW("Failed to map '%s' into memory", path);
+        return;
+    }
+
+    data_ = static_cast<uint8_t*>(data);
+    size_ = size;
+#endif
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    unmap();
+}
+
+auto MemoryMappedFile::release() -> Data
+{
+    Data data{data_, size_, Data::Ownership::Mapped};
+    data_ = nullptr;
+    size_ = 0;
+    return data;
+}
+
+auto MemoryMappedFile::operator=(MemoryMappedFile&& file) noexcept
+    -> MemoryMappedFile&
+{
+    unmap();
+    data_ = file.data_;
+    size_ = file.size_;
+    file.data_ = nullptr;
+    file.size_ = 0;
+    return *this;
+}
+
+void MemoryMappedFile::unmap()
+{
+    unmap(data_, size_);
+    data_ = nullptr;
+    size_ = 0;
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef FILESYSTEM_MEMORYMAPPEDFILE_H_
+#define FILESYSTEM_MEMORYMAPPEDFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Common/NonCopyable.h"
+#include "Common/String.h"
+
+namespace rainbow
+{
+    class Data;
+
+    /// <summary>Read-only view of a file on the local filesystem.</summary>
+    /// <remarks>
+    ///   Pages are loaded by the OS on first access, and may be evicted again
+    ///   under memory pressure. Files inside archives cannot be mapped.
+    /// </remarks>
+    class MemoryMappedFile : private NonCopyable<MemoryMappedFile>
+    {
+    public:
+        /// <summary>Returns the granularity of memory mappings.</summary>
+        [[nodiscard]] static auto page_size() -> size_t;
+
+        /// <summary>
+        ///   Loads the pages spanned by <paramref name="data"/> into memory,
+        ///   so that reading them later does not fault.
+        /// </summary>
+        static void prefault(const void* data, size_t size);
+
+        /// <summary>
+        ///   Unmaps memory previously mapped by
+        ///   <see cref="MemoryMappedFile"/>.
+        /// </summary>
+        static void unmap(void* data, size_t size);
+
+        MemoryMappedFile() = default;
+
+        /// <summary>Maps the file at the specified real path.</summary>
+        explicit MemoryMappedFile(czstring path);
+
+        MemoryMappedFile(MemoryMappedFile&& file) noexcept
+            : data_(file.data_), size_(file.size_)
+        {
+            file.data_ = nullptr;
+            file.size_ = 0;
+        }
+
+        ~MemoryMappedFile();
+
+        [[nodiscard]] auto data() const -> const uint8_t* { return data_; }
+        [[nodiscard]] auto size() const { return size_; }
+
+        /// <summary>
+        ///   Transfers the mapping to a <see cref="Data"/> object, which
+        ///   unmaps it on destruction.
+        /// </summary>
+        [[nodiscard]] auto release() -> Data;
+
+        auto operator=(MemoryMappedFile&& file) noexcept -> MemoryMappedFile&;
+
+        explicit operator bool() const { return data_ != nullptr; }
+
+    private:
+        uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+
+        void unmap();
+    };
+}  // namespace rainbow
+
+#endif
@@ -0,0 +1,642 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/Pack.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <absl/container/flat_hash_set.h>
+#include <physfs.h>
+#include <zlib.h>
+
+#include "Common/Hash.h"
+#include "Common/Logging.h"
+#include "FileSystem/FileSystem.h"
+#include "FileSystem/LZ4.h"
+#include "Threading/ThreadPool.h"
+
+using rainbow::czstring;
+using rainbow::Data;
+using rainbow::Pack;
+using rainbow::ThreadPool;
+
+namespace lz4 = rainbow::lz4;
+
+namespace
+{
+    constexpr std::array<char, 4> kPackMagic{'R', 'P', 'A', 'K'};
+    constexpr size_t kFanoutSize = 256;
+    constexpr size_t kHeaderSize = 16 + kFanoutSize * sizeof(uint32_t);
+
+    struct Header {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint32_t count;
+        uint32_t names_size;
+    };
+
+    /// <summary>
+    ///   Packs mounted through PhysicsFS, in the order they were mounted.
+    /// </summary>
+    struct MountedPacks {
+        std::mutex mutex;
+        std::vector<const Pack*> packs;
+    };
+
+    auto mounted_packs() -> MountedPacks&
+    {
+        static MountedPacks mounted;
+        return mounted;
+    }
+
+    /// <summary>
+    ///   Returns the mounted pack, and its entry, that PhysicsFS would read
+    ///   <paramref name="path"/> from; nothing if the file is elsewhere, e.g.
+    ///   in a directory that is ahead of the pack in the search path.
+    /// </summary>
+    auto find_mounted(std::string_view path)
+        -> std::pair<const Pack*, const Pack::Entry*>
+    {
+        // PhysicsFS ignores leading slashes
+        while (!path.empty() && path.front() == '/')
+            path.remove_prefix(1);
+
+        const Pack* pack = nullptr;
+        const Pack::Entry* entry = nullptr;
+        {
+            auto& mounted = mounted_packs();
+            std::lock_guard<std::mutex> lock(mounted.mutex);
+            for (auto p : mounted.packs) {
+                if (auto e = p->find(path)) {
+                    pack = p;
+                    entry = e;
+                    break;
+                }
+            }
+        }
+
+        // The search path is checked without holding the lock, since it may
+        // call into PhysicsFS, which in turn may mount packs.
+        if (entry == nullptr ||
+            !rainbow::filesystem::is_in_real_dir(path, pack->path())) {
+            return {nullptr, nullptr};
+        }
+
+        return {pack, entry};
+    }
+
+    /// <summary>
+    ///   Returns the name of the immediate child of <paramref name="dir"/>
+    ///   that leads to <paramref name="path"/>, if any.
+    /// </summary>
+    auto child_of(std::string_view dir, std::string_view path)
+        -> std::string_view
+    {
+        if (!dir.empty()) {
+            if (path.size() <= dir.size() || path[dir.size()] != '/' ||
+                path.compare(0, dir.size(), dir) != 0) {
+                return {};
+            }
+            path.remove_prefix(dir.size() + 1);
+        }
+        return path.substr(0, path.find('/'));
+    }
+
+    /// <summary>
+    ///   Decompresses all LZ4 blocks into <paramref name="dst"/>, spreading
+    ///   them over a shared thread pool.
+    /// </summary>
+    auto decompress(const lz4::Blocks& blocks, uint8_t* dst) -> bool
+    {
+        if (blocks.count() <= 1)
+            return blocks.count() == 0 || blocks.decompress(0, dst);
+
+        // Shared with the pool; jobs may start after all blocks are done.
+        struct Job {
+            const lz4::Blocks blocks;
+            uint8_t* const dst;
+            std::atomic<uint32_t> next{0};
+            std::atomic<bool> failed{false};
+            std::mutex mutex;
+            std::condition_variable done;
+            uint32_t finished = 0;
+
+            Job(const lz4::Blocks& b, uint8_t* d) : blocks(b), dst(d) {}
+
+            void run()
+            {
+                const auto count = blocks.count();
+                for (auto i = next++; i < count; i = next++) {
+                    if (!blocks.decompress(i, dst + i * lz4::kBlockSize))
+                        failed = true;
+
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (++finished == count)
+                        done.notify_all();
+                }
+            }
+        };
+
+        static ThreadPool pool;
+
+        auto job = std::make_shared<Job>(blocks, dst);
+        const auto helpers = std::min<size_t>(pool.size(), blocks.count() - 1);
+        for (size_t i = 0; i < helpers; ++i)
+            pool.post([job] { job->run(); });
+
+        // Help out instead of idling; this also guarantees progress when the
+        // pool is busy with other entries.
+        job->run();
+
+        std::unique_lock<std::mutex> lock(job->mutex);
+        job->done.wait(lock, [&job] {
+            return job->finished == job->blocks.count();
+        });
+        return !job->failed;
+    }
+
+    // PhysicsFS archiver
+
+    struct EntryStream {
+        const Pack* pack;
+        const Pack::Entry* entry;
+        Data data;  // Whole entry, unless it is streamed
+
+        // LZ4 entries are streamed a block at a time.
+        lz4::Blocks blocks;
+        std::unique_ptr<uint8_t[]> block;
+        uint32_t block_index;
+
+        uint64_t position;
+    };
+
+    constexpr uint32_t kNoBlock = std::numeric_limits<uint32_t>::max();
+
+    auto stream(PHYSFS_Io* io) { return static_cast<EntryStream*>(io->opaque); }
+
+    auto io_read(PHYSFS_Io* io, void* buffer, PHYSFS_uint64 length)
+        -> PHYSFS_sint64
+    {
+        auto s = stream(io);
+        const auto size = std::min<uint64_t>(
+            length, s->entry->uncompressed_size - s->position);
+        if (!s->block) {
+            memcpy(buffer, s->data.bytes() + s->position, size);
+            s->position += size;
+            return static_cast<PHYSFS_sint64>(size);
+        }
+
+        auto out = static_cast<uint8_t*>(buffer);
+        uint64_t read = 0;
+        while (read < size) {
+            const auto index =
+                static_cast<uint32_t>(s->position / lz4::kBlockSize);
+            if (index != s->block_index) {
+                if (!s->blocks.decompress(index, s->block.get())) {
+                    s->block_index = kNoBlock;
+                    PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+                    return read > 0 ? static_cast<PHYSFS_sint64>(read) : -1;
+                }
+                s->block_index = index;
+            }
+
+            const auto offset = s->position % lz4::kBlockSize;
+            const auto count = std::min<uint64_t>(
+                size - read, s->blocks.size(index) - offset);
+            memcpy(out + read, s->block.get() + offset, count);
+            read += count;
+            s->position += count;
+        }
+        return static_cast<PHYSFS_sint64>(read);
+    }
+
+    auto io_write(PHYSFS_Io*, const void*, PHYSFS_uint64) -> PHYSFS_sint64
+    {
+        PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+        return -1;
+    }
+
+    auto io_seek(PHYSFS_Io* io, PHYSFS_uint64 offset) -> int
+    {
+        auto s = stream(io);
+        if (offset > s->entry->uncompressed_size) {
+            PHYSFS_setErrorCode(PHYSFS_ERR_PAST_EOF);
+            return 0;
+        }
+
+        s->position = offset;
+        return 1;
+    }
+
+    auto io_tell(PHYSFS_Io* io) -> PHYSFS_sint64
+    {
+        return static_cast<PHYSFS_sint64>(stream(io)->position);
+    }
+
+    auto io_length(PHYSFS_Io* io) -> PHYSFS_sint64
+    {
+        return static_cast<PHYSFS_sint64>(stream(io)->entry->uncompressed_size);
+    }
+
+    auto io_flush(PHYSFS_Io*) -> int { return 1; }
+
+    void io_destroy(PHYSFS_Io* io)
+    {
+        delete stream(io);
+        delete io;
+    }
+
+    auto open_entry(const Pack& pack, const Pack::Entry& entry) -> PHYSFS_Io*
+    {
+        const bool is_streamed = entry.compression == Pack::Compression::LZ4;
+        auto data = is_streamed ? Data{} : pack.read(entry);
+        if (!is_streamed && !data && entry.uncompressed_size > 0) {
+            PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+            return nullptr;
+        }
+
+        auto s = std::make_unique<EntryStream>(
+            EntryStream{&pack, &entry, std::move(data), {}, {}, kNoBlock, 0});
+        if (is_streamed) {
+            s->blocks = {pack.stored(entry), entry.uncompressed_size};
+            if (!s->blocks) {
+                PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+                return nullptr;
+            }
+            s->block = std::make_unique<uint8_t[]>(lz4::kBlockSize);
+        }
+
+        auto io = std::make_unique<PHYSFS_Io>();
+        io->version = 0;
+        io->opaque = s.release();
+        io->read = io_read;
+        io->write = io_write;
+        io->seek = io_seek;
+        io->tell = io_tell;
+        io->length = io_length;
+        io->duplicate = [](PHYSFS_Io* io) {
+            auto s = stream(io);
+            return open_entry(*s->pack, *s->entry);
+        };
+        io->flush = io_flush;
+        io->destroy = io_destroy;
+        return io.release();
+    }
+
+    auto archive_open(PHYSFS_Io* io,
+                      const char* name,
+                      int for_write,
+                      int* claimed) -> void*
+    {
+        std::array<char, kPackMagic.size()> magic{};
+        if (for_write != 0 || io->seek(io, 0) == 0 ||
+            io->read(io, magic.data(), magic.size()) !=
+                static_cast<PHYSFS_sint64>(magic.size()) ||
+            !Pack::is_pack(magic.data(), magic.size())) {
+            return nullptr;
+        }
+
+        *claimed = 1;
+
+        auto pack = std::make_unique<Pack>(name);
+        if (!*pack) {
+            PHYSFS_setErrorCode(PHYSFS_ERR_CORRUPT);
+            return nullptr;
+        }
+
+        {
+            auto& mounted = mounted_packs();
+            std::lock_guard<std::mutex> lock(mounted.mutex);
+            mounted.packs.push_back(pack.get());
+        }
+
+        // Packs are mapped, and do not need the stream
+        io->destroy(io);
+        return pack.release();
+    }
+
+    auto archive_enumerate(void* opaque,
+                           const char* dirname,
+                           PHYSFS_EnumerateCallback callback,
+                           const char* origdir,
+                           void* callback_data)
+        -> PHYSFS_EnumerateCallbackResult
+    {
+        const auto& pack = *static_cast<const Pack*>(opaque);
+        absl::flat_hash_set<std::string_view> children;
+        for (auto&& entry : pack.entries()) {
+            auto child = child_of(dirname, pack.name(entry));
+            if (child.empty() || !children.insert(child).second)
+                continue;
+
+            const std::string fname{child};
+            const auto result = callback(callback_data, origdir, fname.c_str());
+            if (result != PHYSFS_ENUM_OK)
+                return result;
+        }
+        return PHYSFS_ENUM_OK;
+    }
+
+    auto archive_open_read(void* opaque, const char* filename) -> PHYSFS_Io*
+    {
+        const auto& pack = *static_cast<const Pack*>(opaque);
+        auto entry = pack.find(filename);
+        if (entry == nullptr) {
+            PHYSFS_setErrorCode(PHYSFS_ERR_NOT_FOUND);
+            return nullptr;
+        }
+
+        return open_entry(pack, *entry);
+    }
+
+    auto archive_open_write(void*, const char*) -> PHYSFS_Io*
+    {
+        PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+        return nullptr;
+    }
+
+    auto archive_modify(void*, const char*) -> int
+    {
+        PHYSFS_setErrorCode(PHYSFS_ERR_READ_ONLY);
+        return 0;
+    }
+
+    auto archive_stat(void* opaque, const char* filename, PHYSFS_Stat* stat)
+        -> int
+    {
+        const auto& pack = *static_cast<const Pack*>(opaque);
+        stat->modtime = -1;
+        stat->createtime = -1;
+        stat->accesstime = -1;
+        stat->readonly = 1;
+
+        if (auto entry = pack.find(filename)) {
+            stat->filesize = entry->uncompressed_size;
+            stat->filetype = PHYSFS_FILETYPE_REGULAR;
+            return 1;
+        }
+
+        const std::string_view dir{filename};
+        const auto& entries = pack.entries();
+        if (dir.empty() ||
+            std::any_of(entries.begin(), entries.end(), [&](auto&& entry) {
+                return !child_of(dir, pack.name(entry)).empty();
+            })) {
+            stat->filesize = 0;
+            stat->filetype = PHYSFS_FILETYPE_DIRECTORY;
+            return 1;
+        }
+
+        PHYSFS_setErrorCode(PHYSFS_ERR_NOT_FOUND);
+        return 0;
+    }
+
+    void archive_close(void* opaque)
+    {
+        auto pack = static_cast<Pack*>(opaque);
+        {
+            auto& mounted = mounted_packs();
+            std::lock_guard<std::mutex> lock(mounted.mutex);
+            auto& packs = mounted.packs;
+            packs.erase(std::remove(packs.begin(), packs.end(), pack),
+                        packs.end());
+        }
+        delete pack;
+    }
+}  // namespace
+
+auto Pack::content_hash_mounted(std::string_view path)
+    -> std::optional<uint64_t>
+{
+    auto [pack, entry] = find_mounted(path);
+    return entry == nullptr ? std::nullopt : pack->content_hash(*entry);
+}
+
+auto Pack::is_pack(const void* header, size_t size) -> bool
+{
+    return size >= kPackMagic.size() &&
+           memcmp(header, kPackMagic.data(), kPackMagic.size()) == 0;
+}
+
+auto Pack::map_mounted(std::string_view path) -> Data
+{
+    auto [pack, entry] = find_mounted(path);
+    return entry == nullptr || entry->compression != Compression::None
+               ? Data{}
+               : pack->read(*entry);
+}
+
+auto Pack::read_mounted(std::string_view path) -> Data
+{
+    auto [pack, entry] = find_mounted(path);
+    return entry == nullptr ? Data{} : pack->read(*entry);
+}
+
+void Pack::register_archiver()
+{
+    static PHYSFS_Archiver archiver = [] {
+        PHYSFS_Archiver archiver{};
+        archiver.version = 0;
+        archiver.info.extension = "rpak";
+        archiver.info.description = "Rainbow asset pack";
+        archiver.info.author = "Bifrost Entertainment AS and Tommy Nguyen";
+        archiver.info.url = "https://github.com/tido64/rainbow";
+        archiver.info.supportsSymlinks = 0;
+        archiver.openArchive = archive_open;
+        archiver.enumerate = archive_enumerate;
+        archiver.openRead = archive_open_read;
+        archiver.openWrite = archive_open_write;
+        archiver.openAppend = archive_open_write;
+        archiver.remove = archive_modify;
+        archiver.mkdir = archive_modify;
+        archiver.stat = archive_stat;
+        archiver.closeArchive = archive_close;
+        return archiver;
+    }();
+
+    if (PHYSFS_registerArchiver(&archiver) == 0) {
+        const auto error_code = PHYSFS_getLastErrorCode();
+        LOGE("PhysicsFS: Failed to register pack archiver: %s",
+             PHYSFS_getErrorByCode(error_code));
+    }
+}
+
+Pack::Pack(czstring path) : file_(path), path_(path)
+{
+    if (!file_)
+        return;
+
+    const auto fail = [this, path](czstring reason) {
+        LOGE("%s: %s", path, reason);
+        file_ = {};
+        fanout_ = nullptr;
+        entries_ = {};
+        content_hashes_ = nullptr;
+        names_ = nullptr;
+    };
+
+    Header header;  // NOLINT(cppcoreguidelines-pro-type-member-init)
+    if (file_.size() < kHeaderSize) {
+        fail("Not a Rainbow pack");
+        return;
+    }
+
+    memcpy(&header, file_.data(), sizeof(header));
+    if (!is_pack(header.magic.data(), header.magic.size())) {
+        fail("Not a Rainbow pack");
+        return;
+    }
+
+    // Version 1 packs are identical, save for the content hashes
+    if (header.version != 1 && header.version != kVersion) {
+        fail("Unsupported pack version");
+        return;
+    }
+
+    const auto entries_offset = kHeaderSize;
+    const auto content_hashes_offset =
+        entries_offset + size_t{header.count} * sizeof(Entry);
+    const auto names_offset =
+        header.version == 1
+            ? content_hashes_offset
+            : content_hashes_offset + size_t{header.count} * sizeof(uint64_t);
+    if (names_offset + header.names_size > file_.size()) {
+        fail("Pack index is truncated");
+        return;
+    }
+
+    // The header is 8-byte aligned, and so is the mapping
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    fanout_ = reinterpret_cast<const uint32_t*>(file_.data() + sizeof(header));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    entries_ = {reinterpret_cast<const Entry*>(file_.data() + entries_offset),
+                header.count};
+    if (header.version != 1) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        content_hashes_ = reinterpret_cast<const uint64_t*>(
+            file_.data() + content_hashes_offset);
+    }
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    names_ = reinterpret_cast<const char*>(file_.data() + names_offset);
+
+    if (!std::is_sorted(fanout_, fanout_ + kFanoutSize) ||
+        fanout_[kFanoutSize - 1] != header.count) {
+        fail("Pack index is corrupt");
+        return;
+    }
+
+    const auto is_valid = [this, &header](const Entry& entry) {
+        const auto index = static_cast<uint32_t>(&entry - entries_.data());
+        const auto bucket = entry.hash >> 56;
+        return (bucket == 0 || fanout_[bucket - 1] <= index) &&
+               index < fanout_[bucket] &&
+               uint64_t{entry.name_offset} + entry.name_size <=
+                   header.names_size &&
+               entry.offset < file_.size() &&
+               entry.size < file_.size() - entry.offset &&
+               file_.data()[entry.offset + entry.size] == 0 &&
+               (entry.compression != Compression::None ||
+                entry.uncompressed_size == entry.size);
+    };
+    const auto by_hash = [](const Entry& a, const Entry& b) {
+        return a.hash < b.hash;
+    };
+    if (!std::all_of(entries_.begin(), entries_.end(), is_valid) ||
+        !std::is_sorted(entries_.begin(), entries_.end(), by_hash)) {
+        fail("Pack index is corrupt");
+        return;
+    }
+}
+
+auto Pack::content_hash(const Entry& entry) const -> std::optional<uint64_t>
+{
+    if (content_hashes_ == nullptr)
+        return std::nullopt;
+
+    return content_hashes_[&entry - entries_.data()];
+}
+
+auto Pack::find(std::string_view path) const -> const Entry*
+{
+    if (entries_.empty())
+        return nullptr;
+
+    const auto hash = fnv1a(path);
+    const auto bucket = hash >> 56;
+    const auto first =
+        entries_.begin() + (bucket == 0 ? 0 : fanout_[bucket - 1]);
+    const auto last = entries_.begin() + fanout_[bucket];
+    for (auto entry = std::lower_bound(first,
+                                       last,
+                                       hash,
+                                       [](const Entry& entry, uint64_t hash) {
+                                           return entry.hash < hash;
+                                       });
+         entry != last && entry->hash == hash;
+         ++entry) {
+        if (name(*entry) == path)
+            return entry;
+    }
+    return nullptr;
+}
+
+auto Pack::name(const Entry& entry) const -> std::string_view
+{
+    return {names_ + entry.name_offset, entry.name_size};
+}
+
+auto Pack::read(const Entry& entry) const -> Data
+{
+    const auto data = file_.data() + entry.offset;
+    switch (entry.compression) {
+        case Compression::None:
+            return {data, entry.size, Data::Ownership::Reference};
+
+        case Compression::Deflate: {
+            auto buffer = Data::allocate(entry.uncompressed_size);
+            uLongf size = entry.uncompressed_size;
+            if (uncompress(buffer.bytes(), &size, data, entry.size) != Z_OK ||
+                size != entry.uncompressed_size) {
+                LOGE("%.*s: Failed to decompress",
+                     static_cast<int>(entry.name_size),
+                     names_ + entry.name_offset);
+                return {};
+            }
+
+            return buffer;
+        }
+
+        case Compression::LZ4: {
+            const lz4::Blocks blocks{stored(entry), entry.uncompressed_size};
+            auto buffer = Data::allocate(entry.uncompressed_size);
+            if (!blocks || !decompress(blocks, buffer.bytes())) {
+                LOGE("%.*s: Failed to decompress",
+                     static_cast<int>(entry.name_size),
+                     names_ + entry.name_offset);
+                return {};
+            }
+
+            return buffer;
+        }
+    }
+
+    LOGE("%.*s: Unsupported compression",
+         static_cast<int>(entry.name_size),
+         names_ + entry.name_offset);
+    return {};
+}
+
+auto Pack::stored(const Entry& entry) const -> ArrayView<uint8_t>
+{
+    return {file_.data() + entry.offset, entry.size};
+}
@@ -0,0 +1,168 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef FILESYSTEM_PACK_H_
+#define FILESYSTEM_PACK_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "Common/Data.h"
+#include "Common/NonCopyable.h"
+#include "Common/String.h"
+#include "FileSystem/MemoryMappedFile.h"
+#include "Memory/Array.h"
+
+namespace rainbow
+{
+    /// <summary>
+    ///   Read-only, memory mapped Rainbow asset pack (.rpak).
+    /// </summary>
+    /// <remarks>
+    ///   <para>
+    ///     Packs are created with <c>tools/pack-assets.js</c>, which also
+    ///     documents the layout. Entries are indexed by the 64-bit FNV-1a
+    ///     hash of their path, sorted, and bucketed by the top byte of the
+    ///     hash so that lookups only search a handful of entries.
+    ///   </para>
+    ///   <para>
+    ///     Looking up and reading an uncompressed entry does not allocate or
+    ///     make any system calls; the returned data references the mapping
+    ///     and must not outlive the pack.
+    ///   </para>
+    ///   <para>
+    ///     Entries may be compressed with deflate for size, or LZ4 for speed.
+    ///     LZ4 entries are split into independent blocks so that they can be
+    ///     decompressed in parallel, or streamed.
+    ///   </para>
+    ///   <para>
+    ///     Since version 2, packs also store a hash of every entry's content.
+    ///     Files with identical content are stored once, and caches use the
+    ///     hash to load them once.
+    ///   </para>
+    /// </remarks>
+    class Pack : private NonCopyable<Pack>
+    {
+    public:
+        static constexpr uint32_t kVersion = 2;
+
+        enum class Compression : uint16_t {
+            None,
+            Deflate,
+            LZ4,
+        };
+
+        struct Entry {
+            uint64_t hash;
+            uint64_t offset;
+            uint32_t size;
+            uint32_t uncompressed_size;
+            uint32_t name_offset;
+            uint16_t name_size;
+            Compression compression;
+        };
+
+        static_assert(sizeof(Entry) == 32);
+
+        /// <summary>
+        ///   Returns the content hash of <paramref name="path"/> if it is read
+        ///   from a mounted pack; <c>std::nullopt</c> if it is not, or if the
+        ///   pack predates content hashes.
+        /// </summary>
+        [[nodiscard]] static auto content_hash_mounted(std::string_view path)
+            -> std::optional<uint64_t>;
+
+        /// <summary>
+        ///   Returns whether <paramref name="header"/> starts with the pack
+        ///   signature.
+        /// </summary>
+        [[nodiscard]] static auto is_pack(const void* header, size_t size)
+            -> bool;
+
+        /// <summary>
+        ///   Returns the contents of <paramref name="path"/> if it is read from
+        ///   a mounted pack, but only if it is stored uncompressed and can be
+        ///   referenced without copying; empty otherwise.
+        /// </summary>
+        [[nodiscard]] static auto map_mounted(std::string_view path) -> Data;
+
+        /// <summary>
+        ///   Returns the contents of <paramref name="path"/> if it is read from
+        ///   a mounted pack; empty if it is not.
+        /// </summary>
+        /// <remarks>
+        ///   Packs are mounted through PhysicsFS, but looked up directly
+        ///   without going through its locks. The search path index decides
+        ///   which pack, if any, the file is read from, so that files mounted
+        ///   ahead of a pack still take precedence.
+        /// </remarks>
+        [[nodiscard]] static auto read_mounted(std::string_view path) -> Data;
+
+        /// <summary>
+        ///   Registers packs with PhysicsFS so that they can be mounted like
+        ///   any other archive.
+        /// </summary>
+        static void register_archiver();
+
+        Pack() = default;
+
+        /// <summary>Maps the pack at the specified real path.</summary>
+        explicit Pack(czstring path);
+
+        /// <summary>
+        ///   Returns the 64-bit FNV-1a hash of the uncompressed contents of the
+        ///   specified entry; <c>std::nullopt</c> if the pack predates content
+        ///   hashes.
+        /// </summary>
+        [[nodiscard]] auto content_hash(const Entry& entry) const
+            -> std::optional<uint64_t>;
+
+        /// <summary>Returns all entries, sorted by hash.</summary>
+        [[nodiscard]] auto entries() const { return entries_; }
+
+        /// <summary>
+        ///   Returns the entry for <paramref name="path"/>; <c>nullptr</c> if
+        ///   there is none.
+        /// </summary>
+        [[nodiscard]] auto find(std::string_view path) const -> const Entry*;
+
+        /// <summary>Returns the real path of the pack.</summary>
+        [[nodiscard]] auto path() const -> std::string_view { return path_; }
+
+        /// <summary>Returns the path of the specified entry.</summary>
+        [[nodiscard]] auto name(const Entry& entry) const -> std::string_view;
+
+        /// <summary>
+        ///   Returns the contents of the specified entry, decompressing it if
+        ///   necessary. Like <see cref="File::read"/>, the returned buffer is
+        ///   null-terminated.
+        /// </summary>
+        /// <remarks>
+        ///   LZ4 entries larger than a block are decompressed on multiple
+        ///   threads.
+        /// </remarks>
+        [[nodiscard]] auto read(const Entry& entry) const -> Data;
+
+        /// <summary>
+        ///   Returns the bytes of the specified entry as they are stored in
+        ///   the pack, i.e. compressed if it is.
+        /// </summary>
+        [[nodiscard]] auto stored(const Entry& entry) const
+            -> ArrayView<uint8_t>;
+
+        explicit operator bool() const { return static_cast<bool>(file_); }
+
+    private:
+        MemoryMappedFile file_;
+        std::string path_;
+        const uint32_t* fanout_ = nullptr;
+        ArrayView<Entry> entries_;
+        const uint64_t* content_hashes_ = nullptr;
+        const char* names_ = nullptr;
+    };
+}  // namespace rainbow
+
+#endif
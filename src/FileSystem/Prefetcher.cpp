@@ -0,0 +1,136 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/Prefetcher.h"
+
+#include <algorithm>
+
+#include "FileSystem/File.h"
+#include "FileSystem/MemoryMappedFile.h"
+
+using rainbow::Data;
+using rainbow::Prefetcher;
+
+void Prefetcher::clear()
+{
+    worker_.clear();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    stats_.size = 0;
+    ready_.notify_all();
+}
+
+void Prefetcher::prefetch(std::string_view path)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto [entry, inserted] = entries_.try_emplace(
+            std::string{path}, Entry{State::Queued, {}, 0});
+        if (!inserted) {
+            if (entry->second.state != State::Discarded)
+                return;
+
+            entry->second.state = State::Queued;
+        }
+    }
+
+    worker_.post([this, path = std::string{path}] { read(path); });
+}
+
+auto Prefetcher::stats() const -> Stats
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+auto Prefetcher::take(std::string_view path) -> Data
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto entry = entries_.find(path);
+    if (entry != entries_.end() && entry->second.state == State::Reading) {
+        ready_.wait(lock, [this, path, &entry] {
+            entry = entries_.find(path);
+            return entry == entries_.end() ||
+                   entry->second.state != State::Reading;
+        });
+    }
+
+    if (entry == entries_.end()) {
+        ++stats_.unhinted;
+        return {};
+    }
+
+    if (entry->second.state != State::Ready) {
+        // Queued assets are read by the caller instead; there is no point in
+        // reading them twice.
+        entries_.erase(entry);
+        ++stats_.misses;
+        return {};
+    }
+
+    auto data = std::move(entry->second.data);
+    entries_.erase(entry);
+    stats_.size -= data.size();
+    ++stats_.hits;
+    return data;
+}
+
+void Prefetcher::evict(size_t size)
+{
+    while (stats_.size + size > budget_) {
+        auto oldest = entries_.end();
+        for (auto i = entries_.begin(); i != entries_.end(); ++i) {
+            if (i->second.state == State::Ready &&
+                (oldest == entries_.end() ||
+                 i->second.sequence < oldest->second.sequence)) {
+                oldest = i;
+            }
+        }
+
+        if (oldest == entries_.end())
+            break;
+
+        stats_.size -= oldest->second.data.size();
+        ++stats_.evictions;
+        oldest->second = Entry{State::Discarded, {}, 0};
+    }
+}
+
+void Prefetcher::read(const std::string& path)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto entry = entries_.find(path);
+        if (entry == entries_.end())
+            return;
+
+        entry->second.state = State::Reading;
+    }
+
+    auto data = File::read_uncached(path.c_str(), FileType::Asset);
+
+    // Large files are mapped, and stored pack entries point into the pack's
+    // mapping. Neither has been read from disk yet, so fault in their pages
+    // here instead of on the main thread.
+    if (data.ownership() == Data::Ownership::Mapped ||
+        data.ownership() == Data::Ownership::Reference) {
+        MemoryMappedFile::prefault(data.bytes(), data.size());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto entry = entries_.find(path);
+    if (entry != entries_.end()) {
+        entries_.erase(entry);
+        if (data && data.size() <= budget_) {
+            evict(data.size());
+            stats_.size += data.size();
+            entries_.try_emplace(
+                path, Entry{State::Ready, std::move(data), ++sequence_});
+        } else {
+            entries_.try_emplace(path, Entry{State::Discarded, {}, 0});
+        }
+    }
+    ready_.notify_all();
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef FILESYSTEM_PREFETCHER_H_
+#define FILESYSTEM_PREFETCHER_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <absl/container/flat_hash_map.h>
+
+#include "Common/Data.h"
+#include "Common/Global.h"
+#include "Threading/ThreadPool.h"
+
+namespace rainbow
+{
+    /// <summary>
+    ///   Reads assets on a background thread ahead of time, and keeps them
+    ///   in a bounded cache until they are read with
+    ///   <see cref="File::read"/>.
+    /// </summary>
+    /// <remarks>
+    ///   Cached assets are handed out once; a second read goes to disk as
+    ///   usual. When the cache is full, the oldest assets are evicted first.
+    /// </remarks>
+    class Prefetcher : public Global<Prefetcher>
+    {
+    public:
+        static constexpr size_t kDefaultBudget = 32 * 1024 * 1024;
+
+        struct Stats {
+            /// <summary>Reads served from the cache.</summary>
+            uint64_t hits;
+
+            /// <summary>
+            ///   Reads of prefetched assets that were not ready in time, or
+            ///   that were evicted.
+            /// </summary>
+            uint64_t misses;
+
+            /// <summary>Asset reads that were never prefetched.</summary>
+            uint64_t unhinted;
+
+            /// <summary>Assets evicted before they were read.</summary>
+            uint64_t evictions;
+
+            /// <summary>Bytes currently held by the cache.</summary>
+            size_t size;
+
+            /// <summary>
+            ///   Returns the fraction of reads of prefetched assets that were
+            ///   served from the cache.
+            /// </summary>
+            [[nodiscard]] auto hit_rate() const
+            {
+                const auto reads = hits + misses;
+                return reads == 0 ? 0.0 : static_cast<double>(hits) / reads;
+            }
+        };
+
+        explicit Prefetcher(size_t budget = kDefaultBudget) : budget_(budget)
+        {
+            make_global();
+        }
+
+        /// <summary>
+        ///   Discards all cached assets and all assets that have yet to be
+        ///   read.
+        /// </summary>
+        void clear();
+
+        /// <summary>
+        ///   Queues the asset at <paramref name="path"/> for reading. Does
+        ///   nothing if it is already queued or cached.
+        /// </summary>
+        void prefetch(std::string_view path);
+
+        [[nodiscard]] auto stats() const -> Stats;
+
+        /// <summary>
+        ///   Removes the asset at <paramref name="path"/> from the cache and
+        ///   returns it. If it is being read, waits for it to finish. Returns
+        ///   empty data if the asset was not prefetched.
+        /// </summary>
+        [[nodiscard]] auto take(std::string_view path) -> Data;
+
+        /// <summary>Blocks until all queued assets have been read.</summary>
+        void wait() { worker_.wait(); }
+
+    private:
+        enum class State {
+            Queued,
+            Reading,
+            Ready,
+            Discarded,  ///< Evicted or failed to read; kept to count misses.
+        };
+
+        struct Entry {
+            State state;
+            Data data;
+            uint64_t sequence;
+        };
+
+        mutable std::mutex mutex_;
+        std::condition_variable ready_;
+        absl::flat_hash_map<std::string, Entry> entries_;
+        size_t budget_;
+        uint64_t sequence_ = 0;
+        Stats stats_{};
+
+        // The worker must be initialised last, and destroyed first, as it
+        // uses the members above.
+        ThreadPool worker_{1};
+
+        void evict(size_t size);
+        void read(const std::string& path);
+    };
+}  // namespace rainbow
+
+#endif
@@ -22,7 +22,8 @@ namespace rainbow::graphics
         ~Buffer();
 
         /// <summary>
-        ///   Used by Label and SpriteBatch for interleaved vertex buffer.
+        ///   Used by Label, SpriteBatch and TextBatch for interleaved vertex
+        ///   buffer.
         /// </summary>
         void bind() const;
 
@@ -35,6 +36,13 @@ namespace rainbow::graphics
         /// </summary>
         void upload(const void* data, size_t size) const;
 
+        /// <summary>
+        ///   Replaces <paramref name="size"/> bytes of the GPU buffer starting
+        ///   at <paramref name="offset"/>. The buffer must already have been
+        ///   allocated with <see cref="upload"/>.
+        /// </summary>
+        void upload(size_t offset, const void* data, size_t size) const;
+
 #ifdef RAINBOW_TEST
         explicit Buffer(const ISolemnlySwearThatIAmOnlyTesting&) : id_(0) {}
 #endif
@@ -0,0 +1,276 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Graphics/ColorDepth.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define RAINBOW_COLORDEPTH_SSE2
+#    include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#    define RAINBOW_COLORDEPTH_NEON
+#    include <arm_neon.h>
+#endif
+
+using rainbow::Image;
+using rainbow::graphics::Dithering;
+
+namespace
+{
+    constexpr float kBayer4x4[4][4]{
+        {0, 8, 2, 10},
+        {12, 4, 14, 6},
+        {3, 11, 1, 9},
+        {15, 7, 13, 5},
+    };
+
+    struct Layout {
+        /// <summary>Largest value of each channel.</summary>
+        std::array<float, 4> max;
+
+        /// <summary>Multiplier that shifts each channel into place.</summary>
+        std::array<float, 4> weight;
+    };
+
+    constexpr auto layout(Image::Packing packing) -> Layout
+    {
+        switch (packing) {
+            case Image::Packing::None:
+                break;
+            case Image::Packing::RGBA4444:
+                return {{15, 15, 15, 15}, {1 << 12, 1 << 8, 1 << 4, 1}};
+            case Image::Packing::RGB565:
+                return {{31, 63, 31, 0}, {1 << 11, 1 << 5, 1, 0}};
+            case Image::Packing::RGBA5551:
+                return {{31, 31, 31, 1}, {1 << 11, 1 << 6, 1 << 1, 1}};
+        }
+        return {};
+    }
+
+    void store(uint16_t pixel, uint8_t* p) { memcpy(p, &pixel, sizeof(pixel)); }
+
+    // Each channel is quantized as floor(value * max / 255 + threshold),
+    // where threshold is 0.5 when rounding, and taken from the Bayer matrix
+    // when dithering. Quantized channels are then shifted into place by
+    // multiplying with their weight and summing.
+
+#if defined(RAINBOW_COLORDEPTH_SSE2)
+    using float4 = __m128;
+
+    auto load(const std::array<float, 4>& v) -> float4
+    {
+        return _mm_loadu_ps(v.data());
+    }
+
+    auto load(const uint8_t* p) -> float4
+    {
+        int32_t rgba;  // NOLINT(cppcoreguidelines-init-variables)
+        memcpy(&rgba, p, sizeof(rgba));
+
+        const auto zero = _mm_setzero_si128();
+        const auto x = _mm_unpacklo_epi8(_mm_cvtsi32_si128(rgba), zero);
+        return _mm_cvtepi32_ps(_mm_unpacklo_epi16(x, zero));
+    }
+
+    auto pack(float4 rgba, float4 scale, float4 threshold, float4 weight)
+        -> uint16_t
+    {
+        // Values are never negative so truncating is the same as flooring
+        const auto q = _mm_cvtepi32_ps(_mm_cvttps_epi32(
+            _mm_add_ps(_mm_mul_ps(rgba, scale), threshold)));
+
+        auto sum = _mm_mul_ps(q, weight);
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(
+            sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 1, 1, 1)));
+        return static_cast<uint16_t>(_mm_cvttss_si32(sum));
+    }
+#elif defined(RAINBOW_COLORDEPTH_NEON)
+    using float4 = float32x4_t;
+
+    auto load(const std::array<float, 4>& v) -> float4
+    {
+        return vld1q_f32(v.data());
+    }
+
+    auto load(const uint8_t* p) -> float4
+    {
+        uint32_t rgba;  // NOLINT(cppcoreguidelines-init-variables)
+        memcpy(&rgba, p, sizeof(rgba));
+
+        const auto x = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(rgba)));
+        return vcvtq_f32_u32(vmovl_u16(vget_low_u16(x)));
+    }
+
+    auto pack(float4 rgba, float4 scale, float4 threshold, float4 weight)
+        -> uint16_t
+    {
+        const auto q = vcvtq_f32_u32(
+            vcvtq_u32_f32(vmlaq_f32(threshold, rgba, scale)));
+        return static_cast<uint16_t>(vaddvq_f32(vmulq_f32(q, weight)));
+    }
+#else
+    using float4 = std::array<float, 4>;
+
+    auto load(const std::array<float, 4>& v) -> float4 { return v; }
+
+    auto load(const uint8_t* p) -> float4
+    {
+        const auto f = [p](int i) { return static_cast<float>(p[i]); };
+        return {f(0), f(1), f(2), f(3)};
+    }
+
+    auto pack(const float4& rgba,
+              const float4& scale,
+              const float4& threshold,
+              const float4& weight) -> uint16_t
+    {
+        float sum = 0.0F;
+        for (int i = 0; i < 4; ++i)
+            sum += std::floor(rgba[i] * scale[i] + threshold[i]) * weight[i];
+        return static_cast<uint16_t>(sum);
+    }
+#endif
+
+    void pack_ordered(const uint8_t* src,
+                      uint32_t width,
+                      uint32_t height,
+                      const Layout& layout,
+                      Dithering dithering,
+                      uint8_t* dst)
+    {
+        const auto& [max, weight] = layout;
+        const auto scale =
+            load({max[0] / 255.0F, max[1] / 255.0F, max[2] / 255.0F,
+                  max[3] / 255.0F});
+        const auto weights = load(weight);
+
+        float4 thresholds[16];
+        for (size_t i = 0; i < std::size(thresholds); ++i) {
+            const auto t = dithering == Dithering::Ordered
+                               ? (kBayer4x4[i / 4][i % 4] + 0.5F) / 16.0F
+                               : 0.5F;
+            thresholds[i] = load({t, t, t, max[3] > 1.0F ? t : 0.5F});
+        }
+
+        for (uint32_t y = 0; y < height; ++y) {
+            const auto row = thresholds + (y % 4) * 4;
+            for (uint32_t x = 0; x < width; ++x) {
+                store(pack(load(src), scale, row[x % 4], weights), dst);
+                src += 4;
+                dst += sizeof(uint16_t);
+            }
+        }
+    }
+
+    void pack_diffused(const uint8_t* src,
+                       uint32_t width,
+                       uint32_t height,
+                       const Layout& layout,
+                       uint8_t* dst)
+    {
+        const auto& [max, weight] = layout;
+
+        // Errors for the current and the next row, padded by one pixel on
+        // either side so that the edges need no special casing.
+        const size_t row_size = (width + 2) * 4;
+        std::vector<float> errors(row_size * 2);
+        auto current = errors.data() + 4;
+        auto next = current + row_size;
+
+        for (uint32_t y = 0; y < height; ++y) {
+            std::fill_n(next - 4, row_size, 0.0F);
+            for (uint32_t x = 0; x < width; ++x) {
+                float pixel = 0.0F;
+                for (uint32_t c = 0; c < 4; ++c) {
+                    if (max[c] == 0.0F)
+                        continue;
+
+                    const auto i = static_cast<ptrdiff_t>(x * 4 + c);
+                    const auto value =
+                        std::clamp(src[i] + current[i], 0.0F, 255.0F);
+                    const auto q = std::floor(value * max[c] / 255.0F + 0.5F);
+                    pixel += q * weight[c];
+
+                    // 1-bit alpha is not dithered
+                    if (max[c] == 1.0F)
+                        continue;
+
+                    const auto error = value - q * 255.0F / max[c];
+                    current[i + 4] += error * (7.0F / 16.0F);
+                    next[i - 4] += error * (3.0F / 16.0F);
+                    next[i] += error * (5.0F / 16.0F);
+                    next[i + 4] += error * (1.0F / 16.0F);
+                }
+                store(static_cast<uint16_t>(pixel), dst);
+                dst += sizeof(uint16_t);
+            }
+            src += size_t{width} * 4;
+            std::swap(current, next);
+        }
+    }
+}  // namespace
+
+auto rainbow::graphics::reduce_color_depth(Image&& image,
+                                           Image::Packing packing,
+                                           Dithering dithering) -> Image
+{
+    const bool is_decoded = image.format == Image::Format::PNG ||
+                            image.format == Image::Format::QOI ||
+                            image.format == Image::Format::SVG;
+    const bool is_supported = image.channels == 4 && image.depth == 32 &&
+                              image.packing == Image::Packing::None;
+    if (packing == Image::Packing::None || !is_decoded || !is_supported ||
+        image.data == nullptr) {
+        return std::move(image);
+    }
+
+    std::array<Image::Level, Image::kMaxLevels> mipmaps{};
+    size_t size = 0;
+    for (uint32_t i = 0; i < image.levels; ++i) {
+        const auto level_size = size_t{std::max(image.width >> i, 1U)} *
+                                std::max(image.height >> i, 1U) *
+                                sizeof(uint16_t);
+        mipmaps[i] = {size, level_size};
+        size += level_size;
+    }
+
+    auto buffer = std::make_unique<uint8_t[]>(size);
+    const auto pixel_layout = layout(packing);
+    for (uint32_t i = 0; i < image.levels; ++i) {
+        const auto src = image.data + (image.levels == 1  //
+                                           ? 0
+                                           : image.mipmaps[i].offset);
+        const auto width = std::max(image.width >> i, 1U);
+        const auto height = std::max(image.height >> i, 1U);
+        const auto dst = buffer.get() + mipmaps[i].offset;
+        if (dithering == Dithering::FloydSteinberg)
+            pack_diffused(src, width, height, pixel_layout, dst);
+        else
+            pack_ordered(src, width, height, pixel_layout, dithering, dst);
+    }
+
+    Image packed{image.format,
+                 image.width,
+                 image.height,
+                 16,
+                 packing == Image::Packing::RGB565 ? 3U : 4U,
+                 size,
+                 buffer.release()};
+    packed.levels = image.levels;
+    if (image.levels > 1)
+        packed.mipmaps = mipmaps;
+    packed.packing = packing;
+    return packed;
+}
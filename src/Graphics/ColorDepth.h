@@ -0,0 +1,33 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef GRAPHICS_COLORDEPTH_H_
+#define GRAPHICS_COLORDEPTH_H_
+
+#include "Graphics/Image.h"
+
+namespace rainbow::graphics
+{
+    enum class Dithering {
+        None,
+        Ordered,         // 4x4 Bayer matrix
+        FloydSteinberg,  // Error diffusion
+    };
+
+    /// <summary>
+    ///   Returns a copy of <paramref name="image"/> with its pixels packed
+    ///   into 16 bits, halving its size.
+    /// </summary>
+    /// <remarks>
+    ///   All mipmap levels are converted. Ordered dithering is vectorized;
+    ///   error diffusion is inherently sequential and is not. 1-bit alpha is
+    ///   never dithered. Only decoded 8-bit RGBA images are supported; other
+    ///   images, or <see cref="Image::Packing::None"/>, are returned as is.
+    /// </remarks>
+    auto reduce_color_depth(Image&& image,
+                            Image::Packing packing,
+                            Dithering dithering) -> Image;
+}  // namespace rainbow::graphics
+
+#endif
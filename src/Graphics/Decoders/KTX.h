@@ -0,0 +1,374 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef GRAPHICS_DECODERS_KTX_H_
+#define GRAPHICS_DECODERS_KTX_H_
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/Logging.h"
+
+// https://registry.khronos.org/KTX/specs/1.0/ktxspec.v1.html
+// https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+
+namespace
+{
+    constexpr uint8_t kKTX1Identifier[]{
+        0xab, 'K', 'T', 'X', ' ', '1', '1', 0xbb, '\r', '\n', 0x1a, '\n'};
+    constexpr uint8_t kKTX2Identifier[]{
+        0xab, 'K', 'T', 'X', ' ', '2', '0', 0xbb, '\r', '\n', 0x1a, '\n'};
+
+    constexpr uint32_t kKTXEndianness = 0x04030201;
+
+    // glInternalFormat
+    constexpr uint32_t kKTXRGBA4 = 0x8056;
+    constexpr uint32_t kKTXRGB5A1 = 0x8057;
+    constexpr uint32_t kKTXRGBA8 = 0x8058;
+    constexpr uint32_t kKTXRGB565 = 0x8d62;
+    constexpr uint32_t kKTXRGBS3TCDXT1 = 0x83f0;
+    constexpr uint32_t kKTXRGBAS3TCDXT1 = 0x83f1;
+    constexpr uint32_t kKTXRGBAS3TCDXT3 = 0x83f2;
+    constexpr uint32_t kKTXRGBAS3TCDXT5 = 0x83f3;
+    constexpr uint32_t kKTXRGBPVRTC4BPP = 0x8c00;
+    constexpr uint32_t kKTXRGBPVRTC2BPP = 0x8c01;
+    constexpr uint32_t kKTXRGBAPVRTC4BPP = 0x8c02;
+    constexpr uint32_t kKTXRGBAPVRTC2BPP = 0x8c03;
+    constexpr uint32_t kKTXATCRGB = 0x8c92;
+    constexpr uint32_t kKTXATCRGBAExplicitAlpha = 0x8c93;
+    constexpr uint32_t kKTXETC1RGB8 = 0x8d64;
+    constexpr uint32_t kKTXRGB8ETC2 = 0x9274;
+    constexpr uint32_t kKTXSRGB8ETC2 = 0x9275;
+    constexpr uint32_t kKTXRGBA8ETC2EAC = 0x9278;
+    constexpr uint32_t kKTXSRGB8Alpha8ETC2EAC = 0x9279;
+
+    // VkFormat
+    constexpr uint32_t kVkR4G4B4A4UnormPack16 = 2;
+    constexpr uint32_t kVkR5G6B5UnormPack16 = 4;
+    constexpr uint32_t kVkR5G5B5A1UnormPack16 = 6;
+    constexpr uint32_t kVkR8G8Unorm = 16;
+    constexpr uint32_t kVkR8G8B8A8Unorm = 37;
+    constexpr uint32_t kVkR8G8B8A8SRGB = 43;
+    constexpr uint32_t kVkBC1RGBUnorm = 131;
+    constexpr uint32_t kVkBC1RGBSRGB = 132;
+    constexpr uint32_t kVkBC1RGBAUnorm = 133;
+    constexpr uint32_t kVkBC1RGBASRGB = 134;
+    constexpr uint32_t kVkBC2Unorm = 135;
+    constexpr uint32_t kVkBC2SRGB = 136;
+    constexpr uint32_t kVkBC3Unorm = 137;
+    constexpr uint32_t kVkBC3SRGB = 138;
+    constexpr uint32_t kVkETC2R8G8B8Unorm = 147;
+    constexpr uint32_t kVkETC2R8G8B8SRGB = 148;
+    constexpr uint32_t kVkETC2R8G8B8A8Unorm = 151;
+    constexpr uint32_t kVkETC2R8G8B8A8SRGB = 152;
+    constexpr uint32_t kVkPVRTC12BPPUnorm = 1000054000;
+    constexpr uint32_t kVkPVRTC14BPPUnorm = 1000054001;
+
+    struct KTX1Header {
+        uint8_t identifier[12];
+        uint32_t endianness;
+        uint32_t gl_type;
+        uint32_t gl_type_size;
+        uint32_t gl_format;
+        uint32_t gl_internal_format;
+        uint32_t gl_base_internal_format;
+        uint32_t pixel_width;
+        uint32_t pixel_height;
+        uint32_t pixel_depth;
+        uint32_t number_of_array_elements;
+        uint32_t number_of_faces;
+        uint32_t number_of_mipmap_levels;
+        uint32_t bytes_of_key_value_data;
+    };
+
+    struct KTX2Header {
+        uint8_t identifier[12];
+        uint32_t vk_format;
+        uint32_t type_size;
+        uint32_t pixel_width;
+        uint32_t pixel_height;
+        uint32_t pixel_depth;
+        uint32_t layer_count;
+        uint32_t face_count;
+        uint32_t level_count;
+        uint32_t supercompression_scheme;
+        uint32_t dfd_byte_offset;
+        uint32_t dfd_byte_length;
+        uint32_t kvd_byte_offset;
+        uint32_t kvd_byte_length;
+        uint64_t sgd_byte_offset;
+        uint64_t sgd_byte_length;
+    };
+
+    struct KTX2LevelIndex {
+        uint64_t byte_offset;
+        uint64_t byte_length;
+        uint64_t uncompressed_byte_length;
+    };
+
+    /// <summary>
+    ///   Sets format, channels and depth (in bits per pixel) of
+    ///   <paramref name="image"/> from an OpenGL internal format. Returns
+    ///   whether the format is supported.
+    /// </summary>
+    auto ktx_format_from_gl(uint32_t internal_format, rainbow::Image& image)
+    {
+        using rainbow::Image;
+
+        const auto set = [&image](Image::Format format,
+                                  uint32_t channels,
+                                  uint32_t depth) {
+            image.format = format;
+            image.channels = channels;
+            image.depth = depth;
+            return true;
+        };
+        const auto set_packed = [&image](Image::Packing packing,
+                                         uint32_t channels) {
+            image.format = Image::Format::RGBA;
+            image.channels = channels;
+            image.depth = 16;
+            image.packing = packing;
+            return true;
+        };
+
+        switch (internal_format) {
+            case kKTXRGBA4:
+                return set_packed(Image::Packing::RGBA4444, 4);
+            case kKTXRGB5A1:
+                return set_packed(Image::Packing::RGBA5551, 4);
+            case kKTXRGBA8:
+                return set(Image::Format::RGBA, 4, 32);
+            case kKTXRGB565:
+                return set_packed(Image::Packing::RGB565, 3);
+            case kKTXRGBS3TCDXT1:
+                return set(Image::Format::BC1, 3, 4);
+            case kKTXRGBAS3TCDXT1:
+                return set(Image::Format::BC1, 4, 4);
+            case kKTXRGBAS3TCDXT3:
+                return set(Image::Format::BC2, 4, 8);
+            case kKTXRGBAS3TCDXT5:
+                return set(Image::Format::BC3, 4, 8);
+            case kKTXRGBPVRTC4BPP:
+                return set(Image::Format::PVRTC, 3, 4);
+            case kKTXRGBPVRTC2BPP:
+                return set(Image::Format::PVRTC, 3, 2);
+            case kKTXRGBAPVRTC4BPP:
+                return set(Image::Format::PVRTC, 4, 4);
+            case kKTXRGBAPVRTC2BPP:
+                return set(Image::Format::PVRTC, 4, 2);
+            case kKTXATCRGB:
+                return set(Image::Format::ATITC, 3, 4);
+            case kKTXATCRGBAExplicitAlpha:
+                return set(Image::Format::ATITC, 4, 8);
+            case kKTXETC1RGB8:
+                return set(Image::Format::ETC1, 3, 4);
+            case kKTXRGB8ETC2:
+            case kKTXSRGB8ETC2:
+                return set(Image::Format::ETC2, 3, 4);
+            case kKTXRGBA8ETC2EAC:
+            case kKTXSRGB8Alpha8ETC2EAC:
+                return set(Image::Format::ETC2, 4, 8);
+            default:
+                return false;
+        }
+    }
+
+    auto ktx_format_from_vk(uint32_t vk_format, rainbow::Image& image)
+    {
+        switch (vk_format) {
+            case kVkR4G4B4A4UnormPack16:
+                return ktx_format_from_gl(kKTXRGBA4, image);
+            case kVkR5G6B5UnormPack16:
+                return ktx_format_from_gl(kKTXRGB565, image);
+            case kVkR5G5B5A1UnormPack16:
+                return ktx_format_from_gl(kKTXRGB5A1, image);
+            case kVkR8G8Unorm:
+                // Used by the image cache for luminance-alpha images
+                image.format = rainbow::Image::Format::RGBA;
+                image.channels = 2;
+                image.depth = 16;
+                return true;
+            case kVkR8G8B8A8Unorm:
+            case kVkR8G8B8A8SRGB:
+                return ktx_format_from_gl(kKTXRGBA8, image);
+            case kVkBC1RGBUnorm:
+            case kVkBC1RGBSRGB:
+                return ktx_format_from_gl(kKTXRGBS3TCDXT1, image);
+            case kVkBC1RGBAUnorm:
+            case kVkBC1RGBASRGB:
+                return ktx_format_from_gl(kKTXRGBAS3TCDXT1, image);
+            case kVkBC2Unorm:
+            case kVkBC2SRGB:
+                return ktx_format_from_gl(kKTXRGBAS3TCDXT3, image);
+            case kVkBC3Unorm:
+            case kVkBC3SRGB:
+                return ktx_format_from_gl(kKTXRGBAS3TCDXT5, image);
+            case kVkETC2R8G8B8Unorm:
+            case kVkETC2R8G8B8SRGB:
+                return ktx_format_from_gl(kKTXRGB8ETC2, image);
+            case kVkETC2R8G8B8A8Unorm:
+            case kVkETC2R8G8B8A8SRGB:
+                return ktx_format_from_gl(kKTXRGBA8ETC2EAC, image);
+            case kVkPVRTC12BPPUnorm:
+                return ktx_format_from_gl(kKTXRGBAPVRTC2BPP, image);
+            case kVkPVRTC14BPPUnorm:
+                return ktx_format_from_gl(kKTXRGBAPVRTC4BPP, image);
+            default:
+                return false;
+        }
+    }
+
+    template <typename Header>
+    auto ktx_read_header(const rainbow::Data& data) -> const Header*
+    {
+        return data.size() < sizeof(Header) ? nullptr : data.as<Header*>();
+    }
+
+    auto ktx1_decode(const rainbow::Data& data)
+    {
+        using rainbow::Image;
+
+        auto header = ktx_read_header<KTX1Header>(data);
+        if (header == nullptr || header->endianness != kKTXEndianness) {
+            LOGE("KTX: Invalid or big-endian header");
+            return Image{};
+        }
+
+        if (header->pixel_height == 0 || header->pixel_depth > 1 ||
+            header->number_of_array_elements > 0 ||
+            header->number_of_faces != 1) {
+            LOGE("KTX: Only 2D textures are supported");
+            return Image{};
+        }
+
+        Image image;
+        if (!ktx_format_from_gl(header->gl_internal_format, image)) {
+            LOGE("KTX: Unsupported format: 0x%x", header->gl_internal_format);
+            return Image{};
+        }
+
+        const auto levels = std::max(header->number_of_mipmap_levels, 1U);
+        if (levels > Image::kMaxLevels) {
+            LOGE("KTX: Too many mipmap levels: %u", levels);
+            return Image{};
+        }
+
+        // Each level is prefixed with its size and padded to 4 bytes
+        const auto bytes = data.bytes();
+        size_t offset = sizeof(*header) + header->bytes_of_key_value_data;
+        for (uint32_t i = 0; i < levels; ++i) {
+            if (offset + sizeof(uint32_t) > data.size()) {
+                LOGE("KTX: Unexpected end of data");
+                return Image{};
+            }
+
+            uint32_t level_size;  // NOLINT(cppcoreguidelines-init-variables)
+            memcpy(&level_size, bytes + offset, sizeof(level_size));
+            offset += sizeof(level_size);
+            if (offset + level_size > data.size()) {
+                LOGE("KTX: Unexpected end of data");
+                return Image{};
+            }
+
+            image.mipmaps[i] = {offset, level_size};
+            image.size += level_size;
+            offset += (size_t{level_size} + 3) & ~size_t{3};
+        }
+
+        image.width = header->pixel_width;
+        image.height = header->pixel_height;
+        image.levels = levels;
+
+        // Offsets are relative to `data` so that levels are not copied
+        image.data = bytes;
+        if (levels == 1) {
+            image.data += image.mipmaps[0].offset;
+            image.mipmaps[0].offset = 0;
+        }
+        return image;
+    }
+
+    auto ktx2_decode(const rainbow::Data& data)
+    {
+        using rainbow::Image;
+
+        auto header = ktx_read_header<KTX2Header>(data);
+        if (header == nullptr) {
+            LOGE("KTX2: Invalid header");
+            return Image{};
+        }
+
+        if (header->pixel_height == 0 || header->pixel_depth > 0 ||
+            header->layer_count > 0 || header->face_count != 1) {
+            LOGE("KTX2: Only 2D textures are supported");
+            return Image{};
+        }
+
+        if (header->supercompression_scheme != 0) {
+            LOGE("KTX2: Supercompression is not supported");
+            return Image{};
+        }
+
+        Image image;
+        if (!ktx_format_from_vk(header->vk_format, image)) {
+            LOGE("KTX2: Unsupported format: %u", header->vk_format);
+            return Image{};
+        }
+
+        const auto levels = std::max(header->level_count, 1U);
+        if (levels > Image::kMaxLevels ||
+            sizeof(*header) + sizeof(KTX2LevelIndex) * levels > data.size()) {
+            LOGE("KTX2: Invalid level index");
+            return Image{};
+        }
+
+        auto index = reinterpret_cast<const KTX2LevelIndex*>(  // NOLINT
+            data.bytes() + sizeof(*header));
+        for (uint32_t i = 0; i < levels; ++i) {
+            const auto& level = index[i];
+            if (level.byte_offset + level.byte_length > data.size()) {
+                LOGE("KTX2: Unexpected end of data");
+                return Image{};
+            }
+
+            image.mipmaps[i] = {static_cast<size_t>(level.byte_offset),
+                                static_cast<size_t>(level.byte_length)};
+            image.size += image.mipmaps[i].size;
+        }
+
+        image.width = header->pixel_width;
+        image.height = header->pixel_height;
+        image.levels = levels;
+
+        // Offsets are relative to `data` so that levels are not copied
+        image.data = data.bytes();
+        if (levels == 1) {
+            image.data += image.mipmaps[0].offset;
+            image.mipmaps[0].offset = 0;
+        }
+        return image;
+    }
+}  // namespace
+
+namespace ktx
+{
+    bool check(const rainbow::Data& data)
+    {
+        return data.size() >= sizeof(kKTX1Identifier) &&
+               (memcmp(data.bytes(),
+                       kKTX1Identifier,
+                       sizeof(kKTX1Identifier)) == 0 ||
+                memcmp(data.bytes(),
+                       kKTX2Identifier,
+                       sizeof(kKTX2Identifier)) == 0);
+    }
+
+    auto decode(const rainbow::Data& data)
+    {
+        return data.bytes()[5] == '2' ? ktx2_decode(data) : ktx1_decode(data);
+    }
+}  // namespace ktx
+
+#endif
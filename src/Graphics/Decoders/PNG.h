@@ -5,11 +5,15 @@
 #ifndef GRAPHICS_DECODERS_PNG_H_
 #define GRAPHICS_DECODERS_PNG_H_
 
+#include <csetjmp>
 #include <cstring>
 #include <memory>
 
 #include <png.h>
 
+#include "Common/Logging.h"
+#include "FileSystem/FileStream.h"
+
 namespace png
 {
     bool check(const rainbow::Data& data)
@@ -46,6 +50,121 @@ namespace png
             size,
             buffer.release());
     }
+
+    namespace detail
+    {
+        struct ReadStruct {
+            png_structp png;
+            png_infop info;
+
+            ~ReadStruct() { png_destroy_read_struct(&png, &info, nullptr); }
+        };
+
+        void read(png_structp png, png_bytep data, png_size_t length)
+        {
+            using rainbow::FileStream;
+
+            auto stream = static_cast<FileStream*>(png_get_io_ptr(png));
+            if (stream->read(data, length) != length)
+                png_error(png, "Unexpected end of file");
+        }
+
+        [[noreturn]] void fail(png_structp png, png_const_charp message)
+        {
+            LOGE("libpng: %s", message);
+            png_longjmp(png, 1);
+        }
+
+        void warn(png_structp, png_const_charp message)
+        {
+            LOGW("libpng: %s", message);
+        }
+
+        /// <summary>
+        ///   Reads rows directly from <paramref name="stream"/> into a pixel
+        ///   buffer, converting to the same formats that the simplified API
+        ///   produces in <see cref="decode(const rainbow::Data&)"/>.
+        /// </summary>
+        /// <remarks>
+        ///   libpng reports errors by jumping back to the <c>setjmp</c> here.
+        ///   Anything that needs cleaning up must live in the caller.
+        /// </remarks>
+        auto read_image(ReadStruct& rs,
+                        rainbow::FileStream& stream,
+                        rainbow::Image& image,
+                        std::unique_ptr<uint8_t[]>& pixels) -> bool
+        {
+            auto png = rs.png;
+            auto info = rs.info;
+            if (setjmp(png_jmpbuf(png)))  // NOLINT(cert-err52-cpp)
+                return false;
+
+            png_set_read_fn(png, &stream, read);
+            png_read_info(png, info);
+
+            const auto color_type = png_get_color_type(png, info);
+            const bool is_gray = (color_type & PNG_COLOR_MASK_COLOR) == 0;
+            const bool has_alpha = (color_type & PNG_COLOR_MASK_ALPHA) != 0 ||
+                                   png_get_valid(png, info, PNG_INFO_tRNS) != 0;
+
+            png_set_expand(png);
+            png_set_scale_16(png);
+            if (!is_gray || !has_alpha) {
+                if (is_gray)
+                    png_set_gray_to_rgb(png);
+                if (!has_alpha)
+                    png_set_add_alpha(png, 0xff, PNG_FILLER_AFTER);
+            }
+            png_set_alpha_mode(png, PNG_ALPHA_PNG, PNG_DEFAULT_sRGB);
+
+            const auto passes = png_set_interlace_handling(png);
+            png_read_update_info(png, info);
+
+            image.width = png_get_image_width(png, info);
+            image.height = png_get_image_height(png, info);
+            image.channels = png_get_channels(png, info);
+            image.depth = image.channels * 8;
+            const size_t stride = png_get_rowbytes(png, info);
+            image.size = stride * image.height;
+
+            pixels = std::make_unique<uint8_t[]>(image.size);
+            for (int pass = 0; pass < passes; ++pass) {
+                for (uint32_t y = 0; y < image.height; ++y)
+                    png_read_row(png, pixels.get() + stride * y, nullptr);
+            }
+
+            png_read_end(png, nullptr);
+            return true;
+        }
+    }  // namespace detail
+
+    /// <summary>
+    ///   Decodes a PNG image from <paramref name="stream"/> without reading
+    ///   the whole file into memory first.
+    /// </summary>
+    auto decode(rainbow::FileStream& stream)
+    {
+        using rainbow::Image;
+
+        detail::ReadStruct rs{
+            png_create_read_struct(
+                PNG_LIBPNG_VER_STRING, nullptr, detail::fail, detail::warn),
+            nullptr};
+        if (rs.png == nullptr)
+            return Image(Image::Format::PNG);
+
+        rs.info = png_create_info_struct(rs.png);
+        if (rs.info == nullptr)
+            return Image(Image::Format::PNG);
+
+        Image image(Image::Format::PNG);
+        std::unique_ptr<uint8_t[]> pixels;
+        if (!detail::read_image(rs, stream, image, pixels))
+            return Image(Image::Format::PNG);
+
+        image.data = pixels.release();
+        return image;
+    }
 }  // namespace png
 
 #endif
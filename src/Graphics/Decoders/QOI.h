@@ -0,0 +1,122 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef GRAPHICS_DECODERS_QOI_H_
+#define GRAPHICS_DECODERS_QOI_H_
+
+#include <cstring>
+#include <memory>
+
+#include "Common/Logging.h"
+
+// https://qoiformat.org/qoi-specification.pdf
+
+namespace
+{
+    constexpr uint8_t kQOIMagic[]{'q', 'o', 'i', 'f'};
+    constexpr size_t kQOIHeaderSize = 14;
+    constexpr size_t kQOIPaddingSize = 8;
+    constexpr uint32_t kQOIMaxPixels = 400'000'000;
+
+    constexpr uint8_t kQOIOpIndex = 0x00;
+    constexpr uint8_t kQOIOpDiff = 0x40;
+    constexpr uint8_t kQOIOpLuma = 0x80;
+    constexpr uint8_t kQOIOpRun = 0xc0;
+    constexpr uint8_t kQOIOpRGB = 0xfe;
+    constexpr uint8_t kQOIOpRGBA = 0xff;
+    constexpr uint8_t kQOIMask2 = 0xc0;
+
+    constexpr auto qoi_read_u32(const uint8_t* bytes) -> uint32_t
+    {
+        return (static_cast<uint32_t>(bytes[0]) << 24) |
+               (static_cast<uint32_t>(bytes[1]) << 16) |
+               (static_cast<uint32_t>(bytes[2]) << 8) | bytes[3];
+    }
+}  // namespace
+
+namespace qoi
+{
+    bool check(const rainbow::Data& data)
+    {
+        return data.size() >= sizeof(kQOIMagic) &&
+               memcmp(data.bytes(), kQOIMagic, sizeof(kQOIMagic)) == 0;
+    }
+
+    auto decode(const rainbow::Data& data)
+    {
+        using rainbow::Image;
+
+        if (data.size() < kQOIHeaderSize + kQOIPaddingSize)
+            return Image(Image::Format::QOI);
+
+        const auto bytes = data.bytes();
+        const auto width = qoi_read_u32(bytes + 4);
+        const auto height = qoi_read_u32(bytes + 8);
+        const auto channels = bytes[12];
+        if (width == 0 || height == 0 || height >= kQOIMaxPixels / width ||
+            (channels != 3 && channels != 4)) {
+            LOGE("QOI: Invalid header");
+            return Image(Image::Format::QOI);
+        }
+
+        // Pixels are always expanded to RGBA
+        const size_t size = size_t{width} * height * 4;
+        auto buffer = std::make_unique<uint8_t[]>(size);
+
+        uint8_t index[64][4]{};
+        uint8_t px[4]{0, 0, 0, 255};
+        int run = 0;
+
+        const auto end = data.size() - kQOIPaddingSize;
+        size_t p = kQOIHeaderSize;
+        for (size_t i = 0; i < size; i += 4) {
+            if (run > 0) {
+                --run;
+            } else if (p < end) {
+                const uint8_t b1 = bytes[p++];
+                if (b1 == kQOIOpRGB) {
+                    px[0] = bytes[p++];
+                    px[1] = bytes[p++];
+                    px[2] = bytes[p++];
+                } else if (b1 == kQOIOpRGBA) {
+                    px[0] = bytes[p++];
+                    px[1] = bytes[p++];
+                    px[2] = bytes[p++];
+                    px[3] = bytes[p++];
+                } else if ((b1 & kQOIMask2) == kQOIOpIndex) {
+                    memcpy(px, index[b1], sizeof(px));
+                } else if ((b1 & kQOIMask2) == kQOIOpDiff) {
+                    px[0] += ((b1 >> 4) & 0x03) - 2;
+                    px[1] += ((b1 >> 2) & 0x03) - 2;
+                    px[2] += (b1 & 0x03) - 2;
+                } else if ((b1 & kQOIMask2) == kQOIOpLuma) {
+                    const uint8_t b2 = bytes[p++];
+                    const int vg = (b1 & 0x3f) - 32;
+                    px[0] += vg - 8 + ((b2 >> 4) & 0x0f);
+                    px[1] += vg;
+                    px[2] += vg - 8 + (b2 & 0x0f);
+                } else if ((b1 & kQOIMask2) == kQOIOpRun) {
+                    run = b1 & 0x3f;
+                }
+
+                const auto hash =
+                    (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+                memcpy(index[hash], px, sizeof(px));
+            }
+
+            memcpy(buffer.get() + i, px, sizeof(px));
+        }
+
+        return Image(  //
+            Image::Format::QOI,
+            width,
+            height,
+            /* depth */ 32,
+            /* channels */ 4,
+            size,
+            buffer.release());
+    }
+}  // namespace qoi
+
+#endif
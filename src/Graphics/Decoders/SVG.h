@@ -5,6 +5,11 @@
 #ifndef GRAPHICS_DECODERS_SVG_H_
 #define GRAPHICS_DECODERS_SVG_H_
 
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "Common/Algorithm.h"
 #include "ThirdParty/NanoSVG/NanoSVG.h"
 
@@ -26,6 +31,15 @@ namespace std
     };
 }  // namespace std
 
+namespace
+{
+    /// <summary>
+    ///   Tiles are at least this many rows tall, so that small images are not
+    ///   split up where the cost of spawning threads would dominate.
+    /// </summary>
+    constexpr int kSVGMinTileHeight = 128;
+}  // namespace
+
 namespace svg
 {
     bool check(const rainbow::Data& data)
@@ -45,8 +59,11 @@ namespace svg
 
         std::unique_ptr<NSVGimage> img;
         {
-            auto svg = std::make_unique<char[]>(data.size());
+            // NanoSVG tokenizes the source in place, and expects it to be
+            // null-terminated.
+            auto svg = std::make_unique<char[]>(data.size() + 1);
             std::copy(data.bytes(), data.bytes() + data.size(), svg.get());
+            svg[data.size()] = '\0';
             img.reset(nsvgParse(svg.get(), "px", 96.0f));
             if (img == nullptr)
                 return image;
@@ -58,18 +75,42 @@ namespace svg
         image.channels = 4;
         image.size = static_cast<size_t>(image.width) * image.height * 4;
 
+        const auto width = static_cast<int>(img->width * scale);
+        const auto height = static_cast<int>(img->height * scale);
+        const auto stride = static_cast<int>(image.width * 4);
         auto buffer = std::make_unique<uint8_t[]>(image.size);
-        std::unique_ptr<NSVGrasterizer> rasterizer{nsvgCreateRasterizer()};
-        nsvgRasterize(  //
-            rasterizer.get(),
-            img.get(),
-            0.0f,
-            0.0f,
-            scale,
-            buffer.get(),
-            img->width * scale,
-            img->height * scale,
-            image.width * 4);
+
+        // Rasterize horizontal tiles in parallel. The parsed image is only
+        // read by the rasterizer, so it can be shared between threads.
+        const auto concurrency =
+            static_cast<int>(std::thread::hardware_concurrency());
+        const auto tiles = std::clamp(
+            height / kSVGMinTileHeight, 1, std::max(concurrency, 1));
+        const auto rasterize = [&img, &buffer, scale, width, height, stride,
+                                tiles](int tile) {
+            const int y0 = height * tile / tiles;
+            const int y1 = height * (tile + 1) / tiles;
+            std::unique_ptr<NSVGrasterizer> rasterizer{nsvgCreateRasterizer()};
+            nsvgRasterize(  //
+                rasterizer.get(),
+                img.get(),
+                0.0f,
+                static_cast<float>(-y0),
+                scale,
+                buffer.get() + static_cast<ptrdiff_t>(y0) * stride,
+                width,
+                y1 - y0,
+                stride);
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(tiles - 1);
+        for (int tile = 1; tile < tiles; ++tile)
+            workers.emplace_back(rasterize, tile);
+
+        rasterize(0);
+        for (auto&& worker : workers)
+            worker.join();
 
         image.data = buffer.release();
         return image;
@@ -6,7 +6,10 @@
 
 #include "Common/Data.h"
 #include "Common/Logging.h"
+#include "FileSystem/FileStream.h"
+#include "Graphics/Decoders/KTX.h"
 #include "Graphics/Decoders/PNG.h"
+#include "Graphics/Decoders/QOI.h"
 #include "Graphics/Decoders/SVG.h"
 #include "Graphics/OpenGL.h"
 #ifdef GL_IMG_texture_compression_pvrtc
@@ -17,6 +20,7 @@
 #endif  // GL_EXT_texture_compression_s3tc
 
 using rainbow::Data;
+using rainbow::FileStream;
 using rainbow::Image;
 
 auto Image::decode(const Data& data, float scale) -> Image
@@ -33,6 +37,14 @@ auto Image::decode(const Data& data, float scale) -> Image
     }
 #endif  // USE_PVRTC
 
+    if (ktx::check(data)) {
+        return ktx::decode(data);
+    }
+
+    if (qoi::check(data)) {
+        return qoi::decode(data);
+    }
+
     if (png::check(data)) {
         return png::decode(data);
     }
@@ -50,3 +62,23 @@ auto Image::decode(const Data& data, float scale) -> Image
     R_ASSERT(false, "Unknown image format");
     return {};
 }
+
+auto Image::decode(FileStream& stream) -> Image
+{
+    constexpr size_t kSignatureSize = 8;
+    const auto signature = stream.peek(kSignatureSize);
+    if (signature.size() < kSignatureSize)
+        return {};
+
+    const Data header{
+        signature.data(), signature.size(), Data::Ownership::Reference};
+    if (!png::check(header))
+        return {};
+
+    return png::decode(stream);
+}
+
+auto Image::needs_decoding(const Data& data) -> bool
+{
+    return qoi::check(data) || png::check(data) || svg::check(data);
+}
@@ -5,6 +5,7 @@
 #ifndef GRAPHICS_IMAGE_H_
 #define GRAPHICS_IMAGE_H_
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
@@ -13,8 +14,17 @@
 namespace rainbow
 {
     class Data;
+    class FileStream;
 
     struct Image : private NonCopyable<Image> {
+        /// <summary>Byte range of a mipmap level.</summary>
+        struct Level {
+            size_t offset;
+            size_t size;
+        };
+
+        static constexpr uint32_t kMaxLevels = 16;
+
         enum class Format {
             Unknown,
             ATITC,  // Adreno
@@ -22,18 +32,29 @@ namespace rainbow
             BC2,    // DXT3
             BC3,    // DXT5
             ETC1,   // OpenGL ES standard
+            ETC2,   // OpenGL ES 3.0 standard
             PVRTC,  // iOS, OMAP43xx, PowerVR
             PNG,
+            QOI,
             RGBA,
             SVG,
         };
 
+        /// <summary>Layout of 16-bit pixels.</summary>
+        enum class Packing {
+            None,
+            RGBA4444,
+            RGB565,
+            RGBA5551,
+        };
+
         /// <summary>Creates an Image struct from image data.</summary>
         /// <remarks>
         ///   Supports
         ///   <list type="bullet">
         ///     <item>iOS: PVRTC and whatever UIImage devours.</item>
-        ///     <item>Others: PNG.</item>
+        ///     <item>All: KTX, KTX2.</item>
+        ///     <item>Others: PNG, QOI.</item>
         ///   </list>
         ///   Limitations
         ///   <list type="bullet">
@@ -45,10 +66,28 @@ namespace rainbow
         ///       PVRTC: PVR3 only; square, power of 2; no mipmaps;
         ///       pre-multiplied alpha.
         ///     </item>
+        ///     <item>
+        ///       KTX, KTX2: 2D textures only; no supercompression. Pixels are
+        ///       not copied so the data must outlive the image.
+        ///     </item>
         ///   </list>
         /// </remarks>
         static auto decode(const Data&, float scale) -> Image;
 
+        /// <summary>
+        ///   Decodes an image directly from <paramref name="stream"/> if its
+        ///   format can be decoded incrementally, i.e. PNG. Returns an empty
+        ///   image otherwise, without consuming the stream. If decoding fails,
+        ///   the stream may have been partly consumed.
+        /// </summary>
+        static auto decode(FileStream& stream) -> Image;
+
+        /// <summary>
+        ///   Returns whether <paramref name="data"/> must be decoded on the
+        ///   CPU before it can be uploaded, e.g. PNG and SVG.
+        /// </summary>
+        static auto needs_decoding(const Data& data) -> bool;
+
         Format format;        // NOLINT
         uint32_t width;       // NOLINT
         uint32_t height;      // NOLINT
@@ -57,6 +96,24 @@ namespace rainbow
         size_t size;          // NOLINT
         const uint8_t* data;  // NOLINT
 
+        /// <summary>
+        ///   Number of mipmap levels in <see cref="data"/>, starting with the
+        ///   full size image.
+        /// </summary>
+        uint32_t levels = 1;  // NOLINT
+
+        /// <summary>
+        ///   Location of each mipmap level. Only set when there is more than
+        ///   one level; <see cref="size"/> is then the sum of all levels.
+        /// </summary>
+        std::array<Level, kMaxLevels> mipmaps{};  // NOLINT
+
+        /// <summary>
+        ///   How pixels are packed into 16 bits, if they are. Packed images
+        ///   have a <see cref="depth"/> of 16.
+        /// </summary>
+        Packing packing = Packing::None;  // NOLINT
+
         Image(Format format_ = Format::Unknown,
               uint32_t width_ = 0,
               uint32_t height_ = 0,
@@ -72,7 +129,8 @@ namespace rainbow
         Image(Image&& image) noexcept
             : format(image.format), width(image.width), height(image.height),
               depth(image.depth), channels(image.channels), size(image.size),
-              data(image.data)
+              data(image.data), levels(image.levels), mipmaps(image.mipmaps),
+              packing(image.packing)
         {
             image.format = Format::Unknown;
             image.width = 0;
@@ -81,6 +139,8 @@ namespace rainbow
             image.channels = 0;
             image.size = 0;
             image.data = nullptr;
+            image.levels = 1;
+            image.packing = Packing::None;
         }
 
         ~Image()
@@ -91,11 +151,13 @@ namespace rainbow
                 case Format::BC2:
                 case Format::BC3:
                 case Format::ETC1:
+                case Format::ETC2:
                 case Format::PVRTC:
                 case Format::RGBA:
                     break;
 
                 case Format::PNG:
+                case Format::QOI:
                 case Format::SVG:
                 default:
                     delete[] data;
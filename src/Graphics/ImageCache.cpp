@@ -0,0 +1,365 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Graphics/ImageCache.h"
+
+#include "Platform/Macros.h"
+#if HAS_FILESYSTEM
+#    include <filesystem>
+#else
+#    include <dirent.h>
+#    include <sys/stat.h>
+#    include <utime.h>
+#endif
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/Data.h"
+#include "Common/Hash.h"
+#include "Common/Logging.h"
+#include "Graphics/Image.h"
+
+using rainbow::Data;
+using rainbow::Image;
+using rainbow::MemoryMappedFile;
+using rainbow::graphics::Dithering;
+using rainbow::graphics::ImageCache;
+
+namespace
+{
+    // Bump this whenever decoders or the cache layout change in a way that
+    // invalidates existing entries.
+    constexpr uint32_t kCacheVersion = 2;
+
+    constexpr uint8_t kKTX2Identifier[]{
+        0xab, 'K', 'T', 'X', ' ', '2', '0', 0xbb, '\r', '\n', 0x1a, '\n'};
+    constexpr uint32_t kVkR4G4B4A4UnormPack16 = 2;
+    constexpr uint32_t kVkR5G6B5UnormPack16 = 4;
+    constexpr uint32_t kVkR5G5B5A1UnormPack16 = 6;
+    constexpr uint32_t kVkR8G8Unorm = 16;
+    constexpr uint32_t kVkR8G8B8A8Unorm = 37;
+    constexpr size_t kKTX2HeaderSize = 80;
+    constexpr size_t kKTX2LevelIndexSize = 24;
+
+    struct CachedFile {
+        std::string name;
+        std::string path;
+        uint64_t size;
+        int64_t last_used;
+    };
+
+    auto ends_with(std::string_view str, std::string_view suffix)
+    {
+        return str.size() >= suffix.size() &&
+               str.substr(str.size() - suffix.size()) == suffix;
+    }
+
+    /// <summary>
+    ///   Returns whether <paramref name="name"/> is an image written by this
+    ///   version of the cache.
+    /// </summary>
+    auto is_current(std::string_view name)
+    {
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), ".v%u.ktx2", kCacheVersion);
+        return ends_with(name, suffix);
+    }
+
+    /// <summary>
+    ///   Returns whether <paramref name="name"/> was written by any version
+    ///   of the cache, including temporary files.
+    /// </summary>
+    auto is_cached(std::string_view name)
+    {
+        return ends_with(name, ".ktx2") ||
+               name.find(".ktx2.tmp") != std::string_view::npos;
+    }
+
+    template <typename F>
+    void for_each_file(const rainbow::filesystem::Path& directory, F&& f)
+    {
+#if HAS_FILESYSTEM
+        std::error_code error;
+        for (const auto& entry :
+             std::filesystem::directory_iterator{directory.string(), error}) {
+            if (!entry.is_regular_file(error))
+                continue;
+
+            const auto size = entry.file_size(error);
+            const auto last_write_time = entry.last_write_time(error);
+            if (error)
+                continue;
+
+            f(CachedFile{entry.path().filename().string(),
+                         entry.path().string(),
+                         size,
+                         last_write_time.time_since_epoch().count()});
+        }
+#else
+        auto dir = opendir(directory.c_str());
+        if (dir == nullptr)
+            return;
+
+        while (auto entry = readdir(dir)) {
+            auto path = (directory / entry->d_name).string();
+            struct stat sb;  // NOLINT(cppcoreguidelines-pro-type-member-init)
+            if (stat(path.c_str(), &sb) != 0 || !S_ISREG(sb.st_mode))
+                continue;
+
+            f(CachedFile{entry->d_name,
+                         std::move(path),
+                         static_cast<uint64_t>(sb.st_size),
+                         static_cast<int64_t>(sb.st_mtime)});
+        }
+
+        closedir(dir);
+#endif
+    }
+
+    void touch(const rainbow::filesystem::Path& path)
+    {
+#if HAS_FILESYSTEM
+        std::error_code error;
+        std::filesystem::last_write_time(
+            path.string(),
+            std::filesystem::file_time_type::clock::now(),
+            error);
+#else
+        utime(path.c_str(), nullptr);
+#endif
+    }
+
+    constexpr auto vk_format(const Image& image) -> uint32_t
+    {
+        switch (image.packing) {
+            case Image::Packing::None:
+                break;
+            case Image::Packing::RGBA4444:
+                return kVkR4G4B4A4UnormPack16;
+            case Image::Packing::RGB565:
+                return kVkR5G6B5UnormPack16;
+            case Image::Packing::RGBA5551:
+                return kVkR5G5B5A1UnormPack16;
+        }
+        return image.channels == 2 ? kVkR8G8Unorm : kVkR8G8B8A8Unorm;
+    }
+
+    template <typename T>
+    void append(std::vector<uint8_t>& buffer, const T& value)
+    {
+        const auto offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    /// <summary>Serializes the image as uncompressed KTX2.</summary>
+    /// <remarks>
+    ///   Only the fields read by the KTX2 decoder are written; there is no
+    ///   data format descriptor. LA images are stored as RG, and 16-bit
+    ///   images in their packed Vulkan equivalent.
+    /// </remarks>
+    auto encode_ktx2(const Image& image) -> std::vector<uint8_t>
+    {
+        const auto levels = image.levels;
+        const auto level = [&image](uint32_t i) {
+            return image.levels == 1 ? Image::Level{0, image.size}
+                                     : image.mipmaps[i];
+        };
+
+        std::vector<uint8_t> buffer;
+        buffer.reserve(kKTX2HeaderSize + kKTX2LevelIndexSize * levels +
+                       image.size + 4 * levels);
+        buffer.insert(buffer.end(),
+                      std::begin(kKTX2Identifier),
+                      std::end(kKTX2Identifier));
+        append(buffer, vk_format(image));
+        append(buffer,  // typeSize
+               image.packing == Image::Packing::None ? uint32_t{1}
+                                                     : uint32_t{2});
+        append(buffer, image.width);
+        append(buffer, image.height);
+        append(buffer, uint32_t{0});  // pixelDepth
+        append(buffer, uint32_t{0});  // layerCount
+        append(buffer, uint32_t{1});  // faceCount
+        append(buffer, levels);
+        append(buffer, uint32_t{0});  // supercompressionScheme
+        buffer.resize(kKTX2HeaderSize);
+
+        // Levels are stored smallest first, each aligned to 4 bytes
+        const auto index_offset = buffer.size();
+        buffer.resize(index_offset + kKTX2LevelIndexSize * levels);
+        for (auto i = levels; i-- > 0;) {
+            buffer.resize((buffer.size() + 3) & ~size_t{3});
+
+            const auto [offset, size] = level(i);
+            const uint64_t index[]{buffer.size(), size, size};
+            memcpy(buffer.data() + index_offset + kKTX2LevelIndexSize * i,
+                   index,
+                   sizeof(index));
+
+            buffer.insert(buffer.end(),
+                          image.data + offset,
+                          image.data + offset + size);
+        }
+
+        return buffer;
+    }
+}  // namespace
+
+auto ImageCache::key(const Data& source,
+                     float scale,
+                     bool mipmaps,
+                     Image::Packing packing,
+                     Dithering dithering) -> uint64_t
+{
+    return key(fnv1a(source.bytes(), source.size()),
+               scale,
+               mipmaps,
+               packing,
+               dithering);
+}
+
+auto ImageCache::key(uint64_t content_hash,
+                     float scale,
+                     bool mipmaps,
+                     Image::Packing packing,
+                     Dithering dithering) -> uint64_t
+{
+    struct {
+        uint32_t version;
+        float scale;
+        uint32_t mipmaps;
+        uint32_t packing;
+        uint32_t dithering;
+    } const parameters{kCacheVersion,
+                       scale,
+                       mipmaps ? 1U : 0U,
+                       static_cast<uint32_t>(packing),
+                       static_cast<uint32_t>(dithering)};
+
+    return fnv1a(reinterpret_cast<const uint8_t*>(&parameters),  // NOLINT
+                 sizeof(parameters),
+                 content_hash);
+}
+
+ImageCache::ImageCache(filesystem::Path directory, uint64_t budget)
+    : directory_(std::move(directory)), budget_(budget)
+{
+    // Images from other versions of the cache can never be read again, and
+    // temporary files are left behind by interrupted writes.
+    uint64_t size = 0;
+    for_each_file(directory_, [&size](const CachedFile& file) {
+        if (is_current(file.name))
+            size += file.size;
+        else if (is_cached(file.name))
+            std::remove(file.path.c_str());
+    });
+
+    size_ = size;
+    if (size > budget_)
+        prune();
+}
+
+void ImageCache::erase(uint64_t key) const
+{
+    std::remove(path(key).c_str());
+}
+
+auto ImageCache::find(uint64_t key) const -> MemoryMappedFile
+{
+    const auto image_path = path(key);
+    MemoryMappedFile file{image_path.c_str()};
+    if (file)
+        touch(image_path);
+    return file;
+}
+
+auto ImageCache::store(uint64_t key, const Image& image) const -> bool
+{
+    const bool is_decoded = image.format == Image::Format::PNG ||
+                            image.format == Image::Format::QOI ||
+                            image.format == Image::Format::SVG;
+    const bool is_supported = (image.channels == 2 && image.depth == 16) ||
+                              (image.channels == 4 && image.depth == 32) ||
+                              image.packing != Image::Packing::None;
+    if (!is_decoded || !is_supported || image.data == nullptr)
+        return false;
+
+    static std::atomic<uint32_t> counter{0};
+
+    const auto buffer = encode_ktx2(image);
+    const auto final_path = path(key);
+    auto temp_path = final_path;
+    temp_path += ".tmp" + std::to_string(counter.fetch_add(1));
+
+    auto file = std::fopen(temp_path.c_str(), "wb");
+    if (file == nullptr) {
+        LOGW("Failed to open '%s' for writing", temp_path.c_str());
+        return false;
+    }
+
+    const auto written = std::fwrite(buffer.data(), 1, buffer.size(), file);
+    const auto closed = std::fclose(file) == 0;
+    if (written != buffer.size() || !closed ||
+        std::rename(temp_path.c_str(), final_path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    if (size_.fetch_add(buffer.size()) + buffer.size() > budget_)
+        prune();
+
+    return true;
+}
+
+auto ImageCache::path(uint64_t key) const -> filesystem::Path
+{
+    char filename[32];
+    std::snprintf(filename,
+                  sizeof(filename),
+                  "%016" PRIx64 ".v%u.ktx2",
+                  key,
+                  kCacheVersion);
+    return directory_ / filename;
+}
+
+void ImageCache::prune() const
+{
+    std::lock_guard<std::mutex> lock{prune_mutex_};
+
+    std::vector<CachedFile> files;
+    uint64_t size = 0;
+    for_each_file(directory_, [&files, &size](CachedFile&& file) {
+        if (!is_current(file.name))
+            return;
+
+        size += file.size;
+        files.push_back(std::move(file));
+    });
+
+    // Leave some headroom so that we don't prune on every store
+    const auto target = budget_ - budget_ / 4;
+    if (size > target) {
+        std::sort(files.begin(),
+                  files.end(),
+                  [](const CachedFile& a, const CachedFile& b) {
+                      return a.last_used < b.last_used;
+                  });
+        for (const auto& file : files) {
+            if (size <= target)
+                break;
+
+            if (std::remove(file.path.c_str()) == 0)
+                size -= file.size;
+        }
+    }
+
+    size_ = size;
+}
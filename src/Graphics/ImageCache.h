@@ -0,0 +1,114 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef GRAPHICS_IMAGECACHE_H_
+#define GRAPHICS_IMAGECACHE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "Common/NonCopyable.h"
+#include "FileSystem/MemoryMappedFile.h"
+#include "FileSystem/Path.h"
+#include "Graphics/ColorDepth.h"
+
+namespace rainbow
+{
+    class Data;
+}  // namespace rainbow
+
+namespace rainbow::graphics
+{
+    /// <summary>
+    ///   On-disk cache of decoded images, keyed by the hash of their source
+    ///   data and decoding parameters.
+    /// </summary>
+    /// <remarks>
+    ///   Images are stored as uncompressed KTX2 so that they can be mapped
+    ///   into memory and uploaded without decoding or copying. Entries are
+    ///   written to a temporary file first, then renamed, so that readers
+    ///   never see partially written images. It is safe to use the cache
+    ///   from multiple threads.
+    ///
+    ///   The cache is kept within a byte budget by removing the least
+    ///   recently used images whenever it is exceeded. Reading an image
+    ///   counts as using it. Images written by other versions of the cache
+    ///   are removed when the cache is created.
+    /// </remarks>
+    class ImageCache : private NonCopyable<ImageCache>
+    {
+    public:
+        /// <summary>
+        ///   Returns the cache key for <paramref name="source"/> decoded at
+        ///   <paramref name="scale"/>, with or without mipmaps, and packed
+        ///   into 16 bits with the specified dithering.
+        /// </summary>
+        [[nodiscard]] static auto key(
+            const Data& source,
+            float scale,
+            bool mipmaps,
+            Image::Packing packing = Image::Packing::None,
+            Dithering dithering = Dithering::None) -> uint64_t;
+
+        /// <summary>
+        ///   Returns the cache key for source data whose FNV-1a hash is
+        ///   <paramref name="content_hash"/>, e.g. as recorded in a pack.
+        ///   Equivalent to hashing the data itself.
+        /// </summary>
+        [[nodiscard]] static auto key(
+            uint64_t content_hash,
+            float scale,
+            bool mipmaps,
+            Image::Packing packing = Image::Packing::None,
+            Dithering dithering = Dithering::None) -> uint64_t;
+
+        /// <summary>Default size budget of the cache, in bytes.</summary>
+        static constexpr uint64_t kDefaultBudget = 64 * 1024 * 1024;
+
+        /// <summary>
+        ///   Creates a cache in <paramref name="directory"/>, which must
+        ///   exist, that is kept within <paramref name="budget"/> bytes.
+        /// </summary>
+        explicit ImageCache(filesystem::Path directory,
+                            uint64_t budget = kDefaultBudget);
+
+        /// <summary>
+        ///   Removes the cached image for <paramref name="key"/>.
+        /// </summary>
+        void erase(uint64_t key) const;
+
+        /// <summary>
+        ///   Maps the cached image for <paramref name="key"/> into memory.
+        ///   The returned file is empty if there is no such image.
+        /// </summary>
+        [[nodiscard]] auto find(uint64_t key) const -> MemoryMappedFile;
+
+        /// <summary>
+        ///   Writes <paramref name="image"/> to the cache. Only decoded 8-bit
+        ///   LA and RGBA, and 16-bit packed images are stored.
+        /// </summary>
+        /// <returns><c>true</c> if the image was stored.</returns>
+        auto store(uint64_t key, const Image& image) const -> bool;
+
+        /// <summary>Returns the total size of cached images, in bytes.</summary>
+        [[nodiscard]] auto size() const { return size_.load(); }
+
+    private:
+        filesystem::Path directory_;
+        uint64_t budget_;
+        mutable std::atomic<uint64_t> size_{0};
+        mutable std::mutex prune_mutex_;
+
+        [[nodiscard]] auto path(uint64_t key) const -> filesystem::Path;
+
+        /// <summary>
+        ///   Removes least recently used images until the cache is well
+        ///   within its budget.
+        /// </summary>
+        void prune() const;
+    };
+}  // namespace rainbow::graphics
+
+#endif
@@ -27,6 +27,13 @@ Label::~Label()
 #endif
 }
 
+#ifdef RAINBOW_TEST
+Label::Label(const rainbow::ISolemnlySwearThatIAmOnlyTesting& test)
+    : buffer_(test)
+{
+}
+#endif  // RAINBOW_TEST
+
 auto Label::alignment(TextAlignment a) -> Label&
 {
     alignment_ = a;
@@ -34,6 +41,16 @@ auto Label::alignment(TextAlignment a) -> Label&
     return *this;
 }
 
+auto Label::append(czstring text) -> Label&
+{
+    if (is_empty(text))
+        return *this;
+
+    text_ += text;
+    set_needs_update(kStaleAppend);
+    return *this;
+}
+
 auto Label::angle(float r) -> Label&
 {
     if (are_equal(r, angle_)) {
@@ -102,34 +119,100 @@ auto Label::text(czstring text) -> Label&
 
 void Label::update(GameBase& context)
 {
-    if (stale_ != 0) {
-        update_internal(context);
+    if (update_vertices(context.typesetter()))
         upload();
-        clear_state();
+}
+
+auto Label::update_vertices(Typesetter& typesetter) -> bool
+{
+    // Glyphs laid out before a font was reloaded are gone.
+    const auto& font_cache = typesetter.font_cache();
+    if (font_cache.epoch() != font_epoch_ ||
+        (pending_glyphs_ > 0 &&
+         font_cache.generation() != glyph_generation_)) {
+        set_needs_update(kStaleBuffer);
     }
+
+    if (stale_ == 0)
+        return false;
+
+    update_internal(typesetter);
+    clear_state();
+    return true;
 }
 
-void Label::update_internal(GameBase& context)
+void Label::update_internal(Typesetter& typesetter)
 {
     if ((stale_ & kStaleBuffer) != 0) {
-        vertices_ = context.typesetter().draw_text(
+        glyph_generation_ = typesetter.font_cache().generation();
+        font_epoch_ = typesetter.font_cache().epoch();
+        layout_ = {};
+        vertices_ = typesetter.draw_text(
             text_,
             position_,
             TextAttributes{font_face_, font_size_, alignment_},
-            &size_);
+            &size_,
+            &pending_glyphs_,
+            &layout_);
         for (auto&& vx : vertices_) {
             vx.color = color_;
         }
+        upload_start_ = 0;
+    } else if ((stale_ & kStaleAppend) != 0) {
+        if (pending_glyphs_ == 0)
+            glyph_generation_ = typesetter.font_cache().generation();
+
+        // The last line may continue into the appended text so it needs to be
+        // laid out again. Its pending glyphs are counted again as well.
+        const auto vertex_start = layout_.glyph_start * 4;
+        const auto replaced_pending = layout_.pending_glyphs;
+        uint32_t pending_glyphs = 0;
+        auto vertices = typesetter.draw_text(
+            text_,
+            position_,
+            TextAttributes{font_face_, font_size_, alignment_},
+            &size_,
+            &pending_glyphs,
+            &layout_);
+        pending_glyphs_ = pending_glyphs_ - replaced_pending + pending_glyphs;
+
+        vertices_.resize(vertex_start);
+        vertices_.insert(vertices_.end(), vertices.begin(), vertices.end());
+        upload_start_ = vertex_start;
+
+        if ((stale_ & kStaleColor) != 0)
+            upload_start_ = 0;
+
+        for (auto i = vertices_.begin() + upload_start_; i != vertices_.end();
+             ++i) {
+            i->color = color_;
+        }
     } else if ((stale_ & kStaleColor) != 0) {
         for (auto&& vx : vertices_) {
             vx.color = color_;
         }
+        upload_start_ = 0;
     }
 }
 
-void Label::upload() const
+void Label::upload()
 {
-    buffer_.upload(vertices_.data(), vertices_.size() * sizeof(vertices_[0]));
+    constexpr auto kVertexSize = sizeof(vertices_[0]);
+
+    const auto count = narrow_cast<uint32_t>(vertices_.size());
+    if (upload_start_ == 0) {
+        buffer_.upload(vertices_.data(), count * kVertexSize);
+        buffer_capacity_ = count;
+    } else if (count > buffer_capacity_) {
+        // Grow geometrically so that repeated appends stay cheap.
+        buffer_capacity_ = std::max(count, buffer_capacity_ * 2);
+        buffer_.upload(nullptr, buffer_capacity_ * kVertexSize);
+        buffer_.upload(0, vertices_.data(), count * kVertexSize);
+    } else if (count > upload_start_) {
+        buffer_.upload(upload_start_ * kVertexSize,
+                       vertices_.data() + upload_start_,
+                       (count - upload_start_) * kVertexSize);
+    }
 }
 
 void rainbow::graphics::draw(Context& ctx, const Label& label)
@@ -18,10 +18,12 @@
 #include "Graphics/SpriteVertex.h"
 #include "Graphics/VertexArray.h"
 #include "Math/Vec2.h"
+#include "Text/Typesetter.h"
 
 namespace rainbow
 {
     class GameBase;
+    struct ISolemnlySwearThatIAmOnlyTesting;
 
     /// <summary>Label for displaying text.</summary>
     class Label : private NonCopyable<Label>
@@ -31,6 +33,7 @@ namespace rainbow
         static constexpr uint32_t kStaleBuffer      = 1U << 0;
         static constexpr uint32_t kStaleBufferSize  = 1U << 1;
         static constexpr uint32_t kStaleColor       = 1U << 2;
+        static constexpr uint32_t kStaleAppend      = 1U << 3;
         static constexpr uint32_t kStaleMask        = 0xffffU;
         // clang-format on
 
@@ -79,6 +82,12 @@ namespace rainbow
             return array_;
         }
 
+        /// <summary>Returns the client vertex buffer.</summary>
+        [[nodiscard]] auto vertices() const -> const std::vector<SpriteVertex>&
+        {
+            return vertices_;
+        }
+
         /// <summary>Returns the vertex count.</summary>
         [[nodiscard]] auto vertex_count() const
         {
@@ -92,6 +101,12 @@ namespace rainbow
         /// <summary>Sets text alignment.</summary>
         auto alignment(TextAlignment) -> Label&;
 
+        /// <summary>
+        ///   Appends text. Only the last line and the appended text are laid
+        ///   out and uploaded.
+        /// </summary>
+        auto append(czstring) -> Label&;
+
         /// <summary>
         ///   Sets angle of rotation (in radian). Pivot depends on text
         ///   alignment.
@@ -124,6 +139,17 @@ namespace rainbow
         /// <summary>Populates the vertex array.</summary>
         void update(GameBase&);
 
+        /// <summary>
+        ///   Updates the client vertex buffer without uploading it. Used by
+        ///   <see cref="TextBatch"/>.
+        /// </summary>
+        /// <returns><c>true</c> if the vertices were updated.</returns>
+        auto update_vertices(Typesetter&) -> bool;
+
+#ifdef RAINBOW_TEST
+        explicit Label(const ISolemnlySwearThatIAmOnlyTesting&);
+#endif
+
     protected:
         [[nodiscard]] auto state() const { return stale_; }
         [[nodiscard]] auto vertex_buffer() const { return vertices_.data(); }
@@ -133,8 +159,8 @@ namespace rainbow
         /// <summary>Sets label as needing update.</summary>
         void set_needs_update(unsigned int what) { stale_ |= what; }
 
-        void update_internal(GameBase&);
-        void upload() const;
+        void update_internal(Typesetter&);
+        void upload();
 
     private:
         /// <summary>Flags indicating need for update.</summary>
@@ -173,6 +199,24 @@ namespace rainbow
         /// <summary>Label size.</summary>
         Vec2f size_;
 
+        /// <summary>Number of glyphs that are still being rasterised.</summary>
+        uint32_t pending_glyphs_ = 0;
+
+        /// <summary>Font cache generation at last update.</summary>
+        uint32_t glyph_generation_ = 0;
+
+        /// <summary>Font cache epoch at last layout.</summary>
+        uint32_t font_epoch_ = 0;
+
+        /// <summary>Where to continue the layout when appending text.</summary>
+        TextLayout layout_;
+
+        /// <summary>Index of the first vertex that needs uploading.</summary>
+        uint32_t upload_start_ = 0;
+
+        /// <summary>Number of vertices allocated on the GPU.</summary>
+        uint32_t buffer_capacity_ = 0;
+
         /// <summary>Vertex buffer.</summary>
         graphics::Buffer buffer_;
     };
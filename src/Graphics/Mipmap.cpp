@@ -0,0 +1,277 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Graphics/Mipmap.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define RAINBOW_MIPMAP_SSE2
+#    include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#    define RAINBOW_MIPMAP_NEON
+#    include <arm_neon.h>
+#endif
+
+#include "Graphics/Image.h"
+
+using rainbow::Image;
+
+namespace
+{
+    // Each texel is loaded into four lanes. RGBA maps directly; LA is loaded
+    // as (L, 0, 0, A) so that both formats share the same kernel.
+
+#if defined(RAINBOW_MIPMAP_SSE2)
+    using float4 = __m128;
+
+    auto load(const uint8_t* p, uint32_t channels) -> float4
+    {
+        if (channels == 2)
+            return _mm_setr_ps(p[0], 0.0F, 0.0F, p[1]);
+
+        int32_t rgba;  // NOLINT(cppcoreguidelines-init-variables)
+        memcpy(&rgba, p, sizeof(rgba));
+
+        const auto zero = _mm_setzero_si128();
+        const auto x = _mm_unpacklo_epi8(_mm_cvtsi32_si128(rgba), zero);
+        return _mm_cvtepi32_ps(_mm_unpacklo_epi16(x, zero));
+    }
+
+    void store(float4 v, uint8_t* p, uint32_t channels)
+    {
+        auto x = _mm_cvtps_epi32(v);
+        x = _mm_packs_epi32(x, x);
+        x = _mm_packus_epi16(x, x);
+
+        const auto rgba = static_cast<uint32_t>(_mm_cvtsi128_si32(x));
+        if (channels == 2) {
+            p[0] = rgba & 0xff;
+            p[1] = rgba >> 24;
+        } else {
+            memcpy(p, &rgba, sizeof(rgba));
+        }
+    }
+
+    auto downsample(float4 p0, float4 p1, float4 p2, float4 p3) -> float4
+    {
+        const auto rgb_mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+        const auto one_w = _mm_setr_ps(0.0F, 0.0F, 0.0F, 1.0F);
+        const auto weights = [rgb_mask, one_w](float4 p) {
+            const auto a = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 3, 3));
+            return _mm_or_ps(_mm_and_ps(a, rgb_mask), one_w);
+        };
+
+        const auto sum = _mm_add_ps(_mm_add_ps(p0, p1), _mm_add_ps(p2, p3));
+        const auto weighted =
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(p0, weights(p0)),
+                                  _mm_mul_ps(p1, weights(p1))),
+                       _mm_add_ps(_mm_mul_ps(p2, weights(p2)),
+                                  _mm_mul_ps(p3, weights(p3))));
+
+        // The alpha lane of `weighted` holds the sum of alpha
+        const auto alpha = _mm_shuffle_ps(
+            weighted, weighted, _MM_SHUFFLE(3, 3, 3, 3));
+        const auto color =
+            _mm_div_ps(weighted, _mm_max_ps(alpha, _mm_set1_ps(1.0F)));
+        const auto average = _mm_mul_ps(sum, _mm_set1_ps(0.25F));
+
+        const auto mask = _mm_and_ps(
+            _mm_cmpgt_ps(alpha, _mm_setzero_ps()), rgb_mask);
+        return _mm_or_ps(_mm_and_ps(mask, color),
+                         _mm_andnot_ps(mask, average));
+    }
+#elif defined(RAINBOW_MIPMAP_NEON)
+    using float4 = float32x4_t;
+
+    auto load(const uint8_t* p, uint32_t channels) -> float4
+    {
+        if (channels == 2) {
+            const float la[]{static_cast<float>(p[0]),
+                             0.0F,
+                             0.0F,
+                             static_cast<float>(p[1])};
+            return vld1q_f32(la);
+        }
+
+        uint32_t rgba;  // NOLINT(cppcoreguidelines-init-variables)
+        memcpy(&rgba, p, sizeof(rgba));
+
+        const auto x = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(rgba)));
+        return vcvtq_f32_u32(vmovl_u16(vget_low_u16(x)));
+    }
+
+    void store(float4 v, uint8_t* p, uint32_t channels)
+    {
+        const auto x = vqmovn_u32(vcvtnq_u32_f32(v));
+        const auto rgba = vqmovn_u16(vcombine_u16(x, x));
+        if (channels == 2) {
+            p[0] = vget_lane_u8(rgba, 0);
+            p[1] = vget_lane_u8(rgba, 3);
+        } else {
+            vst1_lane_u32(reinterpret_cast<uint32_t*>(p),  // NOLINT
+                          vreinterpret_u32_u8(rgba),
+                          0);
+        }
+    }
+
+    auto downsample(float4 p0, float4 p1, float4 p2, float4 p3) -> float4
+    {
+        const uint32_t rgb_bits[]{~0U, ~0U, ~0U, 0U};
+        const auto rgb_mask = vld1q_u32(rgb_bits);
+        const auto weights = [](float4 p) {
+            return vsetq_lane_f32(1.0F, vdupq_laneq_f32(p, 3), 3);
+        };
+
+        const auto sum = vaddq_f32(vaddq_f32(p0, p1), vaddq_f32(p2, p3));
+        const auto weighted =
+            vaddq_f32(vaddq_f32(vmulq_f32(p0, weights(p0)),
+                                vmulq_f32(p1, weights(p1))),
+                      vaddq_f32(vmulq_f32(p2, weights(p2)),
+                                vmulq_f32(p3, weights(p3))));
+
+        // The alpha lane of `weighted` holds the sum of alpha
+        const auto alpha = vdupq_laneq_f32(weighted, 3);
+        const auto color =
+            vdivq_f32(weighted, vmaxq_f32(alpha, vdupq_n_f32(1.0F)));
+        const auto average = vmulq_f32(sum, vdupq_n_f32(0.25F));
+
+        const auto mask =
+            vandq_u32(vcgtq_f32(alpha, vdupq_n_f32(0.0F)), rgb_mask);
+        return vbslq_f32(mask, color, average);
+    }
+#else
+    using float4 = std::array<float, 4>;
+
+    auto load(const uint8_t* p, uint32_t channels) -> float4
+    {
+        const auto f = [p](int i) { return static_cast<float>(p[i]); };
+        return channels == 2 ? float4{f(0), 0.0F, 0.0F, f(1)}
+                             : float4{f(0), f(1), f(2), f(3)};
+    }
+
+    void store(const float4& v, uint8_t* p, uint32_t channels)
+    {
+        const auto to_byte = [](float f) {
+            return static_cast<uint8_t>(std::clamp(f + 0.5F, 0.0F, 255.0F));
+        };
+
+        if (channels == 2) {
+            p[0] = to_byte(v[0]);
+            p[1] = to_byte(v[3]);
+        } else {
+            for (int i = 0; i < 4; ++i)
+                p[i] = to_byte(v[i]);
+        }
+    }
+
+    auto downsample(const float4& p0,
+                    const float4& p1,
+                    const float4& p2,
+                    const float4& p3) -> float4
+    {
+        const float alpha = p0[3] + p1[3] + p2[3] + p3[3];
+        float4 result{};
+        for (int i = 0; i < 3; ++i) {
+            result[i] = alpha > 0.0F ? (p0[i] * p0[3] + p1[i] * p1[3] +
+                                        p2[i] * p2[3] + p3[i] * p3[3]) /
+                                           alpha
+                                     : (p0[i] + p1[i] + p2[i] + p3[i]) * 0.25F;
+        }
+        result[3] = alpha * 0.25F;
+        return result;
+    }
+#endif
+
+    void downsample(const uint8_t* src,
+                    uint32_t width,
+                    uint32_t height,
+                    uint32_t channels,
+                    uint8_t* dst)
+    {
+        const auto dst_width = std::max(width / 2, 1U);
+        const auto dst_height = std::max(height / 2, 1U);
+        const auto stride = width * channels;
+        for (uint32_t y = 0; y < dst_height; ++y) {
+            const auto row0 = src + std::min(y * 2, height - 1) * stride;
+            const auto row1 = src + std::min(y * 2 + 1, height - 1) * stride;
+            for (uint32_t x = 0; x < dst_width; ++x) {
+                const auto x0 = std::min(x * 2, width - 1) * channels;
+                const auto x1 = std::min(x * 2 + 1, width - 1) * channels;
+                store(downsample(load(row0 + x0, channels),
+                                 load(row0 + x1, channels),
+                                 load(row1 + x0, channels),
+                                 load(row1 + x1, channels)),
+                      dst,
+                      channels);
+                dst += channels;
+            }
+        }
+    }
+}  // namespace
+
+auto rainbow::graphics::mipmap_levels(uint32_t width, uint32_t height)
+    -> uint32_t
+{
+    uint32_t levels = 1;
+    for (auto size = std::max(width, height); size > 1; size /= 2)
+        ++levels;
+    return levels;
+}
+
+auto rainbow::graphics::generate_mipmaps(Image&& image) -> Image
+{
+    const bool is_decoded = image.format == Image::Format::PNG ||
+                            image.format == Image::Format::QOI ||
+                            image.format == Image::Format::SVG;
+    const bool is_supported = (image.channels == 2 && image.depth == 16) ||
+                              (image.channels == 4 && image.depth == 32);
+    if (!is_decoded || !is_supported || image.levels > 1 ||
+        image.data == nullptr) {
+        return std::move(image);
+    }
+
+    const auto levels =
+        std::min(mipmap_levels(image.width, image.height), Image::kMaxLevels);
+
+    std::array<Image::Level, Image::kMaxLevels> mipmaps{};
+    size_t size = 0;
+    for (uint32_t i = 0; i < levels; ++i) {
+        const auto level_size = size_t{std::max(image.width >> i, 1U)} *
+                                std::max(image.height >> i, 1U) *
+                                image.channels;
+        mipmaps[i] = {size, level_size};
+        size += level_size;
+    }
+
+    auto buffer = std::make_unique<uint8_t[]>(size);
+    std::copy_n(image.data, image.size, buffer.get());
+
+    auto width = image.width;
+    auto height = image.height;
+    for (uint32_t i = 1; i < levels; ++i) {
+        downsample(buffer.get() + mipmaps[i - 1].offset,
+                   width,
+                   height,
+                   image.channels,
+                   buffer.get() + mipmaps[i].offset);
+        width = std::max(width / 2, 1U);
+        height = std::max(height / 2, 1U);
+    }
+
+    Image mipmapped{image.format,
+                    image.width,
+                    image.height,
+                    image.depth,
+                    image.channels,
+                    size,
+                    buffer.release()};
+    mipmapped.levels = levels;
+    mipmapped.mipmaps = mipmaps;
+    return mipmapped;
+}
@@ -0,0 +1,36 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef GRAPHICS_MIPMAP_H_
+#define GRAPHICS_MIPMAP_H_
+
+#include <cstdint>
+
+namespace rainbow
+{
+    struct Image;
+}  // namespace rainbow
+
+namespace rainbow::graphics
+{
+    /// <summary>
+    ///   Returns the number of levels in a full mipmap chain for an image of
+    ///   the specified size.
+    /// </summary>
+    auto mipmap_levels(uint32_t width, uint32_t height) -> uint32_t;
+
+    /// <summary>
+    ///   Returns a copy of <paramref name="image"/> with a full mipmap chain
+    ///   appended.
+    /// </summary>
+    /// <remarks>
+    ///   Each level is downsampled from the previous one with a 2x2 box
+    ///   filter. Colours are weighted by alpha so that transparent texels do
+    ///   not bleed into opaque ones. Only decoded 8-bit LA and RGBA images
+    ///   are supported; other images are returned as is.
+    /// </remarks>
+    auto generate_mipmaps(Image&& image) -> Image;
+}  // namespace rainbow::graphics
+
+#endif
@@ -28,6 +28,9 @@
 #endif
 
 #ifdef GL_ES_VERSION_2_0
+#    ifndef GL_RGB8
+#        define GL_RGB8 GL_RGB
+#    endif
 #    ifndef GL_RGBA8
 #        define GL_RGBA8 GL_RGBA
 #    endif
@@ -8,12 +8,14 @@
 #include "Graphics/Drawable.h"
 #include "Graphics/Label.h"
 #include "Graphics/SpriteBatch.h"
+#include "Graphics/TextBatch.h"
 
 using rainbow::Animation;
 using rainbow::GameBase;
 using rainbow::IDrawable;
 using rainbow::Label;
 using rainbow::SpriteBatch;
+using rainbow::TextBatch;
 using rainbow::graphics::Context;
 using rainbow::graphics::RenderQueue;
 
@@ -43,6 +45,8 @@ namespace
 
         void operator()(SpriteBatch* batch) const { batch->update(context); }
 
+        void operator()(TextBatch* batch) const { batch->update(context); }
+
         template <typename T>
         void operator()(T&& unit) const
         {
@@ -19,6 +19,7 @@ namespace rainbow
     class IDrawable;
     class Label;
     class SpriteBatch;
+    class TextBatch;
 }  // namespace rainbow
 
 namespace rainbow::graphics
@@ -32,7 +33,8 @@ namespace rainbow::graphics
             Animation*,
             IDrawable*,
             Label*,
-            SpriteBatch*>;
+            SpriteBatch*,
+            TextBatch*>;
 
         template <typename T>
         RenderUnit(T& variant, std::string tag = {})
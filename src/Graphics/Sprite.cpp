@@ -124,6 +124,12 @@ auto Sprite::is_mirrored() const -> bool
     return (state_ & kIsMirrored) == kIsMirrored;
 }
 
+auto Sprite::invalidate_texture() -> Sprite&
+{
+    state_ |= kStaleTexture | kStaleNormalMap;
+    return *this;
+}
+
 auto Sprite::mirror() -> Sprite&
 {
     state_ ^= kIsMirrored;
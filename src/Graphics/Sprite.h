@@ -126,6 +126,12 @@ namespace rainbow
             return *this;
         }
 
+        /// <summary>
+        ///   Marks texture coordinates as stale, e.g. after the texture was
+        ///   resized.
+        /// </summary>
+        auto invalidate_texture() -> Sprite&;
+
         /// <summary>Mirrors sprite.</summary>
         auto mirror() -> Sprite&;
 
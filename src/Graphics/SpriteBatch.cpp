@@ -122,6 +122,12 @@ void SpriteBatch::update(GameBase& context)
     bool needs_update = false;
     auto sprites = sprites_.data();
     auto texture = context.texture_provider().raw_get(*texture_);
+    if (texture.width != texture_width_ || texture.height != texture_height_) {
+        texture_width_ = texture.width;
+        texture_height_ = texture.height;
+        for (uint32_t i = 0; i < count_; ++i)
+            sprites[i].invalidate_texture();
+    }
 
     if (normals_) {
         auto normal = context.texture_provider().raw_get(*normal_);
@@ -202,6 +202,13 @@ namespace rainbow
         /// <summary>Normal map used by all sprites in the batch.</summary>
         const graphics::Texture* normal_ = nullptr;
 
+        /// <summary>
+        ///   Texture dimensions that texture coordinates were last calculated
+        ///   for. These change when an asynchronously loaded texture is ready.
+        /// </summary>
+        uint32_t texture_width_ = 0;
+        uint32_t texture_height_ = 0;
+
         /// <summary>Whether the batch is visible.</summary>
         bool visible_ = true;
 
@@ -0,0 +1,194 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Graphics/TextBatch.h"
+
+#include <algorithm>
+
+#include "Graphics/Label.h"
+#include "Script/GameBase.h"
+
+using rainbow::GameBase;
+using rainbow::Label;
+using rainbow::SpriteVertex;
+using rainbow::TextBatch;
+using rainbow::Typesetter;
+
+namespace
+{
+    /// <summary>
+    ///   Returns the number of vertices to reserve for a label with
+    ///   <paramref name="count"/> vertices, leaving room for it to grow.
+    /// </summary>
+    constexpr auto reserve_size(uint32_t count) -> uint32_t
+    {
+        // Round up to whole quads.
+        return (count + (count >> 1) + 3) & ~3U;
+    }
+}  // namespace
+
+TextBatch::TextBatch()
+{
+    array_.reconfigure([this] { buffer_.bind(); });
+}
+
+TextBatch::~TextBatch()
+{
+#ifndef NDEBUG
+    Director::assert_unused(
+        this, "TextBatch deleted but is still in the render queue.");
+#endif
+}
+
+#ifdef RAINBOW_TEST
+TextBatch::TextBatch(const rainbow::ISolemnlySwearThatIAmOnlyTesting& test)
+    : buffer_(test)
+{
+}
+#endif  // RAINBOW_TEST
+
+void TextBatch::add(Label& label)
+{
+    R_ASSERT(std::none_of(slots_.cbegin(),
+                          slots_.cend(),
+                          [&label](auto&& slot) {
+                              return slot.label == &label;
+                          }),
+             "Label was already added to this batch");
+
+    slots_.push_back(
+        {&label, narrow_cast<uint32_t>(vertices_.size()), 0, 0, true});
+}
+
+void TextBatch::remove(const Label& label)
+{
+    auto i = std::find_if(slots_.begin(), slots_.end(), [&label](auto&& slot) {
+        return slot.label == &label;
+    });
+    if (i == slots_.end())
+        return;
+
+    release(*i);
+    slots_.erase(i);
+}
+
+void TextBatch::update(GameBase& context)
+{
+    update_vertices(context.typesetter());
+    upload();
+}
+
+void TextBatch::update_vertices(Typesetter& typesetter)
+{
+    for (auto&& slot : slots_) {
+        if (slot.label->update_vertices(typesetter) || slot.needs_copy)
+            copy(slot);
+    }
+
+    // Reclaim space once most of the buffer is unused.
+    if (used_ < vertices_.size() / 2)
+        compact();
+}
+
+void TextBatch::compact()
+{
+    std::vector<SpriteVertex> vertices;
+    vertices.reserve(reserve_size(used_));
+    for (auto&& slot : slots_) {
+        const auto first = vertices_.cbegin() + slot.offset;
+        slot.offset = narrow_cast<uint32_t>(vertices.size());
+        slot.capacity = reserve_size(slot.count);
+        vertices.insert(vertices.end(), first, first + slot.count);
+        vertices.resize(slot.offset + slot.capacity);
+    }
+
+    vertices_ = std::move(vertices);
+    mark_dirty(0, narrow_cast<uint32_t>(vertices_.size()));
+}
+
+void TextBatch::copy(Slot& slot)
+{
+    const auto& vertices = slot.label->vertices();
+    const auto count = narrow_cast<uint32_t>(vertices.size());
+    if (count > slot.capacity) {
+        const auto capacity = reserve_size(count);
+        if (slot.offset + slot.capacity == vertices_.size()) {
+            // This label is at the end of the buffer so we can grow in place.
+            vertices_.resize(slot.offset + capacity);
+        } else {
+            release(slot);
+            slot.offset = narrow_cast<uint32_t>(vertices_.size());
+            vertices_.resize(vertices_.size() + capacity);
+            slot.count = 0;
+        }
+        slot.capacity = capacity;
+
+        R_ASSERT(vertices_.size() / 4 <= graphics::kMaxSprites,
+                 "Hard-coded limit reached");
+    }
+
+    const auto first = vertices_.begin() + slot.offset;
+    std::copy(vertices.cbegin(), vertices.cend(), first);
+
+    // Hide any leftover glyphs by collapsing them into degenerate quads.
+    if (slot.count > count)
+        std::fill(first + count, first + slot.count, SpriteVertex{});
+
+    mark_dirty(slot.offset, slot.offset + std::max(count, slot.count));
+    used_ -= slot.count;
+    used_ += count;
+    slot.count = count;
+    slot.needs_copy = false;
+}
+
+void TextBatch::mark_dirty(uint32_t begin, uint32_t end)
+{
+    if (begin >= end)
+        return;
+
+    if (dirty_begin_ == dirty_end_) {
+        dirty_begin_ = begin;
+        dirty_end_ = end;
+    } else {
+        dirty_begin_ = std::min(dirty_begin_, begin);
+        dirty_end_ = std::max(dirty_end_, end);
+    }
+}
+
+void TextBatch::release(const Slot& slot)
+{
+    const auto first = vertices_.begin() + slot.offset;
+    std::fill(first, first + slot.count, SpriteVertex{});
+    mark_dirty(slot.offset, slot.offset + slot.count);
+    used_ -= slot.count;
+}
+
+void TextBatch::upload()
+{
+    constexpr auto kVertexSize = sizeof(SpriteVertex);
+
+    const auto size = narrow_cast<uint32_t>(vertices_.size());
+    if (size > buffer_size_ || size < buffer_size_ / 2) {
+        // Reallocate the buffer if it grew, or shrank considerably.
+        buffer_.upload(vertices_.data(), size * kVertexSize);
+        buffer_size_ = size;
+    } else if (dirty_begin_ < dirty_end_) {
+        buffer_.upload(dirty_begin_ * kVertexSize,
+                       vertices_.data() + dirty_begin_,
+                       (dirty_end_ - dirty_begin_) * kVertexSize);
+    }
+
+    dirty_begin_ = 0;
+    dirty_end_ = 0;
+}
+
+void rainbow::graphics::draw(Context& ctx, const TextBatch& batch)
+{
+    const auto count = batch.vertex_count();
+    if (count == 0)
+        return;
+
+    bind(ctx, FontCache::Get()->texture());
+    draw(batch.vertex_array(), count);
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef GRAPHICS_TEXTBATCH_H_
+#define GRAPHICS_TEXTBATCH_H_
+
+#include <vector>
+
+#include "Common/NonCopyable.h"
+#include "Common/TypeCast.h"
+#include "Graphics/Buffer.h"
+#include "Graphics/SpriteVertex.h"
+#include "Graphics/VertexArray.h"
+
+namespace rainbow
+{
+    class GameBase;
+    class Label;
+    class Typesetter;
+    struct ISolemnlySwearThatIAmOnlyTesting;
+
+    /// <summary>A drawable batch of labels.</summary>
+    /// <remarks>
+    ///   <para>
+    ///     All labels share a common vertex buffer object and are drawn with a
+    ///     single glDraw call. Each label is assigned a range in the buffer
+    ///     with some room to grow, and only the ranges of labels that changed
+    ///     are uploaded.
+    ///   </para>
+    ///   <para>
+    ///     Labels are not owned by the batch and must be removed before they
+    ///     are destroyed. Labels in a batch should not be added to the render
+    ///     queue themselves.
+    ///   </para>
+    /// </remarks>
+    class TextBatch : private NonCopyable<TextBatch>
+    {
+    public:
+        TextBatch();
+        ~TextBatch();
+
+        /// <summary>Returns whether the batch is visible.</summary>
+        [[nodiscard]] auto is_visible() const { return visible_; }
+
+        /// <summary>Returns number of labels in the batch.</summary>
+        [[nodiscard]] auto size() const { return slots_.size(); }
+
+        /// <summary>Returns the vertex array object.</summary>
+        [[nodiscard]] auto vertex_array() const -> const graphics::VertexArray&
+        {
+            return array_;
+        }
+
+        /// <summary>Returns the vertex count.</summary>
+        [[nodiscard]] auto vertex_count() const -> uint32_t
+        {
+            const auto count = narrow_cast<uint32_t>(vertices_.size());
+            return !visible_ ? 0 : count + (count >> 1);
+        }
+
+        /// <summary>Adds a label to the batch.</summary>
+        void add(Label& label);
+
+        /// <summary>Removes a label from the batch.</summary>
+        void remove(const Label& label);
+
+        /// <summary>Sets batch visibility.</summary>
+        void set_visible(bool visible) { visible_ = visible; }
+
+        /// <summary>
+        ///   Updates all labels and uploads the ones that changed.
+        /// </summary>
+        void update(GameBase&);
+
+        /// <summary>
+        ///   Updates all labels and copies the ones that changed into the
+        ///   client vertex buffer without uploading it.
+        /// </summary>
+        void update_vertices(Typesetter&);
+
+#ifdef RAINBOW_TEST
+        explicit TextBatch(const ISolemnlySwearThatIAmOnlyTesting&);
+
+        [[nodiscard]] auto vertices() const -> const std::vector<SpriteVertex>&
+        {
+            return vertices_;
+        }
+#endif
+
+    private:
+        struct Slot {
+            Label* label;
+            uint32_t offset;    ///< Index of the first vertex.
+            uint32_t capacity;  ///< Number of vertices reserved.
+            uint32_t count;     ///< Number of vertices in use.
+            bool needs_copy;
+        };
+
+        /// <summary>Labels and their ranges in the vertex buffer.</summary>
+        std::vector<Slot> slots_;
+
+        /// <summary>Client vertex buffer.</summary>
+        std::vector<SpriteVertex> vertices_;
+
+        /// <summary>Number of vertices in use by labels.</summary>
+        uint32_t used_ = 0;
+
+        /// <summary>Number of vertices allocated on the GPU.</summary>
+        uint32_t buffer_size_ = 0;
+
+        /// <summary>Range of vertices that needs to be uploaded.</summary>
+        uint32_t dirty_begin_ = 0;
+        uint32_t dirty_end_ = 0;
+
+        /// <summary>Shared, interleaved vertex buffer.</summary>
+        graphics::Buffer buffer_;
+
+        /// <summary>Vertex array object.</summary>
+        graphics::VertexArray array_;
+
+        bool visible_ = true;
+
+        void compact();
+        void copy(Slot& slot);
+        void mark_dirty(uint32_t begin, uint32_t end);
+        void release(const Slot& slot);
+        void upload();
+    };
+}  // namespace rainbow
+
+namespace rainbow::graphics
+{
+    struct Context;
+
+    void draw(Context&, const TextBatch&);
+}  // namespace rainbow::graphics
+
+#endif
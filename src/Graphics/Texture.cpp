@@ -4,21 +4,276 @@
 
 #include "Graphics/Texture.h"
 
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <optional>
+#include <utility>
+
+#include <imgui/imstb_rectpack.h>
+
 #include "Common/Logging.h"
+#include "Common/TypeCast.h"
 #include "FileSystem/File.h"
+#include "FileSystem/FileStream.h"
+#include "FileSystem/FileSystem.h"
+#include "FileSystem/MemoryMappedFile.h"
 #include "Graphics/Image.h"
+#include "Graphics/ImageCache.h"
+#include "Graphics/Mipmap.h"
 
+using rainbow::czstring;
 using rainbow::Data;
 using rainbow::File;
+using rainbow::FileStream;
 using rainbow::FileType;
 using rainbow::Image;
+using rainbow::MemoryMappedFile;
 using rainbow::Passkey;
+using rainbow::Rect;
+using rainbow::ThreadPool;
+using rainbow::graphics::Dithering;
 using rainbow::graphics::Filter;
+using rainbow::graphics::ImageCache;
 using rainbow::graphics::ITextureAllocator;
 using rainbow::graphics::Texture;
 using rainbow::graphics::TextureData;
 using rainbow::graphics::TextureProvider;
 
+namespace
+{
+    constexpr uint8_t kFallbackPixel[]{0, 0, 0, 0};  // NOLINT
+
+    // Packed images are surrounded by a border of their edge pixels so that
+    // linear filtering does not pick up their neighbours.
+    constexpr uint32_t kAtlasPadding = 1;
+
+    auto can_pack(const Image& image) -> bool
+    {
+        const bool is_decoded = image.format == Image::Format::PNG ||
+                                image.format == Image::Format::QOI ||
+                                image.format == Image::Format::SVG;
+        const bool is_supported = (image.channels == 2 && image.depth == 16) ||
+                                  (image.channels == 4 && image.depth == 32);
+        return is_decoded && is_supported && image.levels == 1 &&
+               image.data != nullptr && image.width > 0 && image.height > 0 &&
+               image.width <= TextureProvider::kAtlasMaxImageSize &&
+               image.height <= TextureProvider::kAtlasMaxImageSize;
+    }
+
+    /// <summary>
+    ///   Copies <paramref name="image"/> into an RGBA page with its top-left
+    ///   corner, including padding, at (<paramref name="x"/>,
+    ///   <paramref name="y"/>).
+    /// </summary>
+    void blit(const Image& image,
+              uint32_t x,
+              uint32_t y,
+              uint8_t* page,
+              uint32_t page_size)
+    {
+        const auto padded_width = image.width + kAtlasPadding * 2;
+        const auto padded_height = image.height + kAtlasPadding * 2;
+        for (uint32_t row = 0; row < padded_height; ++row) {
+            const auto src_row =
+                std::clamp(row, kAtlasPadding, image.height) - kAtlasPadding;
+            auto dst = page + ((size_t{y} + row) * page_size + x) * 4;
+            for (uint32_t col = 0; col < padded_width; ++col) {
+                const auto src_col =
+                    std::clamp(col, kAtlasPadding, image.width) -
+                    kAtlasPadding;
+                const auto src =
+                    image.data +
+                    (size_t{src_row} * image.width + src_col) * image.channels;
+                if (image.channels == 2) {
+                    dst[0] = src[0];
+                    dst[1] = src[0];
+                    dst[2] = src[0];
+                    dst[3] = src[1];
+                } else {
+                    memcpy(dst, src, 4);
+                }
+                dst += 4;
+            }
+        }
+    }
+
+    auto process(Image image,
+                 Filter min_filter,
+                 Image::Packing packing,
+                 Dithering dithering) -> Image
+    {
+        using rainbow::graphics::reduce_color_depth;
+
+        if (!rainbow::graphics::is_mipmap(min_filter))
+            return reduce_color_depth(std::move(image), packing, dithering);
+
+        return reduce_color_depth(
+            rainbow::graphics::generate_mipmaps(std::move(image)),
+            packing,
+            dithering);
+    }
+
+    auto decode(const Data& data,
+                float scale,
+                Filter min_filter,
+                Image::Packing packing,
+                Dithering dithering) -> Image
+    {
+        return process(
+            Image::decode(data, scale), min_filter, packing, dithering);
+    }
+
+    /// <summary>
+    ///   Maps the cached image for <paramref name="key"/> into
+    ///   <paramref name="cached"/>, which must outlive the returned image.
+    ///   Returns an empty image if there is none.
+    /// </summary>
+    auto find_cached(const ImageCache& cache,
+                     uint64_t key,
+                     float scale,
+                     MemoryMappedFile& cached) -> Image
+    {
+        cached = cache.find(key);
+        if (!cached)
+            return {};
+
+        auto image = Image::decode(
+            {cached.data(), cached.size(), Data::Ownership::Reference}, scale);
+        if (image.data != nullptr)
+            return image;
+
+        LOGW("Discarding invalid cached image: %016" PRIx64, key);
+        cached = {};
+        return {};
+    }
+
+    /// <summary>
+    ///   Decodes <paramref name="data"/>, going through the image cache if
+    ///   there is one. Cached images are mapped into
+    ///   <paramref name="cached"/>, which must outlive the returned image.
+    /// </summary>
+    auto decode(const Data& data,
+                float scale,
+                Filter min_filter,
+                Image::Packing packing,
+                Dithering dithering,
+                const ImageCache* cache,
+                MemoryMappedFile& cached) -> Image
+    {
+        if (cache == nullptr || !data || !Image::needs_decoding(data))
+            return decode(data, scale, min_filter, packing, dithering);
+
+        const bool mipmaps = rainbow::graphics::is_mipmap(min_filter);
+        const auto key =
+            ImageCache::key(data, scale, mipmaps, packing, dithering);
+        if (auto image = find_cached(*cache, key, scale, cached);
+            image.data != nullptr) {
+            return image;
+        }
+
+        auto image = decode(data, scale, min_filter, packing, dithering);
+        cache->store(key, image);
+        return image;
+    }
+
+    /// <summary>
+    ///   Reads and decodes the image at <paramref name="path"/>.
+    /// </summary>
+    /// <remarks>
+    ///   Images are decoded straight from the file if possible, so that only
+    ///   a chunk of it needs to be in memory at a time. This requires the
+    ///   cache key to be known up front, i.e. there is no cache or the image
+    ///   is in a mounted pack, which records the hash of its content.
+    ///   Otherwise, the file is read whole and returned alongside the image,
+    ///   which may reference it.
+    /// </remarks>
+    auto read_image(czstring path,
+                    float scale,
+                    Filter min_filter,
+                    Image::Packing packing,
+                    Dithering dithering,
+                    const ImageCache* cache,
+                    MemoryMappedFile& cached) -> std::pair<Data, Image>
+    {
+        std::optional<uint64_t> key;
+        if (cache != nullptr) {
+            if (const auto hash = rainbow::filesystem::content_hash(path)) {
+                const bool mipmaps = rainbow::graphics::is_mipmap(min_filter);
+                key =
+                    ImageCache::key(*hash, scale, mipmaps, packing, dithering);
+                if (auto image = find_cached(*cache, *key, scale, cached);
+                    image.data != nullptr) {
+                    return {Data{}, std::move(image)};
+                }
+            }
+        }
+
+        FileStream stream{path, FileType::Asset};
+        if (cache == nullptr || key) {
+            if (auto image = Image::decode(stream); image.data != nullptr) {
+                auto processed =
+                    process(std::move(image), min_filter, packing, dithering);
+                if (key)
+                    cache->store(*key, processed);
+                return {Data{}, std::move(processed)};
+            }
+
+            // Only images that cannot be streamed are left unread. What is
+            // left of a PNG that failed to decode is not an image.
+            if (stream.tell() > 0) {
+                LOGE("Failed to decode image: %s", path);
+                return {};
+            }
+        }
+
+        auto data = stream.read_all();
+        if (key) {
+            auto image = decode(data, scale, min_filter, packing, dithering);
+            if (Image::needs_decoding(data))
+                cache->store(*key, image);
+            return {std::move(data), std::move(image)};
+        }
+
+        auto image =
+            decode(data, scale, min_filter, packing, dithering, cache, cached);
+        return {std::move(data), std::move(image)};
+    }
+}  // namespace
+
+struct TextureProvider::AtlasPage {
+    uint32_t index = 0;
+    stbrp_context context{};
+    std::array<stbrp_node, kAtlasPageSize> nodes{};
+    std::unique_ptr<uint8_t[]> pixels;
+    bool is_dirty = false;
+
+    [[nodiscard]] auto image() const
+    {
+        constexpr size_t kSize = size_t{kAtlasPageSize} * kAtlasPageSize * 4;
+        return Image{Image::Format::RGBA,
+                     kAtlasPageSize,
+                     kAtlasPageSize,
+                     32,
+                     4,
+                     kSize,
+                     pixels.get()};
+    }
+};
+
+struct TextureProvider::DecodedTexture {
+    uint32_t index;
+    uint32_t generation;
+    uint32_t revision;
+    Data data;
+    MemoryMappedFile cached;
+    Image image;
+    Filter mag_filter;
+    Filter min_filter;
+};
+
 TextureProvider::TextureProvider(ITextureAllocator& allocator)
     : allocator_(allocator)
 {
@@ -34,9 +289,16 @@ TextureProvider::~TextureProvider()
 
     Texture::s_texture_provider = nullptr;
 
-    for (auto&& texture : texture_map_) {
-        allocator_.destroy(texture.second.data);
+    // Stop decoding before tearing down the textures it would be uploaded to.
+    thread_pool_.reset();
+
+    for (auto&& slot : slots_) {
+        if (slot.texture.use_count > 0 && !slot.texture.is_pending)
+            allocator_.destroy(slot.texture.data);
     }
+
+    if (has_fallback_)
+        allocator_.destroy(fallback_);
 }
 
 template <typename T>
@@ -46,19 +308,58 @@ auto TextureProvider::get(std::string_view path,
                           Filter mag_filter,
                           Filter min_filter) -> Texture
 {
-    auto [iter, inserted] = texture_map_.emplace(path, TextureData{});
+    constexpr bool is_file = std::is_same_v<T, std::nullptr_t> ||
+                             std::is_same_v<T, FileData>;
+    auto [index, inserted] = emplace(path, is_file);
+    auto& slot = slots_[index];
     if (inserted) {
+        if constexpr (is_file) {
+            slot.scale = scale;
+            slot.mag_filter = mag_filter;
+            slot.min_filter = min_filter;
+            slot.is_reloadable = true;
+        }
+
         if constexpr (std::is_same_v<T, std::nullptr_t>) {
-            auto file = File::read(path.data(), FileType::Asset);
-            load(iter, Image::decode(file, scale), mag_filter, min_filter);
+            MemoryMappedFile cached;
+            const auto [file, image] = read_image(path.data(),
+                                                  scale,
+                                                  min_filter,
+                                                  packing_,
+                                                  dithering_,
+                                                  image_cache_.get(),
+                                                  cached);
+            load(slot, image, mag_filter, min_filter);
+        } else if constexpr (std::is_same_v<T, FileData>) {
+            MemoryMappedFile cached;
+            load(slot,
+                 decode(data.data,
+                        scale,
+                        min_filter,
+                        packing_,
+                        dithering_,
+                        image_cache_.get(),
+                        cached),
+                 mag_filter,
+                 min_filter);
         } else if constexpr (std::is_same_v<T, const Data&>) {
-            load(iter, Image::decode(data, scale), mag_filter, min_filter);
+            MemoryMappedFile cached;
+            load(slot,
+                 decode(data,
+                        scale,
+                        min_filter,
+                        packing_,
+                        dithering_,
+                        image_cache_.get(),
+                        cached),
+                 mag_filter,
+                 min_filter);
         } else if constexpr (std::is_same_v<T, const Image&>) {
-            load(iter, data, mag_filter, min_filter);
+            load(slot, data, mag_filter, min_filter);
         }
     }
-    ++iter->second.use_count;
-    return Texture{path, Passkey<TextureProvider>{}};
+    ++slot.texture.use_count;
+    return Texture{index, slot.generation, Passkey<TextureProvider>{}};
 }
 
 auto TextureProvider::get(std::string_view path,
@@ -86,37 +387,201 @@ auto TextureProvider::get(std::string_view path,
     return get<const Image&>(path, image, 1.0F, mag_filter, min_filter);
 }
 
+auto TextureProvider::get_async(std::string_view path,
+                                float scale,
+                                Filter mag_filter,
+                                Filter min_filter) -> Texture
+{
+    auto [index, inserted] = emplace(path, true);
+    auto& slot = slots_[index];
+    if (inserted) {
+        slot.scale = scale;
+        slot.mag_filter = mag_filter;
+        slot.min_filter = min_filter;
+        slot.is_reloadable = true;
+
+        auto& texture = slot.texture;
+        texture.width = 1;
+        texture.height = 1;
+        load_async(index);
+    }
+    ++slot.texture.use_count;
+    return Texture{index, slot.generation, Passkey<TextureProvider>{}};
+}
+
+auto TextureProvider::get_packed(std::string_view path, float scale)
+    -> Texture
+{
+    auto iter = packed_images_.find(path);
+    const auto content_hash = iter == packed_images_.end()
+                                  ? filesystem::content_hash(path)
+                                  : std::nullopt;
+    if (content_hash) {
+        if (auto packed = packed_contents_.find(*content_hash);
+            packed != packed_contents_.end()) {
+            iter = packed_images_.emplace(path, packed->second).first;
+        }
+    }
+
+    if (iter != packed_images_.end()) {
+        const auto& [index, region] = iter->second;
+        auto& slot = slots_[index];
+        ++slot.texture.use_count;
+        return Texture{
+            index, slot.generation, region, Passkey<TextureProvider>{}};
+    }
+
+    if (path_map_.find(path) != path_map_.end())
+        return get(path, scale);
+
+    // Images that cannot be packed are loaded like any other file so that
+    // they can be reloaded, evicted, and cached. Hand over what was already
+    // read instead of reading the file a second time.
+    const auto data = File::read(path.data(), FileType::Asset);
+    const auto load_unpacked = [&] {
+        return get(path,
+                   FileData{data},
+                   scale,
+                   Filter::Cubic,
+                   Filter::Linear);
+    };
+    if (!Image::needs_decoding(data))
+        return load_unpacked();
+
+    const auto image = Image::decode(data, scale);
+    if (!can_pack(image))
+        return load_unpacked();
+
+    stbrp_rect rect{
+        0,
+        narrow_cast<stbrp_coord>(image.width + kAtlasPadding * 2),
+        narrow_cast<stbrp_coord>(image.height + kAtlasPadding * 2),
+        0,
+        0,
+        0};
+    auto page = std::find_if(  //
+        atlas_pages_.begin(),
+        atlas_pages_.end(),
+        [&rect](auto&& page) {
+            stbrp_pack_rects(&page->context, &rect, 1);
+            return rect.was_packed != 0;
+        });
+    auto& atlas_page = page == atlas_pages_.end() ? add_atlas_page() : **page;
+    if (rect.was_packed == 0) {
+        stbrp_pack_rects(&atlas_page.context, &rect, 1);
+        R_ASSERT(rect.was_packed != 0, "Failed to pack image");
+    }
+
+    blit(image,
+         narrow_cast<uint32_t>(rect.x),
+         narrow_cast<uint32_t>(rect.y),
+         atlas_page.pixels.get(),
+         kAtlasPageSize);
+    atlas_page.is_dirty = true;
+
+    const Rect region{narrow_cast<float>(rect.x + kAtlasPadding),
+                      narrow_cast<float>(rect.y + kAtlasPadding),
+                      narrow_cast<float>(image.width),
+                      narrow_cast<float>(image.height)};
+    packed_images_.emplace(path, PackedImage{atlas_page.index, region});
+    if (content_hash) {
+        packed_contents_.emplace(*content_hash,
+                                 PackedImage{atlas_page.index, region});
+    }
+
+    auto& slot = slots_[atlas_page.index];
+    ++slot.texture.use_count;
+    return Texture{
+        atlas_page.index, slot.generation, region, Passkey<TextureProvider>{}};
+}
+
+auto TextureProvider::is_ready(const Texture& texture) const -> bool
+{
+    auto s = slot(texture);
+    return s != nullptr && !s->texture.is_pending;
+}
+
+void TextureProvider::purge()
+{
+    evict(0);
+}
+
 auto TextureProvider::raw_get(const Texture& texture) const -> TextureData
 {
-    auto iter = texture_map_.find(texture.key());
-    return iter->second;
+    auto s = slot(texture);
+    R_ASSERT(s != nullptr, "Invalid texture handle");
+    return s->texture;
 }
 
 void TextureProvider::release(const Texture& texture)
 {
-    auto iter = texture_map_.find(texture.key());
-    if (iter == texture_map_.end()) {
+    auto s = slot(texture);
+    if (s == nullptr) {
         return;
     }
 
-    auto& texture_data = iter->second;
+    auto& texture_data = s->texture;
     if (--texture_data.use_count == 0) {
-        IF_DEVMODE(mem_used_ -= texture_data.size);
-        allocator_.destroy(texture_data.data);
-        texture_map_.erase(iter);
+        if (!texture_data.is_pending) {
+            mem_used_ -= texture_data.size;
+            allocator_.destroy(texture_data.data);
+        }
+
+        path_map_.erase(s->path);
+        if (s->content_hash) {
+            // Identical files loaded from other paths share this slot
+            content_map_.erase(*s->content_hash);
+            for (auto i = path_map_.begin(); i != path_map_.end();) {
+                if (i->second == texture.index_)
+                    path_map_.erase(i++);
+                else
+                    ++i;
+            }
+        }
+
+        const auto generation = s->generation + 1;
+        *s = TextureSlot{};
+        s->generation = generation;
+        free_slots_.push_back(texture.index_);
+    }
+}
+
+auto TextureProvider::reload(std::string_view path) -> bool
+{
+    auto iter = path_map_.find(path);
+    if (iter == path_map_.end())
+        return false;
+
+    const auto index = iter->second;
+    auto& slot = slots_[index];
+    if (!slot.is_reloadable || slot.texture.use_count == 0)
+        return false;
+
+    // Evicted textures are read from disk the next time they are drawn.
+    if (!slot.is_evicted) {
+        ++slot.revision;
+        decode_async(index);
     }
+    return true;
+}
+
+void TextureProvider::set_image_cache(std::unique_ptr<ImageCache> cache)
+{
+    R_ASSERT(slots_.empty(), "Image cache must be set before loading textures");
+
+    image_cache_ = std::move(cache);
 }
 
 auto TextureProvider::try_get(const Texture& texture)
     -> std::optional<TextureData>
 {
-    auto iter = texture_map_.find(texture.key());
-    if (iter == texture_map_.end()) {
+    auto s = slot(texture);
+    if (s == nullptr) {
         return std::nullopt;
     }
 
-    ++iter->second.use_count;
-    return std::make_optional(iter->second);
+    ++s->texture.use_count;
+    return std::make_optional(s->texture);
 }
 
 void TextureProvider::update(const Texture& texture,
@@ -124,10 +589,219 @@ void TextureProvider::update(const Texture& texture,
                              Filter mag_filter,
                              Filter min_filter)
 {
-    allocator_.update(raw_get(texture).data, image, mag_filter, min_filter);
+    auto texture_data = raw_get(texture);
+    R_ASSERT(!texture_data.is_pending, "Texture is still being loaded");
+
+    allocator_.update(texture_data.data, image, mag_filter, min_filter);
+}
+
+void TextureProvider::update()
+{
+    ++frame_;
+
+    std::vector<DecodedTexture> decoded;
+    decoded_textures_->swap(decoded);
+
+    for (auto&& texture : decoded) {
+        // The texture may have been released or reloaded while it was being
+        // decoded.
+        auto& slot = slots_[texture.index];
+        if (slot.generation != texture.generation ||
+            slot.revision != texture.revision) {
+            continue;
+        }
+
+        if (texture.image.format == Image::Format::Unknown)
+            continue;
+
+        if (slot.texture.is_pending) {
+            slot.texture.is_pending = false;
+        } else {
+            mem_used_ -= slot.texture.size;
+            allocator_.destroy(slot.texture.data);
+        }
+        load(slot, texture.image, texture.mag_filter, texture.min_filter);
+    }
+
+    for (auto&& page : atlas_pages_) {
+        if (!page->is_dirty)
+            continue;
+
+        allocator_.update(slots_[page->index].texture.data,
+                          page->image(),
+                          Filter::Linear,
+                          Filter::Linear);
+        page->is_dirty = false;
+    }
+
+    if (memory_budget_ > 0 && mem_used_ > memory_budget_)
+        evict(memory_budget_);
+}
+
+auto TextureProvider::use(const Texture& texture) -> const TextureHandle&
+{
+    auto s = slot(texture);
+    R_ASSERT(s != nullptr, "Invalid texture handle");
+
+    s->last_used = frame_;
+    if (s->is_evicted) {
+        s->is_evicted = false;
+        load_async(texture.index_);
+    }
+    return s->texture.data;
+}
+
+auto TextureProvider::add_atlas_page() -> AtlasPage&
+{
+    auto page = std::make_unique<AtlasPage>();
+    stbrp_init_target(&page->context,
+                      kAtlasPageSize,
+                      kAtlasPageSize,
+                      page->nodes.data(),
+                      narrow_cast<int>(page->nodes.size()));
+    page->pixels = std::make_unique<uint8_t[]>(page->image().size);
+
+    char path[32];
+    std::snprintf(
+        path, sizeof(path), "rainbow://atlas/%zu", atlas_pages_.size());
+
+    auto [index, inserted] = emplace(path);
+    R_ASSERT(inserted, "Atlas page already exists");
+
+    auto& slot = slots_[index];
+    load(slot, page->image(), Filter::Linear, Filter::Linear);
+    ++slot.texture.use_count;
+
+    page->index = index;
+    return *atlas_pages_.emplace_back(std::move(page));
+}
+
+void TextureProvider::decode_async(uint32_t index)
+{
+    if (!thread_pool_)
+        thread_pool_ = std::make_unique<ThreadPool>();
+
+    const auto& slot = slots_[index];
+    thread_pool_->post([this,
+                        index,
+                        generation = slot.generation,
+                        revision = slot.revision,
+                        path = slot.path,
+                        scale = slot.scale,
+                        mag_filter = slot.mag_filter,
+                        min_filter = slot.min_filter,
+                        packing = packing_,
+                        dithering = dithering_] {
+        MemoryMappedFile cached;
+        auto [data, image] = read_image(path.c_str(),
+                                        scale,
+                                        min_filter,
+                                        packing,
+                                        dithering,
+                                        image_cache_.get(),
+                                        cached);
+        if (image.format == Image::Format::Unknown)
+            LOGE("Failed to load texture: %s", path.c_str());
+
+        decoded_textures_->push_back({index,
+                                      generation,
+                                      revision,
+                                      std::move(data),
+                                      std::move(cached),
+                                      std::move(image),
+                                      mag_filter,
+                                      min_filter});
+    });
+}
+
+auto TextureProvider::emplace(std::string_view path, bool is_file)
+    -> std::pair<uint32_t, bool>
+{
+    if (auto iter = path_map_.find(path); iter != path_map_.end())
+        return {iter->second, false};
+
+    const auto content_hash =
+        is_file ? filesystem::content_hash(path) : std::nullopt;
+    if (content_hash) {
+        if (auto iter = content_map_.find(*content_hash);
+            iter != content_map_.end()) {
+            path_map_.emplace(path, iter->second);
+            return {iter->second, false};
+        }
+    }
+
+    uint32_t index;
+    if (free_slots_.empty()) {
+        index = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    } else {
+        index = free_slots_.back();
+        free_slots_.pop_back();
+    }
+
+    auto& slot = slots_[index];
+    slot.path = path;
+    slot.last_used = frame_;
+    slot.content_hash = content_hash;
+    path_map_.emplace(path, index);
+    if (content_hash)
+        content_map_.emplace(*content_hash, index);
+    return {index, true};
+}
+
+void TextureProvider::evict(size_t target)
+{
+    std::vector<uint32_t> candidates;
+    for (uint32_t i = 0; i < slots_.size(); ++i) {
+        // Textures drawn in the previous frame are likely to be drawn again.
+        const auto& slot = slots_[i];
+        if (slot.is_reloadable && !slot.texture.is_pending &&
+            slot.texture.use_count > 0 && slot.last_used + 1 < frame_) {
+            candidates.push_back(i);
+        }
+    }
+
+    std::sort(candidates.begin(),
+              candidates.end(),
+              [this](uint32_t lhs, uint32_t rhs) {
+                  return slots_[lhs].last_used < slots_[rhs].last_used;
+              });
+
+    for (auto i : candidates) {
+        if (mem_used_ <= target)
+            break;
+
+        auto& texture = slots_[i].texture;
+        mem_used_ -= texture.size;
+        allocator_.destroy(texture.data);
+        texture.data = fallback();
+        texture.size = 0;
+        texture.is_pending = true;
+        slots_[i].is_evicted = true;
+
+        // Discard any reload that is still being decoded.
+        ++slots_[i].revision;
+    }
+}
+
+auto TextureProvider::fallback() -> const TextureHandle&
+{
+    if (!has_fallback_) {
+        const Image fallback{Image::Format::RGBA,
+                             1,
+                             1,
+                             32,
+                             4,
+                             sizeof(kFallbackPixel),
+                             kFallbackPixel};
+        allocator_.construct(
+            fallback_, fallback, Filter::Nearest, Filter::Nearest);
+        has_fallback_ = true;
+    }
+    return fallback_;
 }
 
-void TextureProvider::load(TextureMap::iterator i,
+void TextureProvider::load(TextureSlot& slot,
                            const Image& image,
                            Filter mag_filter,
                            Filter min_filter)
@@ -135,20 +809,70 @@ void TextureProvider::load(TextureMap::iterator i,
     R_ASSERT(allocator_.max_size() <= sizeof(TextureData::data),
              "Texture data size is too small for the current graphics API.");
 
-    auto& texture = i->second;
+    auto& texture = slot.texture;
     allocator_.construct(texture.data, image, mag_filter, min_filter);
     texture.width = image.width;
     texture.height = image.height;
 
-    IF_DEVMODE(texture.size = image.size);
-    IF_DEVMODE(record_usage(image.size));
+    texture.size = static_cast<uint32_t>(image.size);
+    record_usage(image.size);
+
+    // Textures that have just been loaded are likely to be drawn soon, e.g.
+    // when preloading the next scene.
+    slot.last_used = frame_;
+}
+
+void TextureProvider::load_async(uint32_t index)
+{
+    auto& slot = slots_[index];
+    slot.texture.data = fallback();
+    slot.texture.is_pending = true;
+    decode_async(index);
+}
+
+void TextureProvider::retain(const Texture& texture)
+{
+    auto s = slot(texture);
+    R_ASSERT(s != nullptr, "Invalid texture handle");
+    ++s->texture.use_count;
+}
+
+auto TextureProvider::slot(const Texture& texture) -> TextureSlot*
+{
+    return const_cast<TextureSlot*>(std::as_const(*this).slot(texture));
+}
+
+auto TextureProvider::slot(const Texture& texture) const -> const TextureSlot*
+{
+    if (texture.index_ >= slots_.size())
+        return nullptr;
+
+    auto& s = slots_[texture.index_];
+    return s.generation == texture.generation_ ? &s : nullptr;
 }
 
 TextureProvider* Texture::s_texture_provider = nullptr;
 
+auto Texture::is_ready() const -> bool
+{
+    return s_texture_provider->is_ready(*this);
+}
+
+auto Texture::region() const -> Rect
+{
+    if (region_.width > 0.0F)
+        return region_;
+
+    const auto texture = s_texture_provider->raw_get(*this);
+    return {0.0F,
+            0.0F,
+            static_cast<float>(texture.width),
+            static_cast<float>(texture.height)};
+}
+
 Texture::~Texture()
 {
-    if (key_.empty()) {
+    if (!*this) {
         return;
     }
 
@@ -161,21 +885,28 @@ auto Texture::operator=(const Texture& texture) -> Texture&
         return *this;
     }
 
-    if (!key_.empty()) {
+    if (*this) {
         s_texture_provider->release(*this);
     }
 
-    auto handle = s_texture_provider->get(texture.key());
-    key_ = std::move(handle.key_);
+    index_ = texture.index_;
+    generation_ = texture.generation_;
+    region_ = texture.region_;
+    if (*this) {
+        s_texture_provider->retain(*this);
+    }
     return *this;
 }
 
 auto Texture::operator=(Texture&& texture) noexcept -> Texture&
 {
-    if (!key_.empty()) {
+    if (*this) {
         s_texture_provider->release(*this);
     }
 
-    key_ = std::move(texture.key_);
+    index_ = texture.index_;
+    generation_ = texture.generation_;
+    region_ = texture.region_;
+    texture.index_ = kInvalidIndex;
     return *this;
 }
@@ -6,47 +6,81 @@
 #define GRAPHICS_TEXTURE_H_
 
 #include <array>
+#include <limits>
+#include <memory>
 #include <optional>
 #include <string>
+#include <tuple>
+#include <vector>
+
+#include "ThirdParty/DisableWarnings.h"
+#include <absl/container/flat_hash_map.h>  // NOLINT(llvm-include-order)
+#include "ThirdParty/ReenableWarnings.h"
 
 #include "Common/NonCopyable.h"
 #include "Common/Passkey.h"
-#include "Memory/ArrayMap.h"
+#include "Graphics/ColorDepth.h"
+#include "Math/Geometry.h"
+#include "Threading/Synchronized.h"
+#include "Threading/ThreadPool.h"
 
 namespace rainbow
 {
     class Data;
-    struct Image;
     struct ISolemnlySwearThatIAmOnlyTesting;
 }  // namespace rainbow
 
 namespace rainbow::graphics
 {
     struct Context;
+    class ImageCache;
     struct ITextureAllocator;
     class Texture;
 
     using TextureHandle = std::array<intptr_t, 4>;
 
+    /// <summary>Texture sampling filter.</summary>
+    /// <remarks>
+    ///   Mipmap filters are only valid as minification filters. When one is
+    ///   used, a mipmap chain is generated when the texture is decoded.
+    /// </remarks>
     enum class Filter {
         Nearest,
         Linear,
         Cubic,
+        NearestMipmapNearest,
+        LinearMipmapNearest,
+        LinearMipmapLinear,
     };
 
+    constexpr auto is_mipmap(Filter filter)
+    {
+        return filter == Filter::NearestMipmapNearest ||
+               filter == Filter::LinearMipmapNearest ||
+               filter == Filter::LinearMipmapLinear;
+    }
+
     struct TextureData {
         TextureHandle data{};
         uint32_t width = 0;
         uint32_t height = 0;
         uint32_t use_count = 0;
-#ifdef USE_HEIMDALL
         uint32_t size = 0;
-#endif
+        bool is_pending = false;
     };
 
     class TextureProvider : private NonCopyable<TextureProvider>
     {
     public:
+        /// <summary>Width and height of atlas pages, in pixels.</summary>
+        static constexpr uint32_t kAtlasPageSize = 1024;
+
+        /// <summary>
+        ///   Largest width or height of images that are packed into atlas
+        ///   pages; larger images get their own texture.
+        /// </summary>
+        static constexpr uint32_t kAtlasMaxImageSize = 256;
+
         explicit TextureProvider(ITextureAllocator&);
         ~TextureProvider();
 
@@ -66,10 +100,99 @@ namespace rainbow::graphics
                                Filter mag_filter = Filter::Cubic,
                                Filter min_filter = Filter::Linear) -> Texture;
 
+        /// <summary>
+        ///   Returns a texture immediately, and loads it in the background.
+        ///   Until the texture is ready, a transparent 1x1 texture is bound in
+        ///   its place.
+        /// </summary>
+        /// <remarks>
+        ///   Reading and decoding happen on a thread pool. The upload happens
+        ///   on the next call to <see cref="update()"/>.
+        /// </remarks>
+        [[nodiscard]] auto get_async(std::string_view path,
+                                     float scale = 1.0F,
+                                     Filter mag_filter = Filter::Cubic,
+                                     Filter min_filter = Filter::Linear)
+            -> Texture;
+
+        /// <summary>
+        ///   Returns a texture whose <see cref="Texture::region"/> is where
+        ///   the image was packed into a shared atlas page, so that images
+        ///   loaded separately can still be drawn in the same batch.
+        /// </summary>
+        /// <remarks>
+        ///   Only decoded 8-bit LA and RGBA images that fit within
+        ///   <see cref="kAtlasMaxImageSize"/> are packed; anything else is
+        ///   returned as a texture of its own. Pages are never repacked, so
+        ///   packed images stay resident until the provider is destroyed.
+        ///   Changes to pages are uploaded on the next call to
+        ///   <see cref="update()"/>.
+        /// </remarks>
+        [[nodiscard]] auto get_packed(std::string_view path,
+                                      float scale = 1.0F) -> Texture;
+
+        /// <summary>Returns whether the texture has been uploaded.</summary>
+        [[nodiscard]] auto is_ready(const Texture&) const -> bool;
+
+        /// <summary>
+        ///   Returns current and peak texture memory usage, in bytes.
+        /// </summary>
+        [[nodiscard]] auto memory_usage() const
+        {
+            return std::make_tuple(mem_used_, mem_peak_);
+        }
+
+        /// <summary>
+        ///   Evicts all textures that were not drawn in the previous frame,
+        ///   and that can be reloaded from disk.
+        /// </summary>
+        void purge();
+
         [[nodiscard]] auto raw_get(const Texture&) const -> TextureData;
 
         void release(const Texture&);
 
+        /// <summary>
+        ///   Reads the texture at <paramref name="path"/> from disk again, if
+        ///   it is loaded. The current texture stays bound until the new one
+        ///   is uploaded by <see cref="update()"/>, and is kept if decoding
+        ///   fails.
+        /// </summary>
+        /// <remarks>
+        ///   Only textures loaded by path can be reloaded; images packed into
+        ///   atlas pages are not.
+        /// </remarks>
+        /// <returns>
+        ///   <c>true</c> if a texture was scheduled for reloading.
+        /// </returns>
+        auto reload(std::string_view path) -> bool;
+
+        /// <summary>
+        ///   Sets whether decoded RGBA textures are packed into 16 bits, and
+        ///   how they are dithered, to halve their memory usage. Only applies
+        ///   to textures that are loaded after this call.
+        /// </summary>
+        void set_color_depth(Image::Packing packing, Dithering dithering)
+        {
+            packing_ = packing;
+            dithering_ = dithering;
+        }
+
+        /// <summary>
+        ///   Sets the cache that decoded PNG, QOI and SVG textures are stored
+        ///   in, and mapped from the next time they are loaded. Must be set
+        ///   before any textures are loaded.
+        /// </summary>
+        void set_image_cache(std::unique_ptr<ImageCache>);
+
+        /// <summary>
+        ///   Sets the amount of texture memory to stay within, in bytes. When
+        ///   over budget, the least recently drawn textures are evicted, and
+        ///   transparently reloaded the next time they are drawn. 0 means no
+        ///   limit.
+        /// </summary>
+        void set_memory_budget(size_t budget) { memory_budget_ = budget; }
+
         [[nodiscard]] auto try_get(const Texture&)
             -> std::optional<TextureData>;
 
@@ -78,11 +201,101 @@ namespace rainbow::graphics
                     Filter mag_filter = Filter::Cubic,
                     Filter min_filter = Filter::Linear);
 
+        /// <summary>
+        ///   Uploads textures that have finished decoding in the background,
+        ///   and evicts textures if over budget. Must be called on the render
+        ///   thread once per frame.
+        /// </summary>
+        void update();
+
+        /// <summary>
+        ///   Returns the handle to bind for the texture, and marks it as drawn
+        ///   this frame. Evicted textures are scheduled for reloading.
+        /// </summary>
+        [[nodiscard]] auto use(const Texture&) -> const TextureHandle&;
+
     private:
-        using TextureMap = ArrayMap<std::string, TextureData>;
+        struct AtlasPage;
+        struct DecodedTexture;
+
+        struct PackedImage {
+            uint32_t index;
+            Rect region;
+        };
+
+        struct TextureSlot {
+            TextureData texture;
+            std::string path;
+            uint32_t generation = 0;
+
+            /// <summary>
+            ///   Incremented every time the texture is reloaded, so that
+            ///   decodes that were started earlier are discarded.
+            /// </summary>
+            uint32_t revision = 0;
+
+            /// <summary>Frame the texture was last drawn or loaded.</summary>
+            uint64_t last_used = 0;
+
+            // Parameters needed to reload the texture after eviction.
+            float scale = 1.0F;
+            Filter mag_filter = Filter::Cubic;
+            Filter min_filter = Filter::Linear;
+            bool is_reloadable = false;
+            bool is_evicted = false;
+
+            /// <summary>
+            ///   Hash of the file's contents, if it is known. See
+            ///   <see cref="filesystem::content_hash"/>.
+            /// </summary>
+            std::optional<uint64_t> content_hash;
+        };
+
+        /// <summary>Dense table of textures, indexed by handle.</summary>
+        std::vector<TextureSlot> slots_;
+
+        /// <summary>Indices of unused slots in <c>slots_</c>.</summary>
+        std::vector<uint32_t> free_slots_;
+
+        /// <summary>Path to slot index; only used when loading.</summary>
+        absl::flat_hash_map<std::string, uint32_t> path_map_;
+
+        /// <summary>
+        ///   Content hash to slot index, so that identical files loaded from
+        ///   different paths share a texture.
+        /// </summary>
+        absl::flat_hash_map<uint64_t, uint32_t> content_map_;
+
+        /// <summary>Pages that images are packed into.</summary>
+        std::vector<std::unique_ptr<AtlasPage>> atlas_pages_;
+
+        /// <summary>Path to page and region of packed images.</summary>
+        absl::flat_hash_map<std::string, PackedImage> packed_images_;
+
+        /// <summary>Content hash to page and region of packed images.</summary>
+        absl::flat_hash_map<uint64_t, PackedImage> packed_contents_;
 
-        TextureMap texture_map_;
         ITextureAllocator& allocator_;
+        TextureHandle fallback_{};
+        bool has_fallback_ = false;
+        uint64_t frame_ = 0;
+        size_t memory_budget_ = 0;
+        size_t mem_used_ = 0;
+        size_t mem_peak_ = 0;
+        Image::Packing packing_ = Image::Packing::None;
+        Dithering dithering_ = Dithering::None;
+        Synchronized<std::vector<DecodedTexture>> decoded_textures_;
+        std::unique_ptr<ImageCache> image_cache_;
+        std::unique_ptr<ThreadPool> thread_pool_;
+
+        /// <summary>
+        ///   Contents of the file at the requested path, already read by the
+        ///   caller. Textures loaded from it are reloadable.
+        /// </summary>
+        struct FileData
+        {
+            const Data& data;
+        };
 
         template <typename T>
         auto get(std::string_view path,
@@ -91,21 +304,48 @@ namespace rainbow::graphics
                  Filter mag_filter,
                  Filter min_filter) -> Texture;
 
-        void load(TextureMap::iterator i,
+        /// <summary>
+        ///   Creates an empty atlas page. The atlas holds a reference to it
+        ///   until the provider is destroyed.
+        /// </summary>
+        auto add_atlas_page() -> AtlasPage&;
+
+        /// <summary>
+        ///   Queues reading and decoding of the slot's file on the thread
+        ///   pool. The result is picked up by <see cref="update()"/>.
+        /// </summary>
+        void decode_async(uint32_t index);
+
+        /// <summary>
+        ///   Returns the slot index for <paramref name="path"/>, and whether
+        ///   it was newly allocated. If <paramref name="is_file"/>, the slot
+        ///   of a file with identical contents is returned if there is one.
+        /// </summary>
+        auto emplace(std::string_view path, bool is_file = false)
+            -> std::pair<uint32_t, bool>;
+
+        /// <summary>
+        ///   Evicts the least recently drawn textures until memory usage is
+        ///   at or below <paramref name="target"/>.
+        /// </summary>
+        void evict(size_t target);
+
+        /// <summary>
+        ///   Returns the transparent 1x1 texture used in place of textures
+        ///   that are not loaded.
+        /// </summary>
+        [[nodiscard]] auto fallback() -> const TextureHandle&;
+
+        void load(TextureSlot&,
                   const Image&,
                   Filter mag_filter,
                   Filter min_filter);
 
-#ifdef USE_HEIMDALL
-    public:
-        [[nodiscard]] auto memory_usage() const
-        {
-            return std::make_tuple(mem_used_, mem_peak_);
-        }
-
-    private:
-        size_t mem_used_ = 0;
-        size_t mem_peak_ = 0;
+        /// <summary>
+        ///   Points the slot at the fallback texture, and queues reading and
+        ///   decoding of its file on the thread pool.
+        /// </summary>
+        void load_async(uint32_t index);
 
         void record_usage(size_t image_size)
         {
@@ -113,7 +353,13 @@ namespace rainbow::graphics
             if (mem_used_ > mem_peak_)
                 mem_peak_ = mem_used_;
         }
-#endif
+
+        void retain(const Texture&);
+
+        [[nodiscard]] auto slot(const Texture&) -> TextureSlot*;
+        [[nodiscard]] auto slot(const Texture&) const -> const TextureSlot*;
+
+        friend Texture;
     };
 
     class Texture
@@ -121,28 +367,71 @@ namespace rainbow::graphics
     public:
         Texture() = default;
         Texture(const Texture&) = delete;
-        Texture(Texture&& texture) noexcept : key_(std::move(texture.key_)) {}
-        Texture(std::string_view key, Passkey<TextureProvider>) : key_(key) {}
+
+        Texture(Texture&& texture) noexcept
+            : index_(texture.index_), generation_(texture.generation_),
+              region_(texture.region_)
+        {
+            texture.index_ = kInvalidIndex;
+        }
+
+        Texture(uint32_t index, uint32_t generation, Passkey<TextureProvider>)
+            : index_(index), generation_(generation)
+        {
+        }
+
+        Texture(uint32_t index,
+                uint32_t generation,
+                const Rect& region,
+                Passkey<TextureProvider>)
+            : index_(index), generation_(generation), region_(region)
+        {
+        }
+
         ~Texture();
 
-        [[nodiscard]] auto key() const { return std::string_view{key_}; }
+        [[nodiscard]] auto is_ready() const -> bool;
+
+        /// <summary>
+        ///   Returns the area of the texture that this handle refers to, in
+        ///   pixels, for use with <see cref="Sprite::texture"/>. This is the
+        ///   whole texture unless the image was packed into an atlas page.
+        /// </summary>
+        [[nodiscard]] auto region() const -> Rect;
 
         auto operator=(const Texture&) -> Texture&;
         auto operator=(Texture&&) noexcept -> Texture&;
 
-        explicit operator bool() const { return !key_.empty(); }
+        explicit operator bool() const { return index_ != kInvalidIndex; }
 
 #ifdef RAINBOW_TEST
-        Texture(std::string_view key, const ISolemnlySwearThatIAmOnlyTesting&)
-            : key_(key)
+        Texture(uint32_t index,
+                uint32_t generation,
+                const ISolemnlySwearThatIAmOnlyTesting&)
+            : index_(index), generation_(generation)
         {
         }
 #endif  // RAINBOW_TEST
 
     private:
+        static constexpr uint32_t kInvalidIndex =
+            std::numeric_limits<uint32_t>::max();
+
         static TextureProvider* s_texture_provider;
 
-        std::string key_;
+        /// <summary>Index into the provider's texture table.</summary>
+        uint32_t index_ = kInvalidIndex;
+
+        /// <summary>
+        ///   Generation of the slot at the time this handle was created.
+        ///   Used to detect handles to textures that have been released.
+        /// </summary>
+        uint32_t generation_ = 0;
+
+        /// <summary>
+        ///   Area of an atlas page; empty if the texture is not packed.
+        /// </summary>
+        Rect region_;
 
         friend TextureProvider;
     };
@@ -164,7 +453,7 @@ namespace rainbow::graphics
                             Filter min_filter) = 0;
     };
 
-    void bind(const Context&, const Texture&, uint32_t unit = 0);
+    void bind(Context&, const Texture&, uint32_t unit = 0);
 }  // namespace rainbow::graphics
 
 #endif
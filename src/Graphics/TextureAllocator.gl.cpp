@@ -4,6 +4,7 @@
 
 #include "Graphics/TextureAllocator.gl.h"
 
+#include <algorithm>
 #include <tuple>
 
 #include "Common/Logging.h"
@@ -31,6 +32,13 @@
 #ifndef GL_OES_compressed_ETC1_RGB8_texture
 #    define GL_ETC1_RGB8_OES 0x8D64
 #endif
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#    define GL_COMPRESSED_RGB8_ETC2 0x9274
+#    define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+#ifndef GL_RGB565
+#    define GL_RGB565 0x8D62
+#endif
 
 #define kInvalidColorDepth "Invalid colour depth"
 
@@ -41,6 +49,25 @@ using rainbow::graphics::gl::TextureAllocator;
 
 namespace
 {
+#ifdef GL_TEXTURE_MAX_LEVEL
+    // Initial value of GL_TEXTURE_MAX_LEVEL
+    constexpr GLint kDefaultMaxLevel = 1000;
+#else
+    /// <summary>
+    ///   Returns the number of levels in a full mipmap chain for
+    ///   <paramref name="image"/>, i.e. down to 1x1.
+    /// </summary>
+    auto mipmap_levels(const Image& image)
+    {
+        uint32_t levels = 1;
+        for (auto size = std::max(image.width, image.height); size > 1;
+             size >>= 1) {
+            ++levels;
+        }
+        return levels;
+    }
+#endif
+
     constexpr auto texture_filter(Filter filter) -> int
     {
         switch (filter) {
@@ -51,6 +78,31 @@ namespace
                 [[fallthrough]];
             case Filter::Cubic:
                 return GL_LINEAR;
+
+            case Filter::NearestMipmapNearest:
+                return GL_NEAREST_MIPMAP_NEAREST;
+
+            case Filter::LinearMipmapNearest:
+                return GL_LINEAR_MIPMAP_NEAREST;
+
+            case Filter::LinearMipmapLinear:
+                return GL_LINEAR_MIPMAP_LINEAR;
+        }
+
+        std::abort();
+    }
+
+    constexpr auto pixel_type(Image::Packing packing) -> GLenum
+    {
+        switch (packing) {
+            case Image::Packing::None:
+                return GL_UNSIGNED_BYTE;
+            case Image::Packing::RGBA4444:
+                return GL_UNSIGNED_SHORT_4_4_4_4;
+            case Image::Packing::RGB565:
+                return GL_UNSIGNED_SHORT_5_6_5;
+            case Image::Packing::RGBA5551:
+                return GL_UNSIGNED_SHORT_5_5_5_1;
         }
 
         std::abort();
@@ -58,6 +110,17 @@ namespace
 
     auto texture_format(const Image& image) -> std::tuple<GLenum, GLenum>
     {
+        switch (image.packing) {
+            case Image::Packing::None:
+                break;
+            case Image::Packing::RGBA4444:
+                return std::make_tuple(GL_RGBA4, GL_RGBA);
+            case Image::Packing::RGB565:
+                return std::make_tuple(GL_RGB565, GL_RGB);
+            case Image::Packing::RGBA5551:
+                return std::make_tuple(GL_RGB5_A1, GL_RGBA);
+        }
+
         switch (image.format) {
             case Image::Format::Unknown:
                 R_ASSERT(false, "Unknown image format");
@@ -86,6 +149,12 @@ namespace
             case Image::Format::ETC1:
                 return std::make_tuple(GL_ETC1_RGB8_OES, GL_NONE);
 
+            case Image::Format::ETC2:
+                return std::make_tuple(image.channels == 3
+                                           ? GL_COMPRESSED_RGB8_ETC2
+                                           : GL_COMPRESSED_RGBA8_ETC2_EAC,
+                                       GL_NONE);
+
             case Image::Format::PVRTC:
                 R_ASSERT(image.depth == 2 || image.depth == 4,  //
                          kInvalidColorDepth);
@@ -101,10 +170,15 @@ namespace
                     GL_NONE);
 
             case Image::Format::RGBA:
-                return std::make_tuple(GL_RGBA, GL_RGBA);
+                return image.channels == 2
+                           ? std::make_tuple(GL_LUMINANCE_ALPHA,
+                                             GL_LUMINANCE_ALPHA)
+                           : std::make_tuple(GL_RGBA, GL_RGBA);
 
             case Image::Format::PNG:
                 [[fallthrough]];
+            case Image::Format::QOI:
+                [[fallthrough]];
             case Image::Format::SVG:
                 switch (image.channels) {
                     case 1:
@@ -117,16 +191,12 @@ namespace
                             GL_LUMINANCE_ALPHA, GL_LUMINANCE_ALPHA);
 
                     case 3:
-                        R_ASSERT(image.depth == 16 || image.depth == 24,  //
-                                 kInvalidColorDepth);
-                        return std::make_tuple(
-                            image.depth == 16 ? GL_RGBA4 : GL_RGBA8, GL_RGB);
+                        R_ASSERT(image.depth == 24, kInvalidColorDepth);
+                        return std::make_tuple(GL_RGB8, GL_RGB);
 
                     case 4:
-                        R_ASSERT(image.depth == 16 || image.depth == 32,  //
-                                 kInvalidColorDepth);
-                        return std::make_tuple(
-                            image.depth == 16 ? GL_RGBA4 : GL_RGBA8, GL_RGBA);
+                        R_ASSERT(image.depth == 32, kInvalidColorDepth);
+                        return std::make_tuple(GL_RGBA8, GL_RGBA);
 
                     default:
                         R_ASSERT(false, "Unknown image format");
@@ -188,6 +258,25 @@ void TextureAllocator::update(const TextureHandle& handle,
                               Filter mag_filter,
                               Filter min_filter)
 {
+    R_ASSERT(!is_mipmap(mag_filter), "Mipmaps are not used for magnification");
+
+    const bool is_compressed = image.format != Image::Format::PNG &&
+                               image.format != Image::Format::QOI &&
+                               image.format != Image::Format::RGBA &&
+                               image.format != Image::Format::SVG;
+    if (is_compressed && image.levels == 1 && is_mipmap(min_filter)) {
+        // Mipmaps cannot be generated for compressed textures
+        min_filter = Filter::Linear;
+    }
+#ifndef GL_TEXTURE_MAX_LEVEL
+    if (image.levels > 1 && image.levels < mipmap_levels(image) &&
+        is_mipmap(min_filter)) {
+        // Textures with partial mipmap chains are incomplete, and sample
+        // black, unless the number of levels can be set.
+        min_filter = Filter::Linear;
+    }
+#endif
+
     ::bind(handle, 0);
     glTexParameteri(
         GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, texture_filter(min_filter));
@@ -195,6 +284,14 @@ void TextureAllocator::update(const TextureHandle& handle,
         GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, texture_filter(mag_filter));
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+#ifdef GL_TEXTURE_MAX_LEVEL
+    // Mipmap chains may stop short of 1x1. Handles can also be reused for
+    // images with a different number of levels, so this is always reset.
+    glTexParameteri(GL_TEXTURE_2D,
+                    GL_TEXTURE_MAX_LEVEL,
+                    image.levels > 1 ? narrow_cast<GLint>(image.levels - 1)
+                                     : kDefaultMaxLevel);
+#endif
 
     auto [internal_format, format] = texture_format(image);
     switch (image.format) {
@@ -211,43 +308,84 @@ void TextureAllocator::update(const TextureHandle& handle,
             [[fallthrough]];
         case Image::Format::ETC1:
             [[fallthrough]];
+        case Image::Format::ETC2:
+            [[fallthrough]];
         case Image::Format::PVRTC:
-            glCompressedTexImage2D(  //
-                GL_TEXTURE_2D,
-                0,
-                internal_format,
-                narrow_cast<GLsizei>(image.width),
-                narrow_cast<GLsizei>(image.height),
-                0,
-                narrow_cast<GLsizei>(image.size),
-                image.data);
+            for (uint32_t level = 0; level < image.levels; ++level) {
+                const auto& mipmap = image.mipmaps[level];
+                glCompressedTexImage2D(  //
+                    GL_TEXTURE_2D,
+                    narrow_cast<GLint>(level),
+                    internal_format,
+                    narrow_cast<GLsizei>(std::max(image.width >> level, 1U)),
+                    narrow_cast<GLsizei>(std::max(image.height >> level, 1U)),
+                    0,
+                    narrow_cast<GLsizei>(
+                        image.levels == 1 ? image.size : mipmap.size),
+                    image.data + mipmap.offset);
+            }
             break;
 
         case Image::Format::PNG:
             [[fallthrough]];
+        case Image::Format::QOI:
+            [[fallthrough]];
         case Image::Format::RGBA:
             [[fallthrough]];
-        case Image::Format::SVG:
-            glTexImage2D(  //
-                GL_TEXTURE_2D,
-                0,
-                internal_format,
-                narrow_cast<GLsizei>(image.width),
-                narrow_cast<GLsizei>(image.height),
-                0,
-                format,
-                GL_UNSIGNED_BYTE,
-                image.data);
+        case Image::Format::SVG: {
+            const auto type = pixel_type(image.packing);
+            if (image.levels == 1) {
+                // Rows of 16-bit and LA images may not be 4-byte aligned
+                const bool is_aligned =
+                    (image.width * image.depth / 8) % 4 == 0;
+                if (!is_aligned)
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+                glTexImage2D(  //
+                    GL_TEXTURE_2D,
+                    0,
+                    internal_format,
+                    narrow_cast<GLsizei>(image.width),
+                    narrow_cast<GLsizei>(image.height),
+                    0,
+                    format,
+                    type,
+                    image.data);
+                if (is_mipmap(min_filter))
+                    glGenerateMipmap(GL_TEXTURE_2D);
+
+                if (!is_aligned)
+                    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+                break;
+            }
+
+            // Smaller levels may have rows that are not 4-byte aligned
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+            for (uint32_t level = 0; level < image.levels; ++level) {
+                glTexImage2D(  //
+                    GL_TEXTURE_2D,
+                    narrow_cast<GLint>(level),
+                    internal_format,
+                    narrow_cast<GLsizei>(std::max(image.width >> level, 1U)),
+                    narrow_cast<GLsizei>(std::max(image.height >> level, 1U)),
+                    0,
+                    format,
+                    type,
+                    image.data + image.mipmaps[level].offset);
+            }
+
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
             break;
+        }
     }
 
     R_ASSERT(glGetError() == GL_NO_ERROR, "Failed to upload texture");
 }
 
-void rainbow::graphics::bind(const Context& ctx,
+void rainbow::graphics::bind(Context& ctx,
                              const Texture& texture,
                              uint32_t unit)
 {
-    auto texture_data = ctx.texture_provider.raw_get(texture);
-    ::bind(texture_data.data, unit);
+    ::bind(ctx.texture_provider.use(texture), unit);
 }
@@ -14,6 +14,13 @@
 #    include <future>
 
 #    include <Windows.h>
+#elif defined(RAINBOW_OS_LINUX)
+#    include <string>
+#    include <thread>
+
+#    include "ThirdParty/DisableWarnings.h"
+#    include <absl/container/flat_hash_map.h>  // NOLINT(llvm-include-order)
+#    include "ThirdParty/ReenableWarnings.h"
 #endif
 
 #include "Common/NonCopyable.h"
@@ -24,14 +31,19 @@ namespace heimdall
     class ChangeMonitor : private rainbow::NonCopyable<ChangeMonitor>
     {
     public:
-        explicit ChangeMonitor(rainbow::czstring directory);
-        ~ChangeMonitor();
+        using Callback = std::function<void(rainbow::czstring)>;
 
-        template <typename F>
-        void set_callback(F&& callback)
-        {
-            callback_ = std::move(callback);
-        }
+        /// <summary>
+        ///   Starts monitoring <paramref name="directory"/> and its
+        ///   subdirectories for modified files.
+        /// </summary>
+        /// <remarks>
+        ///   <paramref name="callback"/> may be called from another thread.
+        ///   It is passed in here rather than set later, as monitoring may
+        ///   start before the constructor returns.
+        /// </remarks>
+        ChangeMonitor(rainbow::czstring directory, Callback callback);
+        ~ChangeMonitor();
 
         void on_modified(rainbow::czstring path) { callback_(path); }
 
@@ -43,8 +55,33 @@ namespace heimdall
         bool monitoring_;
         HANDLE hDirectory_;
         std::future<void> worker_;
+#elif defined(RAINBOW_OS_LINUX)
+        int fd_;
+        int wake_fd_;
+        std::string directory_;
+
+        /// <summary>
+        ///   Watched directories, relative to <c>directory_</c>, by watch
+        ///   descriptor. inotify is not recursive, so every subdirectory
+        ///   needs its own watch.
+        /// </summary>
+        absl::flat_hash_map<int, std::string> directories_;
+
+        std::thread worker_;
+#endif
+        Callback callback_;
+
+#if defined(RAINBOW_OS_LINUX)
+        /// <summary>
+        ///   Watches <paramref name="path"/> and its subdirectories. If
+        ///   <paramref name="report_files"/> is set, files found are reported
+        ///   as modified, as they may have been written before the watch was
+        ///   added.
+        /// </summary>
+        void add_watches(const std::string& path, bool report_files);
+
+        void process_events();
 #endif
-        std::function<void(rainbow::czstring)> callback_;
     };
 }  // namespace heimdall
 
@@ -6,9 +6,52 @@
 
 #ifdef USE_HEIMDALL
 
+#    include <algorithm>
+#    include <string_view>
+
+#    include "Common/Logging.h"
+#    include "FileSystem/Bundle.h"
+#    include "FileSystem/FileSystem.h"
+
 using heimdall::Gatekeeper;
+using rainbow::czstring;
+using rainbow::StringComparison;
 using rainbow::Vec2i;
 
+namespace
+{
+    /// <summary>
+    ///   Returns <paramref name="path"/> relative to the assets directory.
+    ///   Depending on the platform, the change monitor reports either
+    ///   absolute or relative paths.
+    /// </summary>
+    auto asset_path(std::string path) -> std::string
+    {
+        std::replace(path.begin(), path.end(), '\\', '/');
+
+        std::string_view assets = rainbow::filesystem::bundle().assets_path();
+        while (!assets.empty() && assets.back() == '/')
+            assets.remove_suffix(1);
+
+        if (path.size() > assets.size() && path[assets.size()] == '/' &&
+            path.compare(0, assets.size(), assets) == 0) {
+            path.erase(0, assets.size() + 1);
+        }
+
+        return path;
+    }
+}  // namespace
+
+Gatekeeper::Gatekeeper()
+    : overlay_(director_),
+      overlay_activator_(director_.input(), overlay_),
+      change_monitor_(rainbow::filesystem::bundle().assets_path(),
+                      [this](czstring path) {
+                          changed_files_->emplace_back(path);
+                      })
+{
+}
+
 void Gatekeeper::init(const Vec2i& screen)
 {
     overlay_.initialize(director_.graphics_context(), screen);
@@ -19,6 +62,7 @@ void Gatekeeper::init(const Vec2i& screen)
 
 void Gatekeeper::update(uint64_t dt)
 {
+    reload_changed_files();
     director_.update(dt);
 
     if (!overlay_.is_enabled())
@@ -27,4 +71,42 @@ void Gatekeeper::update(uint64_t dt)
     overlay_.update(*director_.script(), dt);
 }
 
+void Gatekeeper::reload_changed_files()
+{
+    std::vector<std::string> changed_files;
+    changed_files_->swap(changed_files);
+    if (changed_files.empty())
+        return;
+
+    for (auto&& path : changed_files)
+        path = asset_path(std::move(path));
+
+    std::sort(changed_files.begin(), changed_files.end());
+    changed_files.erase(
+        std::unique(changed_files.begin(), changed_files.end()),
+        changed_files.end());
+
+    // New files may have been added, and prefetched data may be stale.
+    rainbow::filesystem::invalidate_index();
+    director_.prefetcher().clear();
+
+    bool restart = false;
+    for (auto&& path : changed_files) {
+        if (rainbow::ends_with(path, ".js", StringComparison::IgnoreCase)) {
+            restart = true;
+            continue;
+        }
+
+        if (director_.texture_provider().reload(path))
+            LOGI("Reloaded texture '%s'", path.c_str());
+        if (director_.font_cache().reload(path))
+            LOGI("Reloaded font '%s'", path.c_str());
+    }
+
+    if (restart) {
+        LOGI("Scripts were modified, restarting...");
+        director_.restart();
+    }
+}
+
 #endif  // USE_HEIMDALL
@@ -5,9 +5,14 @@
 #ifndef HEIMDALL_GATEKEEPER_H_
 #define HEIMDALL_GATEKEEPER_H_
 
+#include <string>
+#include <vector>
+
 #include "Director.h"
+#include "Heimdall/ChangeMonitor.h"
 #include "Heimdall/Overlay.h"
 #include "Heimdall/OverlayActivator.h"
+#include "Threading/Synchronized.h"
 
 namespace heimdall
 {
@@ -15,11 +20,7 @@ namespace heimdall
     class Gatekeeper final
     {
     public:
-        Gatekeeper()
-            : overlay_(director_),
-              overlay_activator_(director_.input(), overlay_)
-        {
-        }
+        Gatekeeper();
 
         void init(const rainbow::Vec2i& screen);
 
@@ -54,6 +55,20 @@ namespace heimdall
         rainbow::Director director_;
         Overlay overlay_;
         OverlayActivator overlay_activator_;
+
+        /// <summary>
+        ///   Files reported modified by <c>change_monitor_</c>, which runs
+        ///   on a different thread.
+        /// </summary>
+        rainbow::Synchronized<std::vector<std::string>> changed_files_;
+
+        ChangeMonitor change_monitor_;
+
+        /// <summary>
+        ///   Reloads modified assets in place. Scripts cannot be swapped
+        ///   while running, so any modified script restarts the game.
+        /// </summary>
+        void reload_changed_files();
     };
 }  // namespace heimdall
 
@@ -6,12 +6,14 @@
 
 #ifdef USE_HEIMDALL
 
+#    include <cinttypes>
 #    include <numeric>
 
 #    include "Common/TypeCast.h"
 #    include "Graphics/Animation.h"
 #    include "Graphics/Label.h"
 #    include "Graphics/SpriteBatch.h"
+#    include "Graphics/TextBatch.h"
 #    include "Script/GameBase.h"
 #    include "ThirdParty/ImGui/ImGuiHelper.h"
 
@@ -30,6 +32,7 @@ using rainbow::Label;
 using rainbow::Pointer;
 using rainbow::Sprite;
 using rainbow::SpriteBatch;
+using rainbow::TextBatch;
 using rainbow::Vec2f;
 using rainbow::Vec2i;
 using rainbow::graphics::Context;
@@ -202,6 +205,18 @@ namespace
             }
         }
 
+        void operator()(TextBatch* batch) const
+        {
+            if (ImGui::TreeNode(batch,
+                                WITH_TAG(TextBatch, "size=%zu"),
+                                batch->size(),
+                                tag)) {
+                write_address(batch);
+                WRITE_PROP(*batch, is_visible);
+                ImGui::TreePop();
+            }
+        }
+
         template <typename T>
         void operator()(T&& drawable) const
         {
@@ -260,6 +275,15 @@ void Overlay::draw_performance(float scale)
 
     ImGui::TextWrapped("Draw count: %u", graphics::draw_count());
 
+    const auto prefetch = director_.prefetcher().stats();
+    ImGui::TextWrapped(
+        "Prefetch hit rate: %.0f%% (%" PRIu64 " hits, %" PRIu64
+        " misses, %" PRIu64 " unhinted)",
+        prefetch.hit_rate() * 100.0,
+        prefetch.hits,
+        prefetch.misses,
+        prefetch.unhinted);
+
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
     std::array<char, 128> buffer;
 
@@ -0,0 +1,166 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Heimdall/ChangeMonitor.h"
+
+#ifdef USE_HEIMDALL
+
+#    include <array>
+#    include <cerrno>
+#    include <cstring>
+#    include <string_view>
+
+#    include <dirent.h>
+#    include <poll.h>
+#    include <sys/eventfd.h>
+#    include <sys/inotify.h>
+#    include <unistd.h>
+
+#    include "Common/Logging.h"
+#    include "FileSystem/FileSystem.h"
+
+using heimdall::ChangeMonitor;
+using rainbow::czstring;
+
+namespace
+{
+    // Editors either write files in place, or write to a temporary file and
+    // move it over the original.
+    constexpr uint32_t kWatchEvents =
+        IN_CLOSE_WRITE | IN_CREATE | IN_MOVED_TO | IN_ONLYDIR;
+
+    auto join(const std::string& directory, std::string_view name)
+    {
+        std::string path;
+        path.reserve(directory.size() + 1 + name.size());
+        if (!directory.empty()) {
+            path += directory;
+            path += '/';
+        }
+        path += name;
+        return path;
+    }
+}  // namespace
+
+ChangeMonitor::ChangeMonitor(czstring directory, Callback callback)
+    : fd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)),
+      wake_fd_(eventfd(0, EFD_CLOEXEC)), directory_(directory),
+      callback_(std::move(callback))
+{
+    if (fd_ < 0 || wake_fd_ < 0) {
+        LOGE("inotify: %s", strerror(errno));
+        return;
+    }
+
+    if (rainbow::is_empty(directory))
+        return;
+
+    add_watches({}, false);
+    if (directories_.empty())
+        return;
+
+    LOGI("Monitoring '%s'", directory);
+    worker_ = std::thread([this] {
+        std::array<pollfd, 2> fds{{{fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}}};
+        while (true) {
+            if (poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR)
+                    continue;
+
+                LOGE("inotify: %s", strerror(errno));
+                return;
+            }
+
+            if ((fds[1].revents & POLLIN) != 0)
+                return;
+
+            if ((fds[0].revents & POLLIN) != 0)
+                process_events();
+        }
+    });
+}
+
+ChangeMonitor::~ChangeMonitor()
+{
+    if (worker_.joinable()) {
+        const uint64_t stop = 1;
+        [[maybe_unused]] auto written = write(wake_fd_, &stop, sizeof(stop));
+        worker_.join();
+    }
+
+    if (wake_fd_ >= 0)
+        close(wake_fd_);
+    if (fd_ >= 0)
+        close(fd_);
+}
+
+void ChangeMonitor::add_watches(const std::string& path, bool report_files)
+{
+    const auto full_path = join(directory_, path);
+    const int wd = inotify_add_watch(fd_, full_path.c_str(), kWatchEvents);
+    if (wd < 0) {
+        LOGW("inotify: Failed to watch '%s': %s",
+             full_path.c_str(),
+             strerror(errno));
+        return;
+    }
+
+    directories_[wd] = path;
+
+    auto dir = opendir(full_path.c_str());
+    if (dir == nullptr)
+        return;
+
+    while (auto entry = readdir(dir)) {
+        const std::string_view name = entry->d_name;
+        if (name == "." || name == "..")
+            continue;
+
+        // Symbolic links are not followed to avoid cycles
+        const auto child = join(path, name);
+        const bool is_directory =
+            entry->d_type == DT_DIR ||
+            (entry->d_type == DT_UNKNOWN &&
+             rainbow::system::is_directory(join(directory_, child).c_str()));
+        if (is_directory)
+            add_watches(child, report_files);
+        else if (report_files && entry->d_type != DT_LNK)
+            on_modified(child.c_str());
+    }
+
+    closedir(dir);
+}
+
+void ChangeMonitor::process_events()
+{
+    alignas(inotify_event) std::array<char, 4096> buffer;
+    while (true) {
+        const auto length = read(fd_, buffer.data(), buffer.size());
+        if (length <= 0)
+            return;
+
+        for (auto i = buffer.data(); i < buffer.data() + length;) {
+            const auto event = reinterpret_cast<const inotify_event*>(i);
+            i += sizeof(inotify_event) + event->len;
+
+            if ((event->mask & IN_IGNORED) != 0) {
+                directories_.erase(event->wd);
+                continue;
+            }
+
+            auto directory = directories_.find(event->wd);
+            if (directory == directories_.end() || event->len == 0)
+                continue;
+
+            const auto path = join(directory->second, event->name);
+            if ((event->mask & IN_ISDIR) != 0) {
+                add_watches(path, true);
+            } else if ((event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) != 0) {
+                on_modified(path.c_str());
+            }
+        }
+    }
+}
+
+#endif  // USE_HEIMDALL
@@ -6,5 +6,5 @@
 
 using heimdall::ChangeMonitor;
 
-ChangeMonitor::ChangeMonitor(rainbow::czstring) {}
+ChangeMonitor::ChangeMonitor(rainbow::czstring, Callback) {}
 ChangeMonitor::~ChangeMonitor() {}
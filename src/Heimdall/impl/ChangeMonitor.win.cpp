@@ -11,8 +11,8 @@
 using heimdall::ChangeMonitor;
 using rainbow::czstring;
 
-ChangeMonitor::ChangeMonitor(czstring directory)
-    : monitoring_(false), callback_([](czstring) {})
+ChangeMonitor::ChangeMonitor(czstring directory, Callback callback)
+    : monitoring_(false), callback_(std::move(callback))
 {
     hDirectory_ =
         CreateFileA(directory,
@@ -0,0 +1,123 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Memory/BufferPool.h"
+
+#include <array>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace buffer_pool = rainbow::buffer_pool;
+
+namespace
+{
+    constexpr size_t kMinPooledSize = 64;
+    constexpr size_t kSizeClasses = 13;
+
+    static_assert(kMinPooledSize << (kSizeClasses - 1) ==
+                  buffer_pool::kMaxPooledSize);
+
+    /// <summary>
+    ///   Returns the size class that fits <paramref name="capacity"/> bytes,
+    ///   or <c>kSizeClasses</c> if it is too large to be pooled.
+    /// </summary>
+    auto size_class(size_t capacity)
+    {
+        size_t index = 0;
+        for (auto class_size = kMinPooledSize; class_size < capacity;
+             class_size <<= 1) {
+            if (++index == kSizeClasses)
+                break;
+        }
+        return index;
+    }
+
+    constexpr auto class_size(size_t index)
+    {
+        return kMinPooledSize << index;
+    }
+
+    struct Pool {
+        std::mutex mutex;
+        std::array<std::vector<void*>, kSizeClasses> free;
+        buffer_pool::Stats stats{};
+    };
+
+    auto pool() -> Pool&
+    {
+        // Buffers may outlive static destruction, e.g. when held by other
+        // statics, so the pool is never destroyed.
+        static auto pool = new Pool;  // NOLINT(cppcoreguidelines-owning-memory)
+        return *pool;
+    }
+}  // namespace
+
+auto buffer_pool::allocate(size_t size) -> uint8_t*
+{
+    const auto capacity = size + 1;
+    const auto index = size_class(capacity);
+
+    void* buffer = nullptr;
+    if (index < kSizeClasses) {
+        auto& p = pool();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        auto& free = p.free[index];
+        if (free.empty()) {
+            ++p.stats.misses;
+        } else {
+            buffer = free.back();
+            free.pop_back();
+            p.stats.size -= class_size(index);
+            ++p.stats.hits;
+        }
+    }
+
+    if (buffer == nullptr) {
+        buffer = ::operator new(index < kSizeClasses ? class_size(index)
+                                                     : capacity);
+    }
+
+    auto bytes = static_cast<uint8_t*>(buffer);
+    bytes[size] = 0;
+    return bytes;
+}
+
+void buffer_pool::clear()
+{
+    auto& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    for (auto&& free : p.free) {
+        for (auto buffer : free)
+            ::operator delete(buffer);
+        free.clear();
+    }
+    p.stats.size = 0;
+}
+
+void buffer_pool::deallocate(void* buffer, size_t size)
+{
+    if (buffer == nullptr)
+        return;
+
+    const auto index = size_class(size + 1);
+    if (index < kSizeClasses) {
+        auto& p = pool();
+        std::lock_guard<std::mutex> lock(p.mutex);
+        if (p.stats.size + class_size(index) <= kBudget) {
+            p.free[index].push_back(buffer);
+            p.stats.size += class_size(index);
+            return;
+        }
+    }
+
+    ::operator delete(buffer);
+}
+
+auto buffer_pool::stats() -> Stats
+{
+    auto& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    return p.stats;
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef MEMORY_BUFFERPOOL_H_
+#define MEMORY_BUFFERPOOL_H_
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+///   Recycles the byte buffers that files are read into, so that loading many
+///   small assets does not churn the heap.
+/// </summary>
+/// <remarks>
+///   <para>
+///     Buffers are grouped in power-of-two size classes. Released buffers are
+///     kept for reuse until the pool holds <see cref="kBudget"/> bytes; past
+///     that, and for buffers larger than <see cref="kMaxPooledSize"/>, they
+///     are freed as usual.
+///   </para>
+///   <para>
+///     The pool is shared by all threads. Buffers may be released on a
+///     different thread than the one that allocated them.
+///   </para>
+/// </remarks>
+namespace rainbow::buffer_pool
+{
+    /// <summary>Largest buffer, including terminator, that is pooled.</summary>
+    constexpr size_t kMaxPooledSize = 256 * 1024;
+
+    /// <summary>Maximum number of bytes kept for reuse.</summary>
+    constexpr size_t kBudget = 4 * 1024 * 1024;
+
+    struct Stats {
+        /// <summary>Allocations served by a released buffer.</summary>
+        uint64_t hits;
+
+        /// <summary>Allocations of poolable size that were not.</summary>
+        uint64_t misses;
+
+        /// <summary>Bytes currently kept for reuse.</summary>
+        size_t size;
+    };
+
+    /// <summary>
+    ///   Returns a buffer of <paramref name="size"/> bytes, followed by a null
+    ///   terminator so that it can also be used as a string.
+    /// </summary>
+    [[nodiscard]] auto allocate(size_t size) -> uint8_t*;
+
+    /// <summary>Frees all buffers kept for reuse.</summary>
+    void clear();
+
+    /// <summary>
+    ///   Returns a buffer from <see cref="allocate"/> to the pool.
+    ///   <paramref name="size"/> must be the size it was allocated with.
+    /// </summary>
+    void deallocate(void* buffer, size_t size);
+
+    [[nodiscard]] auto stats() -> Stats;
+}  // namespace rainbow::buffer_pool
+
+#endif
@@ -178,6 +178,13 @@ void android_handle_display(RainbowContext* ctx)
     eglQuerySurface(ctx->display, ctx->surface, EGL_HEIGHT, &height);
 
     ctx->director.emplace();
+    {
+        const Config config;
+        auto& texture_provider = ctx->director->texture_provider();
+        texture_provider.set_memory_budget(config.texture_memory_budget());
+        texture_provider.set_color_depth(
+            config.texture_packing(), config.texture_dithering());
+    }
     if (ctx->director->terminated() ||
         (ctx->director->init({width, height}), ctx->director->terminated())) {
         LOGF("%s", ctx->director->error().message().c_str());
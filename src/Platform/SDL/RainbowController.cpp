@@ -60,6 +60,10 @@ RainbowController::RainbowController(SDLContext& context, const Config& config)
     for (int i = 0; i < SDL_NumJoysticks(); ++i)
         on_controller_connected(i);
 
+    director_.texture_provider().set_memory_budget(
+        config.texture_memory_budget());
+    director_.texture_provider().set_color_depth(
+        config.texture_packing(), config.texture_dithering());
     director_.init(context_.drawable_size());
     on_window_resized();
 
@@ -26,6 +26,7 @@
 #include "FileSystem/FileSystem.h"
 #include "Platform/SDL/Context.h"
 #include "Platform/SDL/RainbowController.h"
+#include "Text/FontBaker.h"
 #ifdef RAINBOW_TEST
 #    include "Tests/Tests.h"
 #endif
@@ -71,6 +72,9 @@ auto main(int argc, char* argv[]) -> int
         return rainbow::run_tests(argc, argv);
 #    endif
 
+    if (rainbow::text::should_bake_font(argc, argv))
+        return rainbow::text::bake_font(argc, argv);
+
 #    ifdef RAINBOW_OS_WINDOWS
     rainbow::windows::Console console;
 #    endif
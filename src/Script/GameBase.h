@@ -20,6 +20,11 @@ namespace rainbow
 
         [[nodiscard]] auto input() -> Input& { return director_.input(); }
 
+        [[nodiscard]] auto prefetcher() -> Prefetcher&
+        {
+            return director_.prefetcher();
+        }
+
         [[nodiscard]] auto render_queue() -> graphics::RenderQueue&
         {
             return director_.render_queue();
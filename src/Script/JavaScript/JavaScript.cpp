@@ -13,6 +13,7 @@
 #include "Script/JavaScript/Input.h"
 #include "Script/JavaScript/Module.h"
 #include "Script/JavaScript/Modules.g.h"
+#include "Script/JavaScript/Prefetcher.h"
 #include "Script/JavaScript/RenderQueue.h"
 
 #define ENSURE(x)                                                              \
@@ -67,6 +68,10 @@ JavaScript::JavaScript(Director& director) : GameBase(director), context_(this)
     duk::register_module(context_, rainbow, "Input", [this](duk_context* ctx) {
         duk::initialize_input(ctx, input());
     });
+    duk::register_module(
+        context_, rainbow, "Prefetcher", [this](duk_context* ctx) {
+            duk::initialize_prefetcher(ctx, prefetcher());
+        });
     duk::register_module(
         context_, rainbow, "RenderQueue", [this](duk_context* ctx) {
             duk::initialize_renderqueue(ctx, render_queue());
@@ -12,6 +12,7 @@
 #include "Audio/Mixer.h"
 #include "Common/TypeCast.h"
 #include "Common/TypeInfo.h"
+#include "FileSystem/Prefetcher.h"
 #include "Graphics/Animation.h"
 #include "Graphics/Label.h"
 #include "Graphics/RenderQueue.h"
@@ -270,6 +271,16 @@ void rainbow::duk::register_module<rainbow::Label>(duk_context* ctx, duk_idx_t r
             },
             DUK_VARARGS);
         duk::put_prop_literal(ctx, -2, "alignment");
+        duk_push_c_function(
+            ctx,
+            [](duk_context* ctx) -> duk_ret_t {
+                auto obj = duk::push_this<Label>(ctx);
+                auto args = duk::get_args<czstring>(ctx);
+                obj->append(std::get<0>(args));
+                return 1;
+            },
+            1);
+        duk::put_prop_literal(ctx, -2, "append");
         duk_push_c_function(
             ctx,
             [](duk_context* ctx) -> duk_ret_t {
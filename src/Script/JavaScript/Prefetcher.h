@@ -0,0 +1,28 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef SCRIPT_JAVASCRIPT_PREFETCHER_H_
+#define SCRIPT_JAVASCRIPT_PREFETCHER_H_
+
+#include "FileSystem/Prefetcher.h"
+#include "Script/JavaScript/Helper.h"
+
+namespace rainbow::duk
+{
+    void initialize_prefetcher(duk_context* ctx, Prefetcher& prefetcher)
+    {
+        duk::put_instance(ctx, duk_get_top(ctx) - 1, &prefetcher);
+        duk_push_c_function(  //
+            ctx,
+            [](duk_context* ctx) -> duk_ret_t {
+                auto args = duk::get_args<czstring>(ctx);
+                duk::push_this<Prefetcher>(ctx)->prefetch(std::get<0>(args));
+                return 0;
+            },
+            1);
+        duk::put_prop_literal(ctx, -2, "prefetch");
+    }
+}  // namespace rainbow::duk
+
+#endif
@@ -0,0 +1,21 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Common/Hash.h"
+
+#include <gtest/gtest.h>
+
+using rainbow::fnv1a;
+using rainbow::kFNV1aOffsetBasis;
+
+TEST(HashTest, FNV1a)
+{
+    static_assert(fnv1a("") == kFNV1aOffsetBasis);
+    static_assert(fnv1a("a") == 0xaf63dc4c8601ec8c);
+    static_assert(fnv1a("foobar") == 0x85944171f73967e8);
+
+    constexpr uint8_t kFoobar[]{'f', 'o', 'o', 'b', 'a', 'r'};
+    ASSERT_EQ(fnv1a(kFoobar, sizeof(kFoobar)), fnv1a("foobar"));
+    ASSERT_EQ(fnv1a(kFoobar + 3, 3, fnv1a(kFoobar, 3)), fnv1a("foobar"));
+}
@@ -21,6 +21,10 @@ TEST(ConfigTest, NoConfiguration)
     ASSERT_FALSE(config.is_portrait());
     ASSERT_EQ(config.msaa(), 0u);
     ASSERT_TRUE(config.suspend());
+    ASSERT_EQ(config.texture_memory_budget(), 0u);
+    ASSERT_EQ(config.texture_packing(), rainbow::Image::Packing::None);
+    ASSERT_EQ(config.texture_dithering(),
+              rainbow::graphics::Dithering::None);
 }
 
 TEST(ConfigTest, EmptyConfiguration)
@@ -61,6 +65,9 @@ TEST(ConfigTest, NormalConfiguration)
     ASSERT_EQ(c.msaa(), 4u);
     ASSERT_FALSE(c.needs_accelerometer());
     ASSERT_FALSE(c.suspend());
+    ASSERT_EQ(c.texture_memory_budget(), 256u * 1024 * 1024);
+    ASSERT_EQ(c.texture_packing(), rainbow::Image::Packing::RGBA4444);
+    ASSERT_EQ(c.texture_dithering(), rainbow::graphics::Dithering::Ordered);
 }
 
 TEST(ConfigTest, AlternateConfiguration)
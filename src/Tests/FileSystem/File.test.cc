@@ -199,3 +199,33 @@ TEST(FileTest, IsMovable)
     ASSERT_FALSE(file);
     ASSERT_EQ(file2.tell(), 5U);
 }
+
+TEST(FileTest, MapsLargeFiles)
+{
+    ScopedAssetsDirectory scoped_assets{"FileTest_SeeksInFile"};
+
+    constexpr czstring kLargeFile = "large.dat";
+    std::string contents(rainbow::kMinMappedFileSize + 1, 'x');
+    contents.front() = '<';
+    contents.back() = '>';
+    ASSERT_EQ(WriteableFile::write(kLargeFile,
+                                   {contents.data(),
+                                    contents.size(),
+                                    rainbow::Data::Ownership::Reference}),
+              contents.size());
+
+    {
+        const auto data = File::read(kLargeFile, FileType::Asset);
+        ASSERT_EQ(data.ownership(), rainbow::Data::Ownership::Mapped);
+        ASSERT_EQ(data.size(), contents.size());
+        ASSERT_EQ(contents.compare(0, contents.size(), data.as<char*>()), 0);
+        ASSERT_EQ(data.bytes()[data.size()], 0);
+    }
+    {
+        const auto data = File::read("file", FileType::Asset);
+        ASSERT_EQ(data.ownership(), rainbow::Data::Ownership::Pooled);
+        ASSERT_EQ(data.size(), 10U);
+    }
+
+    ASSERT_TRUE(rainbow::filesystem::remove(kLargeFile));
+}
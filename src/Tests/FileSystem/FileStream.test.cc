@@ -0,0 +1,127 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/FileStream.h"
+
+#include <string_view>
+
+#include <gtest/gtest.h>
+
+#include "FileSystem/Prefetcher.h"
+#include "Tests/TestHelpers.h"
+
+using rainbow::FileStream;
+using rainbow::FileType;
+using rainbow::Prefetcher;
+using rainbow::test::ScopedAssetsDirectory;
+
+namespace
+{
+    auto as_string(const ArrayView<uint8_t>& view)
+    {
+        return std::string_view{
+            reinterpret_cast<const char*>(view.data()), view.size()};
+    }
+}  // namespace
+
+TEST(FileStreamTest, ReadsInChunks)
+{
+    ScopedAssetsDirectory scoped_assets{"FileTest_SeeksInFile"};
+
+    FileStream stream{"file", FileType::Asset, 4};
+    ASSERT_TRUE(stream);
+    ASSERT_EQ(stream.size(), 10U);
+    ASSERT_EQ(as_string(stream.peek(4)), "0123");
+
+    char buffer[16]{};
+    ASSERT_EQ(stream.read(buffer, 3), 3U);
+    ASSERT_STREQ(buffer, "012");
+    ASSERT_EQ(stream.tell(), 3U);
+
+    // Peeking across the chunk boundary shifts the buffer
+    ASSERT_EQ(as_string(stream.peek(4)), "3456");
+    ASSERT_EQ(stream.tell(), 3U);
+
+    ASSERT_EQ(stream.read(buffer, 5), 5U);
+    ASSERT_EQ(std::string_view(buffer, 5), "34567");
+    ASSERT_FALSE(stream.eof());
+
+    ASSERT_EQ(stream.read(buffer, sizeof(buffer)), 2U);
+    ASSERT_EQ(std::string_view(buffer, 2), "89");
+    ASSERT_TRUE(stream.eof());
+    ASSERT_EQ(stream.read(buffer, sizeof(buffer)), 0U);
+    ASSERT_TRUE(stream.peek(4).empty());
+}
+
+TEST(FileStreamTest, ReadsLargeBlocksDirectly)
+{
+    ScopedAssetsDirectory scoped_assets{"FileTest_SeeksInFile"};
+
+    FileStream stream{"file", FileType::Asset, 4};
+
+    char buffer[16]{};
+    ASSERT_EQ(stream.read(buffer, 1), 1U);
+    ASSERT_EQ(stream.read(buffer, 7), 7U);
+    ASSERT_EQ(std::string_view(buffer, 7), "1234567");
+    ASSERT_EQ(stream.tell(), 8U);
+}
+
+TEST(FileStreamTest, ReadsRemainingBytes)
+{
+    ScopedAssetsDirectory scoped_assets{"FileTest_SeeksInFile"};
+
+    {
+        FileStream stream{"file", FileType::Asset, 4};
+        const auto data = stream.read_all();
+        ASSERT_EQ(data.size(), 10U);
+        ASSERT_STREQ(data.as<char*>(), "0123456789");
+        ASSERT_TRUE(stream.eof());
+    }
+    {
+        FileStream stream{"file", FileType::Asset, 4};
+
+        char buffer[5]{};
+        ASSERT_EQ(stream.read(buffer, 5), 5U);
+
+        const auto data = stream.read_all();
+        ASSERT_EQ(data.size(), 5U);
+        ASSERT_STREQ(data.as<char*>(), "56789");
+        ASSERT_TRUE(stream.eof());
+    }
+}
+
+TEST(FileStreamTest, StreamsPrefetchedAssets)
+{
+    ScopedAssetsDirectory scoped_assets{"FileTest_SeeksInFile"};
+    Prefetcher prefetcher;
+
+    prefetcher.prefetch("file");
+    prefetcher.wait();
+
+    FileStream stream{"file", FileType::Asset, 4};
+    ASSERT_EQ(prefetcher.stats().hits, 1U);
+    ASSERT_EQ(stream.size(), 10U);
+
+    // Prefetched data is already in memory and is not chunked
+    ASSERT_EQ(as_string(stream.peek(4)), "0123");
+
+    char buffer[16]{};
+    ASSERT_EQ(stream.read(buffer, sizeof(buffer)), 10U);
+    ASSERT_STREQ(buffer, "0123456789");
+}
+
+TEST(FileStreamTest, HandlesMissingFiles)
+{
+    ScopedAssetsDirectory scoped_assets{"FileTest_SeeksInFile"};
+
+    FileStream stream{"missing", FileType::Asset};
+    ASSERT_FALSE(stream);
+    ASSERT_EQ(stream.size(), 0U);
+    ASSERT_TRUE(stream.eof());
+    ASSERT_TRUE(stream.peek(4).empty());
+
+    char buffer[4];
+    ASSERT_EQ(stream.read(buffer, sizeof(buffer)), 0U);
+    ASSERT_FALSE(stream.read_all());
+}
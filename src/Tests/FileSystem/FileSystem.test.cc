@@ -4,10 +4,12 @@
 
 #include "FileSystem/FileSystem.h"
 
+#include <cstdio>
 #include <cstring>
 
 #include <gtest/gtest.h>
 
+#include "FileSystem/File.h"
 #include "Tests/TestHelpers.h"
 
 #ifdef RAINBOW_OS_WINDOWS
@@ -69,6 +71,45 @@ TEST(FileSystemTest, FileExists)
     ASSERT_FALSE(fs::is_regular_file("folder"));
 }
 
+TEST(FileSystemTest, KeepsIndexUpToDate)
+{
+    ScopedAssetsDirectory scoped_assets{"FileSystemTest"};
+
+    ASSERT_TRUE(fs::exists("/empty.dat"));
+    ASSERT_TRUE(fs::exists("folder"));
+    ASSERT_FALSE(fs::exists("new.dat"));
+    ASSERT_FALSE(rainbow::File::open("new.dat", rainbow::FileType::Asset));
+
+    const auto data = rainbow::Data::from_literal("new.dat");
+    ASSERT_EQ(rainbow::WriteableFile::write("new.dat", data), data.size());
+    ASSERT_TRUE(fs::is_regular_file("new.dat"));
+    ASSERT_EQ(fs::real_path("new.dat"), scoped_assets.path() / "new.dat");
+    ASSERT_TRUE(rainbow::File::open("new.dat", rainbow::FileType::Asset));
+
+    ASSERT_TRUE(fs::remove("new.dat"));
+    ASSERT_FALSE(fs::exists("new.dat"));
+}
+
+TEST(FileSystemTest, OpensFilesCreatedOutsidePhysicsFS)
+{
+    ScopedAssetsDirectory scoped_assets{"FileSystemTest"};
+
+    ASSERT_FALSE(fs::exists("external.dat"));
+
+    const auto path = scoped_assets.path() / "external.dat";
+    auto file = fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    ASSERT_GE(fputs("external.dat", file), 0);
+    fclose(file);
+
+    // The index does not know about the file until it has been opened
+    ASSERT_TRUE(rainbow::File::open("external.dat", rainbow::FileType::Asset));
+    ASSERT_TRUE(fs::is_regular_file("external.dat"));
+
+    ASSERT_TRUE(fs::remove("external.dat"));
+    ASSERT_FALSE(fs::exists("external.dat"));
+}
+
 TEST(FileSystemTest, ReturnsPlatformPathSeparator)
 {
     ASSERT_STREQ(fs::path_separator(), kPathSeparator);
@@ -82,6 +123,16 @@ TEST(FileSystemTest, ReturnsRealPath)
     ASSERT_EQ(full_path, scoped_assets.path() / "empty.dat");
 }
 
+TEST(FileSystemTest, SyncsFilesAndDirectories)
+{
+    ScopedAssetsDirectory scoped_assets{"FileSystemTest"};
+
+    ASSERT_TRUE(fs::sync("empty.dat"));
+    ASSERT_TRUE(fs::sync("folder"));
+    ASSERT_TRUE(fs::sync(""));
+    ASSERT_FALSE(fs::sync("does not exist"));
+}
+
 TEST(FileSystemTest, SystemReturnsCurrentPath)
 {
     char cwd[256];
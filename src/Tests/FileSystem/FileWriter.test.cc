@@ -0,0 +1,98 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/FileWriter.h"
+
+#include <gtest/gtest.h>
+
+#include "FileSystem/File.h"
+#include "Tests/TestHelpers.h"
+
+using rainbow::Data;
+using rainbow::File;
+using rainbow::FileType;
+using rainbow::FileWriter;
+using rainbow::test::ScopedAssetsDirectory;
+
+namespace fs = rainbow::filesystem;
+
+namespace
+{
+    constexpr char kSaveFile[] = "FileWriterTest.sav";
+}  // namespace
+
+TEST(FileWriterTest, WritesFilesInBackground)
+{
+    ScopedAssetsDirectory scoped_assets{"FileSystemTest"};
+    FileWriter writer;
+
+    writer.write(kSaveFile, Data::from_literal("first"));
+    writer.flush();
+
+    auto data = File::read(kSaveFile, FileType::UserFile);
+    ASSERT_STREQ(data.as<char*>(), "first");
+    ASSERT_FALSE(fs::exists("FileWriterTest.sav.tmp"));
+
+    // Existing files are replaced
+    writer.write(kSaveFile, Data::from_literal("second"));
+    writer.flush();
+
+    data = File::read(kSaveFile, FileType::UserFile);
+    ASSERT_STREQ(data.as<char*>(), "second");
+
+    const auto stats = writer.stats();
+    ASSERT_EQ(stats.writes, 2U);
+    ASSERT_EQ(stats.coalesced, 0U);
+    ASSERT_EQ(stats.failures, 0U);
+
+    ASSERT_TRUE(fs::remove(kSaveFile));
+}
+
+TEST(FileWriterTest, WritesOnlyTheNewestData)
+{
+    ScopedAssetsDirectory scoped_assets{"FileSystemTest"};
+    {
+        FileWriter writer;
+        for (int i = 0; i < 100; ++i)
+            writer.write(kSaveFile, Data::from_literal("stale"));
+        writer.write(kSaveFile, Data::from_literal("newest"));
+
+        // Pending writes are flushed on destruction
+    }
+
+    const auto data = File::read(kSaveFile, FileType::UserFile);
+    ASSERT_STREQ(data.as<char*>(), "newest");
+
+    ASSERT_TRUE(fs::remove(kSaveFile));
+}
+
+TEST(FileWriterTest, CountsCoalescedWrites)
+{
+    ScopedAssetsDirectory scoped_assets{"FileSystemTest"};
+    FileWriter writer;
+
+    constexpr uint64_t kWrites = 100;
+    for (uint64_t i = 0; i < kWrites; ++i)
+        writer.write(kSaveFile, Data::from_literal("data"));
+    writer.flush();
+
+    const auto stats = writer.stats();
+    ASSERT_GE(stats.writes, 1U);
+    ASSERT_EQ(stats.writes + stats.coalesced, kWrites);
+
+    ASSERT_TRUE(fs::remove(kSaveFile));
+}
+
+TEST(FileWriterTest, ReportsFailedWrites)
+{
+    ScopedAssetsDirectory scoped_assets{"FileSystemTest"};
+    FileWriter writer;
+
+    writer.write("does/not/exist.sav", Data::from_literal("data"));
+    writer.flush();
+
+    const auto stats = writer.stats();
+    ASSERT_EQ(stats.writes, 0U);
+    ASSERT_EQ(stats.failures, 1U);
+}
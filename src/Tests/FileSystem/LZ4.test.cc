@@ -0,0 +1,114 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/LZ4.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace lz4 = rainbow::lz4;
+
+namespace
+{
+    template <size_t N>
+    auto decompress(const uint8_t (&block)[N], size_t size)
+    {
+        std::string out(size, '\0');
+        const bool success = lz4::decompress(
+            block, N, reinterpret_cast<uint8_t*>(out.data()), out.size());
+        return success ? out : std::string{"<error>"};
+    }
+}  // namespace
+
+TEST(LZ4Test, DecompressesLiterals)
+{
+    constexpr uint8_t kBlock[]{0x50, 'h', 'e', 'l', 'l', 'o'};
+    ASSERT_EQ(decompress(kBlock, 5), "hello");
+
+    std::vector<uint8_t> block{0xf0, 255, 30};
+    block.resize(block.size() + 300, 'x');
+
+    std::string out(300, '\0');
+    ASSERT_TRUE(lz4::decompress(block.data(),
+                                block.size(),
+                                reinterpret_cast<uint8_t*>(out.data()),
+                                out.size()));
+    ASSERT_EQ(out, std::string(300, 'x'));
+}
+
+TEST(LZ4Test, DecompressesOverlappingMatches)
+{
+    // 'ab' followed by a match of 10 bytes at offset 2
+    constexpr uint8_t kBlock[]{0x26, 'a', 'b', 2, 0, 0x10, 'c'};
+    ASSERT_EQ(decompress(kBlock, 13), "abababababab" "c");
+}
+
+TEST(LZ4Test, DecompressesLongMatches)
+{
+    // 'a' followed by a match of 4 + 15 + 255 + 6 bytes at offset 1
+    constexpr uint8_t kBlock[]{0x1f, 'a', 1, 0, 255, 6};
+    ASSERT_EQ(decompress(kBlock, 281), std::string(281, 'a'));
+}
+
+TEST(LZ4Test, RejectsMalformedBlocks)
+{
+    constexpr uint8_t kZeroOffset[]{0x10, 'a', 0, 0};
+    ASSERT_EQ(decompress(kZeroOffset, 5), "<error>");
+
+    constexpr uint8_t kOffsetOutOfBounds[]{0x10, 'a', 2, 0};
+    ASSERT_EQ(decompress(kOffsetOutOfBounds, 5), "<error>");
+
+    constexpr uint8_t kTruncatedLiterals[]{0x50, 'h', 'e'};
+    ASSERT_EQ(decompress(kTruncatedLiterals, 5), "<error>");
+
+    constexpr uint8_t kTruncatedLength[]{0xf0, 255};
+    ASSERT_EQ(decompress(kTruncatedLength, 300), "<error>");
+
+    constexpr uint8_t kTruncatedOffset[]{0x10, 'a', 1};
+    ASSERT_EQ(decompress(kTruncatedOffset, 5), "<error>");
+
+    constexpr uint8_t kLiterals[]{0x50, 'h', 'e', 'l', 'l', 'o'};
+    ASSERT_EQ(decompress(kLiterals, 4), "<error>");
+    ASSERT_EQ(decompress(kLiterals, 6), "<error>");
+
+    constexpr uint8_t kMatch[]{0x15, 'a', 1, 0};
+    ASSERT_EQ(decompress(kMatch, 9), "<error>");
+}
+
+TEST(LZ4Test, ReadsBlocks)
+{
+    // One stored block followed by a compressed one
+    std::vector<uint8_t> data(8 + lz4::kBlockSize);
+    const uint32_t ends[]{lz4::kBlockSize, lz4::kBlockSize + 6};
+    memcpy(data.data(), ends, sizeof(ends));
+    for (size_t i = 0; i < lz4::kBlockSize; ++i)
+        data[8 + i] = static_cast<uint8_t>(i * 7);
+    data.insert(data.end(), {0x50, 'h', 'e', 'l', 'l', 'o'});
+
+    const lz4::Blocks blocks{{data.data(), data.size()}, lz4::kBlockSize + 5};
+    ASSERT_TRUE(blocks);
+    ASSERT_EQ(blocks.count(), 2U);
+    ASSERT_EQ(blocks.size(0), lz4::kBlockSize);
+    ASSERT_EQ(blocks.size(1), 5U);
+
+    std::vector<uint8_t> block(lz4::kBlockSize);
+    ASSERT_TRUE(blocks.decompress(0, block.data()));
+    ASSERT_TRUE(std::equal(block.begin(), block.end(), data.begin() + 8));
+    ASSERT_TRUE(blocks.decompress(1, block.data()));
+    ASSERT_EQ(std::string(reinterpret_cast<char*>(block.data()), 5), "hello");
+
+    // The block table must cover the data exactly
+    ASSERT_FALSE((lz4::Blocks{{data.data(), data.size() - 1},
+                              lz4::kBlockSize + 5}));
+    ASSERT_FALSE((lz4::Blocks{{data.data(), 4}, lz4::kBlockSize + 5}));
+
+    const uint32_t reversed[]{lz4::kBlockSize + 6, lz4::kBlockSize};
+    memcpy(data.data(), reversed, sizeof(reversed));
+    ASSERT_FALSE((lz4::Blocks{{data.data(), data.size()},
+                              lz4::kBlockSize + 5}));
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/MemoryMappedFile.h"
+
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "Tests/TestHelpers.h"
+
+using rainbow::MemoryMappedFile;
+using rainbow::test::fixture_path;
+
+TEST(MemoryMappedFileTest, MapsFiles)
+{
+    const auto path = fixture_path("FileTest_SeeksInFile/file");
+    const MemoryMappedFile file{path.c_str()};
+
+    ASSERT_TRUE(file);
+    ASSERT_EQ(file.size(), 10U);
+    ASSERT_EQ(memcmp(file.data(), "0123456789", file.size()), 0);
+}
+
+TEST(MemoryMappedFileTest, FailsOnEmptyOrMissingFiles)
+{
+    const auto empty = fixture_path("FileTest_HandlesEmptyFiles/empty.dat");
+    ASSERT_FALSE(MemoryMappedFile{empty.c_str()});
+
+    const auto missing = fixture_path("FileTest_HandlesEmptyFiles/missing");
+    ASSERT_FALSE(MemoryMappedFile{missing.c_str()});
+}
+
+TEST(MemoryMappedFileTest, IsMovable)
+{
+    const auto path = fixture_path("FileTest_SeeksInFile/file");
+    MemoryMappedFile file{path.c_str()};
+    const auto data = file.data();
+
+    MemoryMappedFile moved{std::move(file)};
+    ASSERT_FALSE(file);  // NOLINT(bugprone-use-after-move)
+    ASSERT_EQ(moved.data(), data);
+
+    file = std::move(moved);
+    ASSERT_TRUE(file);
+    ASSERT_FALSE(moved);  // NOLINT(bugprone-use-after-move)
+    ASSERT_EQ(file.data(), data);
+}
+
+TEST(MemoryMappedFileTest, PrefaultsPages)
+{
+    const auto path = fixture_path("FileTest_SeeksInFile/file");
+    const MemoryMappedFile file{path.c_str()};
+
+    // Views need not start on a page boundary
+    MemoryMappedFile::prefault(file.data() + 3, file.size() - 3);
+    MemoryMappedFile::prefault(file.data(), file.size());
+    MemoryMappedFile::prefault(nullptr, 0);
+
+    ASSERT_EQ(memcmp(file.data(), "0123456789", file.size()), 0);
+}
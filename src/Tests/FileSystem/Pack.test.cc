@@ -0,0 +1,274 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/Pack.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "Common/Hash.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileStream.h"
+#include "FileSystem/FileSystem.h"
+#include "Tests/TestHelpers.h"
+
+using rainbow::File;
+using rainbow::FileStream;
+using rainbow::FileType;
+using rainbow::Pack;
+using rainbow::test::fixture_path;
+using rainbow::test::ScopedAssetsDirectory;
+
+namespace
+{
+    constexpr char kPackFile[] = "PackTest/assets.rpak";
+    constexpr char kLZ4PackFile[] = "PackTest/lz4.rpak";
+    constexpr char kDedupPackFile[] = "PackTest/dedup.rpak";
+
+    const std::string kHello = [] {
+        std::string hello;
+        for (int i = 0; i < 100; ++i)
+            hello += "Hello, world! ";
+        return hello;
+    }();
+
+    // Spans three LZ4 blocks
+    const std::string kLines = [] {
+        std::string lines;
+        for (int i = 0; i < 3000; ++i) {
+            lines += std::to_string(i);
+            lines += ": The quick brown fox jumps over the lazy dog\n";
+        }
+        return lines;
+    }();
+
+    class ScopedPack
+    {
+    public:
+        explicit ScopedPack(rainbow::czstring pack = kPackFile)
+            : path_(fixture_path(pack))
+        {
+            rainbow::filesystem::mount(path_.c_str());
+        }
+
+        ~ScopedPack() { rainbow::filesystem::unmount(path_.c_str()); }
+
+    private:
+        rainbow::filesystem::Path path_;
+    };
+}  // namespace
+
+TEST(PackTest, RejectsInvalidPacks)
+{
+    ASSERT_FALSE(Pack{fixture_path("FileTest_SeeksInFile/file").c_str()});
+    ASSERT_FALSE(Pack{fixture_path("PackTest/missing.rpak").c_str()});
+
+    // Stored entries must not claim to be larger than they are
+    ASSERT_FALSE(Pack{fixture_path("PackTest/oversized.rpak").c_str()});
+
+    // Entries must not wrap around the end of the address space
+    ASSERT_FALSE(Pack{fixture_path("PackTest/overflow.rpak").c_str()});
+}
+
+TEST(PackTest, FindsEntries)
+{
+    const Pack pack{fixture_path(kPackFile).c_str()};
+    ASSERT_TRUE(pack);
+    ASSERT_EQ(pack.entries().size(), 3U);
+
+    for (auto path : {"hello.txt", "data/noise.bin", "data/numbers"}) {
+        auto entry = pack.find(path);
+        ASSERT_NE(entry, nullptr);
+        ASSERT_EQ(pack.name(*entry), path);
+    }
+
+    ASSERT_EQ(pack.find("data"), nullptr);
+    ASSERT_EQ(pack.find("numbers"), nullptr);
+    ASSERT_EQ(pack.find("hello.txt "), nullptr);
+}
+
+TEST(PackTest, AlignsEntries)
+{
+    const Pack pack{fixture_path(kPackFile).c_str()};
+
+    auto large = pack.find("data/noise.bin");
+    ASSERT_EQ(large->size, 5000U);
+    ASSERT_EQ(large->offset % 4096, 0U);
+
+    auto small = pack.find("data/numbers");
+    ASSERT_EQ(small->offset % 16, 0U);
+}
+
+TEST(PackTest, ReadsEntries)
+{
+    const Pack pack{fixture_path(kPackFile).c_str()};
+
+    const auto numbers = pack.read(*pack.find("data/numbers"));
+    ASSERT_EQ(numbers.ownership(), rainbow::Data::Ownership::Reference);
+    ASSERT_EQ(numbers.size(), 10U);
+    ASSERT_STREQ(numbers.as<char*>(), "0123456789");
+
+    auto hello_entry = pack.find("hello.txt");
+    ASSERT_EQ(hello_entry->compression, Pack::Compression::Deflate);
+    ASSERT_LT(hello_entry->size, hello_entry->uncompressed_size);
+
+    const auto hello = pack.read(*hello_entry);
+    ASSERT_EQ(hello.ownership(), rainbow::Data::Ownership::Pooled);
+    ASSERT_EQ(hello.size(), kHello.size());
+    ASSERT_EQ(hello.as<char*>(), kHello);
+}
+
+TEST(PackTest, ReadsLZ4Entries)
+{
+    const Pack pack{fixture_path(kLZ4PackFile).c_str()};
+    ASSERT_TRUE(pack);
+
+    for (auto&& [path, expected] : {std::make_pair("hello.txt", &kHello),
+                                    std::make_pair("lines.txt", &kLines)}) {
+        auto entry = pack.find(path);
+        ASSERT_NE(entry, nullptr);
+        ASSERT_EQ(entry->compression, Pack::Compression::LZ4);
+        ASSERT_LT(entry->size, entry->uncompressed_size);
+
+        const auto data = pack.read(*entry);
+        ASSERT_EQ(data.ownership(), rainbow::Data::Ownership::Pooled);
+        ASSERT_EQ(data.size(), expected->size());
+        ASSERT_EQ(data.as<char*>(), *expected);
+    }
+}
+
+TEST(PackTest, StoresIdenticalContentOnce)
+{
+    const Pack pack{fixture_path(kDedupPackFile).c_str()};
+    ASSERT_TRUE(pack);
+    ASSERT_EQ(pack.entries().size(), 3U);
+
+    auto a = pack.find("a/hello.txt");
+    auto b = pack.find("b/hello.txt");
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    ASSERT_EQ(a->offset, b->offset);
+    ASSERT_EQ(a->size, b->size);
+    ASSERT_EQ(pack.read(*b).as<char*>(), kHello);
+
+    const auto hash = pack.content_hash(*a);
+    ASSERT_TRUE(hash);
+    ASSERT_EQ(pack.content_hash(*b), hash);
+    ASSERT_EQ(*hash, rainbow::fnv1a(kHello));
+
+    auto numbers = pack.find("numbers");
+    ASSERT_NE(numbers->offset, a->offset);
+    ASSERT_NE(pack.content_hash(*numbers), hash);
+}
+
+TEST(PackTest, ReadsVersion1Packs)
+{
+    const Pack pack{fixture_path(kPackFile).c_str()};
+    ASSERT_TRUE(pack);
+
+    auto entry = pack.find("hello.txt");
+    ASSERT_FALSE(pack.content_hash(*entry));
+    ASSERT_EQ(pack.read(*entry).as<char*>(), kHello);
+}
+
+TEST(PackTest, MountsThroughPhysicsFS)
+{
+    ASSERT_FALSE(rainbow::filesystem::exists("data/numbers"));
+    ASSERT_FALSE(File::read("hello.txt", FileType::Asset));
+
+    {
+        ScopedPack scoped_pack;
+
+        ASSERT_TRUE(rainbow::filesystem::exists("data/numbers"));
+        ASSERT_TRUE(rainbow::filesystem::exists("/hello.txt"));
+        ASSERT_TRUE(rainbow::filesystem::is_directory("data"));
+        ASSERT_FALSE(rainbow::filesystem::exists("data/missing"));
+
+        const auto hello = File::read("hello.txt", FileType::Asset);
+        ASSERT_EQ(hello.as<char*>(), kHello);
+
+        // Streaming goes through the archiver
+        const auto file = File::open("data/numbers", FileType::Asset);
+        ASSERT_TRUE(file);
+        ASSERT_EQ(file.size(), 10U);
+        ASSERT_TRUE(file.seek(5));
+
+        char buffer[8]{};
+        ASSERT_EQ(file.read(buffer, sizeof(buffer)), 5U);
+        ASSERT_STREQ(buffer, "56789");
+    }
+
+    ASSERT_FALSE(rainbow::filesystem::exists("data/numbers"));
+    ASSERT_FALSE(File::read("hello.txt", FileType::Asset));
+}
+
+TEST(PackTest, LooseFilesShadowPackEntries)
+{
+    ScopedPack scoped_pack;
+    ASSERT_STREQ(File::read("data/numbers", FileType::Asset).as<char*>(),
+                 "0123456789");
+
+    {
+        // Directories mounted after the pack are searched first
+        ScopedAssetsDirectory scoped_assets{"PackTest/loose"};
+
+        ASSERT_STREQ(File::read("data/numbers", FileType::Asset).as<char*>(),
+                     "9876543210");
+
+        FileStream stream{"data/numbers", FileType::Asset};
+        ASSERT_STREQ(stream.read_all().as<char*>(), "9876543210");
+
+        // Entries that are not shadowed are still read from the pack
+        ASSERT_EQ(File::read("hello.txt", FileType::Asset).as<char*>(),
+                  kHello);
+    }
+
+    ASSERT_STREQ(File::read("data/numbers", FileType::Asset).as<char*>(),
+                 "0123456789");
+}
+
+TEST(PackTest, ReturnsContentHashesOfMountedEntries)
+{
+    ASSERT_FALSE(rainbow::filesystem::content_hash("a/hello.txt"));
+
+    {
+        ScopedPack scoped_pack{kDedupPackFile};
+
+        const auto hash = rainbow::filesystem::content_hash("a/hello.txt");
+        ASSERT_TRUE(hash);
+        ASSERT_EQ(rainbow::filesystem::content_hash("/b/hello.txt"), hash);
+        ASSERT_FALSE(rainbow::filesystem::content_hash("c/hello.txt"));
+    }
+
+    ASSERT_FALSE(rainbow::filesystem::content_hash("a/hello.txt"));
+}
+
+TEST(PackTest, StreamsLZ4EntriesThroughPhysicsFS)
+{
+    ScopedPack scoped_pack{kLZ4PackFile};
+
+    const auto file = File::open("lines.txt", FileType::Asset);
+    ASSERT_TRUE(file);
+    ASSERT_EQ(file.size(), kLines.size());
+
+    // Read across block boundaries
+    std::string buffer(50000, '\0');
+    std::string lines;
+    while (lines.size() < kLines.size()) {
+        const auto read = file.read(buffer.data(), buffer.size());
+        ASSERT_GT(read, 0U);
+        ASSERT_LE(read, buffer.size());
+        lines.append(buffer, 0, read);
+    }
+    ASSERT_EQ(lines, kLines);
+
+    constexpr size_t kOffset = 70000;
+    ASSERT_TRUE(file.seek(kOffset));
+    ASSERT_EQ(file.read(buffer.data(), 100), 100U);
+    ASSERT_EQ(buffer.compare(0, 100, kLines, kOffset, 100), 0);
+
+    ASSERT_STREQ(File::read("lines.txt", FileType::Asset).as<char*>(),
+                 kLines.c_str());
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "FileSystem/Prefetcher.h"
+
+#include <gtest/gtest.h>
+
+#include "FileSystem/File.h"
+#include "Tests/TestHelpers.h"
+
+using rainbow::File;
+using rainbow::FileType;
+using rainbow::Prefetcher;
+using rainbow::test::ScopedAssetsDirectory;
+
+TEST(PrefetcherTest, ServesPrefetchedFilesOnce)
+{
+    ScopedAssetsDirectory scoped_assets{"FileTest_SeeksInFile"};
+    Prefetcher prefetcher;
+
+    prefetcher.prefetch("file");
+    prefetcher.prefetch("file");
+    prefetcher.wait();
+    ASSERT_EQ(prefetcher.stats().size, 10U);
+
+    const auto data = File::read("file", FileType::Asset);
+    ASSERT_EQ(data.size(), 10U);
+    ASSERT_STREQ(data.as<char*>(), "0123456789");
+
+    auto stats = prefetcher.stats();
+    ASSERT_EQ(stats.hits, 1U);
+    ASSERT_EQ(stats.misses, 0U);
+    ASSERT_EQ(stats.size, 0U);
+
+    // Reads that were not hinted don't count against the hit rate
+    ASSERT_TRUE(File::read("file", FileType::Asset));
+
+    stats = prefetcher.stats();
+    ASSERT_EQ(stats.hits, 1U);
+    ASSERT_EQ(stats.misses, 0U);
+    ASSERT_EQ(stats.unhinted, 1U);
+    ASSERT_DOUBLE_EQ(stats.hit_rate(), 1.0);
+}
+
+TEST(PrefetcherTest, EvictsOldestFilesWhenFull)
+{
+    ScopedAssetsDirectory scoped_assets{"TextureProviderTest"};
+    Prefetcher prefetcher{100};
+
+    prefetcher.prefetch("red.png");
+    prefetcher.prefetch("blue.png");
+    prefetcher.wait();
+
+    auto stats = prefetcher.stats();
+    ASSERT_EQ(stats.evictions, 1U);
+    ASSERT_EQ(stats.size, 73U);
+
+    ASSERT_FALSE(prefetcher.take("red.png"));
+    ASSERT_EQ(prefetcher.take("blue.png").size(), 73U);
+
+    stats = prefetcher.stats();
+    ASSERT_EQ(stats.hits, 1U);
+    ASSERT_EQ(stats.misses, 1U);
+    ASSERT_EQ(stats.unhinted, 0U);
+    ASSERT_EQ(stats.size, 0U);
+
+    // Evicted files can be prefetched again
+    prefetcher.prefetch("red.png");
+    prefetcher.prefetch("blue.png");
+    prefetcher.wait();
+    prefetcher.prefetch("red.png");
+    prefetcher.wait();
+    ASSERT_EQ(prefetcher.take("red.png").size(), 74U);
+    ASSERT_EQ(prefetcher.stats().evictions, 3U);
+}
+
+TEST(PrefetcherTest, IgnoresMissingFiles)
+{
+    ScopedAssetsDirectory scoped_assets{"FileTest_SeeksInFile"};
+    Prefetcher prefetcher;
+
+    prefetcher.prefetch("missing");
+    prefetcher.wait();
+    ASSERT_EQ(prefetcher.stats().size, 0U);
+    ASSERT_FALSE(prefetcher.take("missing"));
+    ASSERT_EQ(prefetcher.stats().misses, 1U);
+}
+
+TEST(PrefetcherTest, ClearsCache)
+{
+    ScopedAssetsDirectory scoped_assets{"FileTest_SeeksInFile"};
+    Prefetcher prefetcher;
+
+    prefetcher.prefetch("file");
+    prefetcher.wait();
+    prefetcher.clear();
+
+    ASSERT_EQ(prefetcher.stats().size, 0U);
+    ASSERT_FALSE(prefetcher.take("file"));
+}
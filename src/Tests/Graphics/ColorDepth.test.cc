@@ -0,0 +1,160 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Graphics/ColorDepth.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Graphics/Mipmap.h"
+#include "Tests/TestHelpers.h"
+
+using rainbow::Image;
+using rainbow::graphics::Dithering;
+using rainbow::graphics::reduce_color_depth;
+using rainbow::test::make_image;
+
+namespace
+{
+    auto fill(uint8_t value)
+    {
+        return [value](size_t) { return value; };
+    }
+
+    auto pixels(const Image& image)
+    {
+        std::vector<uint16_t> result(image.size / sizeof(uint16_t));
+        memcpy(result.data(), image.data, image.size);
+        return result;
+    }
+
+    /// <summary>
+    ///   Returns the average red value of an RGBA4444 image, scaled back up
+    ///   to 8 bits.
+    /// </summary>
+    auto average_red(const Image& image)
+    {
+        const auto packed = pixels(image);
+        double sum = 0.0;
+        for (auto p : packed)
+            sum += (p >> 12) * 17;
+        return sum / packed.size();
+    }
+}  // namespace
+
+TEST(ColorDepthTest, ReturnsUnsupportedImagesAsIs)
+{
+    constexpr uint8_t kPixels[]{1, 2, 3, 4};
+
+    const auto image = reduce_color_depth(
+        make_image(1, 1, 4, kPixels), Image::Packing::None, Dithering::None);
+    ASSERT_EQ(image.depth, 32U);
+    ASSERT_EQ(image.packing, Image::Packing::None);
+
+    const auto compressed = reduce_color_depth(
+        Image{Image::Format::BC1, 4, 4, 4, 3, sizeof(kPixels), kPixels},
+        Image::Packing::RGB565,
+        Dithering::None);
+    ASSERT_EQ(compressed.format, Image::Format::BC1);
+    ASSERT_EQ(compressed.data, kPixels);
+    ASSERT_EQ(compressed.packing, Image::Packing::None);
+}
+
+TEST(ColorDepthTest, PacksRGBA4444)
+{
+    constexpr uint8_t kPixels[]{
+        255, 0,   136, 255,  //
+        0,   255, 0,   0,    //
+    };
+
+    const auto image = reduce_color_depth(make_image(2, 1, 4, kPixels),
+                                          Image::Packing::RGBA4444,
+                                          Dithering::None);
+    ASSERT_EQ(image.format, Image::Format::PNG);
+    ASSERT_EQ(image.packing, Image::Packing::RGBA4444);
+    ASSERT_EQ(image.depth, 16U);
+    ASSERT_EQ(image.channels, 4U);
+    ASSERT_EQ(image.size, 4U);
+    ASSERT_EQ(pixels(image), (std::vector<uint16_t>{0xf08f, 0x0f00}));
+}
+
+TEST(ColorDepthTest, PacksRGB565)
+{
+    constexpr uint8_t kPixels[]{
+        255, 0,   0,   0,    //
+        0,   255, 0,   255,  //
+        0,   0,   255, 128,  //
+    };
+
+    const auto image = reduce_color_depth(
+        make_image(3, 1, 4, kPixels), Image::Packing::RGB565, Dithering::None);
+    ASSERT_EQ(image.packing, Image::Packing::RGB565);
+    ASSERT_EQ(image.channels, 3U);
+    ASSERT_EQ(pixels(image), (std::vector<uint16_t>{0xf800, 0x07e0, 0x001f}));
+}
+
+TEST(ColorDepthTest, PacksRGBA5551WithoutDitheringAlpha)
+{
+    constexpr uint8_t kPixels[]{
+        255, 255, 255, 127,  //
+        255, 255, 255, 128,  //
+        0,   0,   0,   127,  //
+        0,   0,   0,   128,  //
+    };
+
+    for (auto dithering : {Dithering::None,
+                           Dithering::Ordered,
+                           Dithering::FloydSteinberg}) {
+        const auto image = reduce_color_depth(
+            make_image(2, 2, 4, kPixels), Image::Packing::RGBA5551, dithering);
+        ASSERT_EQ(image.packing, Image::Packing::RGBA5551);
+        ASSERT_EQ(pixels(image),
+                  (std::vector<uint16_t>{0xfffe, 0xffff, 0x0000, 0x0001}));
+    }
+}
+
+TEST(ColorDepthTest, DitheringPreservesAverageColor)
+{
+    // 100 lies between 4-bit levels 85 and 102; rounding alone always picks
+    // the latter.
+    const auto rounded = reduce_color_depth(make_image(8, 8, 4, fill(100)),
+                                            Image::Packing::RGBA4444,
+                                            Dithering::None);
+    ASSERT_DOUBLE_EQ(average_red(rounded), 102.0);
+
+    for (auto dithering : {Dithering::Ordered, Dithering::FloydSteinberg}) {
+        const auto image = reduce_color_depth(make_image(8, 8, 4, fill(100)),
+                                              Image::Packing::RGBA4444,
+                                              dithering);
+        ASSERT_NEAR(average_red(image), 100.0, 1.0);
+
+        const auto packed = pixels(image);
+        ASSERT_NE(std::count(packed.begin(), packed.end(), packed[0]),
+                  static_cast<ptrdiff_t>(packed.size()));
+    }
+}
+
+TEST(ColorDepthTest, PacksAllMipmapLevels)
+{
+    const auto image = reduce_color_depth(
+        rainbow::graphics::generate_mipmaps(make_image(4, 2, 4, fill(255))),
+        Image::Packing::RGBA4444,
+        Dithering::Ordered);
+    ASSERT_EQ(image.levels, 3U);
+    ASSERT_EQ(image.size, (8U + 2U + 1U) * sizeof(uint16_t));
+    ASSERT_EQ(image.mipmaps[0].offset, 0U);
+    ASSERT_EQ(image.mipmaps[0].size, 16U);
+    ASSERT_EQ(image.mipmaps[1].offset, 16U);
+    ASSERT_EQ(image.mipmaps[1].size, 4U);
+    ASSERT_EQ(image.mipmaps[2].offset, 20U);
+    ASSERT_EQ(image.mipmaps[2].size, 2U);
+
+    const auto packed = pixels(image);
+    ASSERT_TRUE(std::all_of(packed.begin(), packed.end(), [](uint16_t p) {
+        return p == 0xffff;
+    }));
+}
@@ -62,6 +62,39 @@ TEST(DecodersTest, DetectsPVRTC)
 }
 #endif  // USE_PVRTC
 
+namespace ktx
+{
+    extern bool check(const Data& data);
+}
+
+TEST(DecodersTest, DetectsKTX)
+{
+    constexpr uint8_t kKTX1Signature[]{
+        0xab, 'K', 'T', 'X', ' ', '1', '1', 0xbb, '\r', '\n', 0x1a, '\n'};
+    constexpr uint8_t kKTX2Signature[]{
+        0xab, 'K', 'T', 'X', ' ', '2', '0', 0xbb, '\r', '\n', 0x1a, '\n'};
+    constexpr uint8_t kNotKTXSignature[]{
+        0xab, 'K', 'T', 'X', ' ', '3', '0', 0xbb, '\r', '\n', 0x1a, '\n'};
+
+    ASSERT_TRUE(ktx::check(Data::from_bytes(kKTX1Signature)));
+    ASSERT_TRUE(ktx::check(Data::from_bytes(kKTX2Signature)));
+    ASSERT_FALSE(ktx::check(Data::from_bytes(kNotKTXSignature)));
+}
+
+namespace qoi
+{
+    extern bool check(const Data& data);
+}
+
+TEST(DecodersTest, DetectsQOI)
+{
+    constexpr uint8_t kNotQOISignature[]{'f', 'i', 'o', 'q'};
+    constexpr uint8_t kQOISignature[]{'q', 'o', 'i', 'f'};
+
+    ASSERT_TRUE(qoi::check(Data::from_bytes(kQOISignature)));
+    ASSERT_FALSE(qoi::check(Data::from_bytes(kNotQOISignature)));
+}
+
 namespace svg
 {
     extern bool check(const Data& data);
@@ -4,12 +4,22 @@
 
 #include "Graphics/Image.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
 #include <gtest/gtest.h>
 
 #include "Common/Algorithm.h"
 #include "Common/Data.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileStream.h"
+#include "FileSystem/FileSystem.h"
 #include "Graphics/OpenGL.h"
+#include "Memory/Array.h"
 #include "Resources/Rainbow.svg.h"
+#include "Tests/TestHelpers.h"
 #include "Tests/__fixtures/ImageTest/Images.h"
 
 using namespace rainbow;
@@ -92,6 +102,173 @@ TEST(ImageTest, LoadsPNGs_32BitColor)
     ASSERT_EQ(image.size, image.width * image.height * 4U);
 }
 
+TEST(ImageTest, LoadsPNGsFromStream)
+{
+    ScopedAssetsDirectory scoped_assets{"ImageTest"};
+
+    constexpr czstring kImageFile = "image.png";
+    for (auto&& fixture : {ArrayView<uint8_t>{fixtures::basn4a08_png},
+                           ArrayView<uint8_t>{fixtures::basn6a08_png}}) {
+        const Data data{
+            fixture.data(), fixture.size(), Data::Ownership::Reference};
+        ASSERT_EQ(WriteableFile::write(kImageFile, data), data.size());
+
+        // Use a small chunk size to make sure the decoder is fed piecemeal
+        FileStream stream{kImageFile, FileType::Asset, 64};
+        auto image = Image::decode(stream);
+        auto expected = Image::decode(data, 1.0F);
+
+        ASSERT_EQ(image.format, Image::Format::PNG);
+        ASSERT_EQ(image.width, expected.width);
+        ASSERT_EQ(image.height, expected.height);
+        ASSERT_EQ(image.depth, expected.depth);
+        ASSERT_EQ(image.channels, expected.channels);
+        ASSERT_EQ(image.size, expected.size);
+        ASSERT_TRUE(
+            std::equal(image.data, image.data + image.size, expected.data));
+        ASSERT_TRUE(stream.eof());
+    }
+
+    // Other formats are left untouched
+    const Data qoi{fixtures::qoiops_qoi.data(),
+                   fixtures::qoiops_qoi.size(),
+                   Data::Ownership::Reference};
+    ASSERT_EQ(WriteableFile::write(kImageFile, qoi), qoi.size());
+
+    FileStream stream{kImageFile, FileType::Asset, 64};
+    auto image = Image::decode(stream);
+    ASSERT_EQ(image.format, Image::Format::Unknown);
+    ASSERT_EQ(image.data, nullptr);
+    ASSERT_EQ(stream.tell(), 0U);
+
+    ASSERT_TRUE(filesystem::remove(kImageFile));
+}
+
+TEST(ImageTest, LoadsQOIs)
+{
+    auto png = Image::decode({fixtures::qoiops_png.data(),
+                              fixtures::qoiops_png.size(),
+                              Data::Ownership::Reference},
+                             1.0F);
+    auto image = Image::decode({fixtures::qoiops_qoi.data(),
+                                fixtures::qoiops_qoi.size(),
+                                Data::Ownership::Reference},
+                               1.0F);
+
+    ASSERT_EQ(image.format, Image::Format::QOI);
+    ASSERT_EQ(image.width, 16U);
+    ASSERT_EQ(image.height, 16U);
+    ASSERT_EQ(image.depth, 32U);
+    ASSERT_EQ(image.channels, 4U);
+    ASSERT_EQ(image.size, image.width * image.height * 4U);
+    ASSERT_EQ(image.size, png.size);
+    ASSERT_TRUE(std::equal(image.data, image.data + image.size, png.data));
+}
+
+TEST(ImageTest, RejectsTruncatedQOIs)
+{
+    auto image = Image::decode({fixtures::qoiops_qoi.data(),
+                                14,
+                                Data::Ownership::Reference},
+                               1.0F);
+
+    ASSERT_EQ(image.format, Image::Format::QOI);
+    ASSERT_EQ(image.data, nullptr);
+}
+
+// Run with --gtest_also_run_disabled_tests to compare decode times.
+TEST(ImageTest, DISABLED_BenchmarkPNGAndQOIDecode)
+{
+    constexpr int kIterations = 10000;
+
+    const auto benchmark = [](const auto& fixture) {
+        const Data data{fixture.data(),
+                        fixture.size(),
+                        Data::Ownership::Reference};
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kIterations; ++i) {
+            auto image = Image::decode(data, 1.0F);
+            ASSERT_NE(image.data, nullptr);
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        printf("%lld ns/image\n",
+               static_cast<long long>(
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                       .count() /
+                   kIterations));
+    };
+
+    printf("PNG: ");
+    benchmark(fixtures::qoiops_png);
+    printf("QOI: ");
+    benchmark(fixtures::qoiops_qoi);
+}
+
+TEST(ImageTest, LoadsKTXs)
+{
+    for (auto&& fixture : {ArrayView<uint8_t>{fixtures::etc2_ktx},
+                           ArrayView<uint8_t>{fixtures::etc2_ktx2}}) {
+        const Data data{fixture.data(),
+                        fixture.size(),
+                        Data::Ownership::Reference};
+        auto image = Image::decode(data, 1.0F);
+
+        ASSERT_EQ(image.format, Image::Format::ETC2);
+        ASSERT_EQ(image.width, 4U);
+        ASSERT_EQ(image.height, 4U);
+        ASSERT_EQ(image.channels, 3U);
+        ASSERT_EQ(image.levels, 3U);
+        ASSERT_EQ(image.size, 24U);
+
+        // Levels must reference the original data
+        ASSERT_GE(image.data, data.bytes());
+        for (uint32_t i = 0; i < image.levels; ++i) {
+            const auto& level = image.mipmaps[i];
+            ASSERT_EQ(level.size, 8U);
+            ASSERT_LE(image.data + level.offset + level.size,
+                      data.bytes() + data.size());
+            ASSERT_TRUE(std::all_of(image.data + level.offset,
+                                    image.data + level.offset + level.size,
+                                    [i](uint8_t b) { return b == 0x10 + i; }));
+        }
+    }
+}
+
+TEST(ImageTest, RejectsTruncatedKTXs)
+{
+    for (auto&& fixture : {ArrayView<uint8_t>{fixtures::etc2_ktx},
+                           ArrayView<uint8_t>{fixtures::etc2_ktx2}}) {
+        auto image = Image::decode(
+            {fixture.data(), fixture.size() - 1, Data::Ownership::Reference},
+            1.0F);
+
+        ASSERT_EQ(image.format, Image::Format::Unknown);
+        ASSERT_EQ(image.data, nullptr);
+    }
+}
+
+TEST(ImageTest, RejectsOneDimensionalKTXs)
+{
+    // Offset of `pixel_height` in the KTX and KTX2 headers, respectively
+    constexpr size_t kKTX1PixelHeight = 40;
+    constexpr size_t kKTX2PixelHeight = 24;
+
+    auto ktx1 = fixtures::etc2_ktx;
+    memset(ktx1.data() + kKTX1PixelHeight, 0, sizeof(uint32_t));
+    auto ktx2 = fixtures::etc2_ktx2;
+    memset(ktx2.data() + kKTX2PixelHeight, 0, sizeof(uint32_t));
+
+    for (auto&& fixture :
+         {ArrayView<uint8_t>{ktx1}, ArrayView<uint8_t>{ktx2}}) {
+        auto image = Image::decode(
+            {fixture.data(), fixture.size(), Data::Ownership::Reference},
+            1.0F);
+
+        ASSERT_EQ(image.format, Image::Format::Unknown);
+        ASSERT_EQ(image.data, nullptr);
+    }
+}
+
 TEST(ImageTest, LoadsSVGs)
 {
     auto image = Image::decode(
@@ -0,0 +1,218 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Graphics/ImageCache.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iterator>
+
+#include <gtest/gtest.h>
+
+#include "Common/Data.h"
+#include "Common/Hash.h"
+#include "FileSystem/FileSystem.h"
+#include "Graphics/ColorDepth.h"
+#include "Graphics/Image.h"
+#include "Graphics/Mipmap.h"
+#include "Tests/TestHelpers.h"
+
+using rainbow::Data;
+using rainbow::Image;
+using rainbow::graphics::Dithering;
+using rainbow::graphics::generate_mipmaps;
+using rainbow::graphics::ImageCache;
+using rainbow::test::fixture_path;
+using rainbow::test::make_image;
+
+namespace
+{
+    auto pattern(size_t i)
+    {
+        return static_cast<uint8_t>(i * 7);
+    }
+
+    auto decode(const rainbow::MemoryMappedFile& file)
+    {
+        return Image::decode(
+            {file.data(), file.size(), Data::Ownership::Reference}, 1.0F);
+    }
+}  // namespace
+
+TEST(ImageCacheTest, KeysDependOnDataAndParameters)
+{
+    constexpr uint8_t kSource[]{1, 2, 3, 4};
+    constexpr uint8_t kOtherSource[]{1, 2, 3, 5};
+    const auto source = Data::from_bytes(kSource);
+
+    const auto key = ImageCache::key(source, 1.0F, false);
+    ASSERT_EQ(ImageCache::key(source, 1.0F, false), key);
+    ASSERT_EQ(ImageCache::key(rainbow::fnv1a(kSource, sizeof(kSource)),
+                              1.0F,
+                              false),
+              key);
+    ASSERT_NE(ImageCache::key(Data::from_bytes(kOtherSource), 1.0F, false),
+              key);
+    ASSERT_NE(ImageCache::key(source, 2.0F, false), key);
+    ASSERT_NE(ImageCache::key(source, 1.0F, true), key);
+    ASSERT_NE(ImageCache::key(
+                  source, 1.0F, false, Image::Packing::RGB565, Dithering::None),
+              key);
+    ASSERT_NE(ImageCache::key(source,
+                              1.0F,
+                              false,
+                              Image::Packing::RGB565,
+                              Dithering::Ordered),
+              ImageCache::key(source,
+                              1.0F,
+                              false,
+                              Image::Packing::RGB565,
+                              Dithering::None));
+}
+
+TEST(ImageCacheTest, StoresDecodedImages)
+{
+    constexpr uint64_t kKey = 0x1337;
+
+    const ImageCache cache{fixture_path("ImageCacheTest")};
+    cache.erase(kKey);
+    ASSERT_FALSE(cache.find(kKey));
+
+    const auto image = make_image(3, 5, 4, pattern);
+    ASSERT_TRUE(cache.store(kKey, image));
+
+    const auto file = cache.find(kKey);
+    ASSERT_TRUE(file);
+
+    const auto cached = decode(file);
+    ASSERT_EQ(cached.format, Image::Format::RGBA);
+    ASSERT_EQ(cached.width, image.width);
+    ASSERT_EQ(cached.height, image.height);
+    ASSERT_EQ(cached.channels, image.channels);
+    ASSERT_EQ(cached.size, image.size);
+    ASSERT_TRUE(std::equal(image.data, image.data + image.size, cached.data));
+
+    // Pixels must be mapped, not copied
+    ASSERT_GE(cached.data, file.data());
+    ASSERT_LE(cached.data + cached.size, file.data() + file.size());
+
+    cache.erase(kKey);
+    ASSERT_FALSE(cache.find(kKey));
+}
+
+TEST(ImageCacheTest, StoresMipmaps)
+{
+    constexpr uint64_t kKey = 0x1338;
+
+    const ImageCache cache{fixture_path("ImageCacheTest")};
+    const auto image = generate_mipmaps(make_image(4, 2, 2, pattern));
+    ASSERT_EQ(image.levels, 3U);
+    ASSERT_TRUE(cache.store(kKey, image));
+
+    const auto file = cache.find(kKey);
+    const auto cached = decode(file);
+    ASSERT_EQ(cached.format, Image::Format::RGBA);
+    ASSERT_EQ(cached.channels, 2U);
+    ASSERT_EQ(cached.depth, 16U);
+    ASSERT_EQ(cached.levels, image.levels);
+    ASSERT_EQ(cached.size, image.size);
+    for (uint32_t i = 0; i < image.levels; ++i) {
+        const auto& expected = image.mipmaps[i];
+        const auto& actual = cached.mipmaps[i];
+        ASSERT_EQ(actual.size, expected.size);
+        ASSERT_TRUE(std::equal(image.data + expected.offset,
+                               image.data + expected.offset + expected.size,
+                               cached.data + actual.offset));
+    }
+
+    cache.erase(kKey);
+}
+
+TEST(ImageCacheTest, StoresPackedImages)
+{
+    constexpr uint64_t kKey = 0x133a;
+
+    const ImageCache cache{fixture_path("ImageCacheTest")};
+    const auto image =
+        rainbow::graphics::reduce_color_depth(make_image(3, 3, 4, pattern),
+                                              Image::Packing::RGBA5551,
+                                              Dithering::None);
+    ASSERT_TRUE(cache.store(kKey, image));
+
+    const auto file = cache.find(kKey);
+    const auto cached = decode(file);
+    ASSERT_EQ(cached.format, Image::Format::RGBA);
+    ASSERT_EQ(cached.packing, Image::Packing::RGBA5551);
+    ASSERT_EQ(cached.channels, 4U);
+    ASSERT_EQ(cached.depth, 16U);
+    ASSERT_EQ(cached.size, image.size);
+    ASSERT_TRUE(std::equal(image.data, image.data + image.size, cached.data));
+
+    cache.erase(kKey);
+}
+
+TEST(ImageCacheTest, IgnoresUnsupportedImages)
+{
+    constexpr uint64_t kKey = 0x1339;
+    constexpr uint8_t kPixels[16]{};
+
+    const ImageCache cache{fixture_path("ImageCacheTest")};
+    const Image compressed{
+        Image::Format::BC1, 4, 4, 4, 3, sizeof(kPixels), kPixels};
+    ASSERT_FALSE(cache.store(kKey, compressed));
+    ASSERT_FALSE(cache.find(kKey));
+}
+
+TEST(ImageCacheTest, RemovesImagesFromOtherVersions)
+{
+    const auto directory = fixture_path("ImageCacheTest");
+    const auto unrelated = directory / ".gitkeep";
+    const rainbow::filesystem::Path stale[]{
+        directory / "0000000000001337.ktx2",
+        directory / "0000000000001337.v1.ktx2",
+        directory / "0000000000001337.v2.ktx2.tmp0",
+    };
+    for (const auto& path : stale) {
+        auto file = std::fopen(path.c_str(), "wb");
+        ASSERT_NE(file, nullptr);
+        std::fclose(file);
+    }
+
+    const ImageCache cache{directory};
+    for (const auto& path : stale)
+        ASSERT_FALSE(rainbow::system::is_regular_file(path.c_str()));
+    ASSERT_TRUE(rainbow::system::is_regular_file(unrelated.c_str()));
+}
+
+TEST(ImageCacheTest, StaysWithinBudget)
+{
+    constexpr uint64_t kKeys[]{0x1340, 0x1341, 0x1342, 0x1343, 0x1344, 0x1345};
+
+    const auto image = make_image(3, 5, 4, pattern);
+    uint64_t image_size = 0;
+    {
+        const ImageCache cache{fixture_path("ImageCacheTest")};
+        for (auto key : kKeys)
+            cache.erase(key);
+
+        const auto size = cache.size();
+        ASSERT_TRUE(cache.store(kKeys[0], image));
+        image_size = cache.size() - size;
+        cache.erase(kKeys[0]);
+    }
+
+    const auto budget = image_size * 4;
+    const ImageCache cache{fixture_path("ImageCacheTest"), budget};
+    for (auto key : kKeys) {
+        ASSERT_TRUE(cache.store(key, image));
+        ASSERT_LE(cache.size(), budget);
+    }
+
+    // Least recently used images are removed first
+    ASSERT_FALSE(cache.find(kKeys[0]));
+    ASSERT_TRUE(cache.find(kKeys[std::size(kKeys) - 1]));
+
+    for (auto key : kKeys)
+        cache.erase(key);
+}
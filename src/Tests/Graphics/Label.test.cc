@@ -0,0 +1,36 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Graphics/Label.h"
+
+#include <gtest/gtest.h>
+
+#include "Tests/TestHelpers.h"
+#include "Text/Typesetter.h"
+
+using rainbow::ISolemnlySwearThatIAmOnlyTesting;
+using rainbow::Label;
+using rainbow::Typesetter;
+
+TEST(LabelTest, LaysOutTextAgainWhenFontIsReloaded)
+{
+    Typesetter typesetter;
+    Label label{ISolemnlySwearThatIAmOnlyTesting{}};
+    label.text("Hello, world!");
+
+    // Glyphs are queued for rasterisation on the first layout
+    ASSERT_TRUE(label.update_vertices(typesetter));
+    const auto length = label.length();
+    ASSERT_GT(length, 0U);
+
+    // Saving waits for all glyphs to be rasterised
+    [[maybe_unused]] auto atlas = typesetter.font_cache().save();
+    ASSERT_TRUE(label.update_vertices(typesetter));
+    ASSERT_FALSE(label.update_vertices(typesetter));
+
+    ASSERT_TRUE(typesetter.font_cache().reload(label.font()));
+    ASSERT_TRUE(label.update_vertices(typesetter));
+    ASSERT_EQ(label.length(), length);
+    ASSERT_FALSE(label.update_vertices(typesetter));
+}
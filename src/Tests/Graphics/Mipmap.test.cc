@@ -0,0 +1,86 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Graphics/Mipmap.h"
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include "Graphics/Image.h"
+#include "Tests/TestHelpers.h"
+
+using rainbow::Image;
+using rainbow::graphics::generate_mipmaps;
+using rainbow::graphics::mipmap_levels;
+using rainbow::test::make_image;
+
+TEST(MipmapTest, CountsLevels)
+{
+    ASSERT_EQ(mipmap_levels(1, 1), 1U);
+    ASSERT_EQ(mipmap_levels(2, 2), 2U);
+    ASSERT_EQ(mipmap_levels(3, 1), 2U);
+    ASSERT_EQ(mipmap_levels(256, 128), 9U);
+}
+
+TEST(MipmapTest, WeightsColorsByAlpha)
+{
+    constexpr uint8_t kPixels[]{
+        255, 0, 0, 255,  0, 0, 0, 0,  //
+        0,   0, 0, 0,    0, 0, 0, 0,  //
+    };
+
+    auto image = generate_mipmaps(make_image(2, 2, 4, kPixels));
+    ASSERT_EQ(image.levels, 2U);
+    ASSERT_EQ(image.size, sizeof(kPixels) + 4);
+    ASSERT_EQ(image.mipmaps[0].offset, 0U);
+    ASSERT_EQ(image.mipmaps[0].size, sizeof(kPixels));
+    ASSERT_EQ(image.mipmaps[1].offset, sizeof(kPixels));
+    ASSERT_EQ(image.mipmaps[1].size, 4U);
+    ASSERT_TRUE(std::equal(kPixels, kPixels + sizeof(kPixels), image.data));
+
+    const auto level1 = image.data + sizeof(kPixels);
+    ASSERT_EQ(level1[0], 255);
+    ASSERT_EQ(level1[1], 0);
+    ASSERT_EQ(level1[2], 0);
+    ASSERT_EQ(level1[3], 64);
+}
+
+TEST(MipmapTest, AveragesFullyTransparentTexels)
+{
+    constexpr uint8_t kPixels[]{
+        200, 100, 0, 0,  0, 100, 200, 0,  //
+    };
+
+    auto image = generate_mipmaps(make_image(2, 1, 4, kPixels));
+    ASSERT_EQ(image.levels, 2U);
+
+    const auto level1 = image.data + sizeof(kPixels);
+    ASSERT_EQ(level1[0], 100);
+    ASSERT_EQ(level1[1], 100);
+    ASSERT_EQ(level1[2], 100);
+    ASSERT_EQ(level1[3], 0);
+}
+
+TEST(MipmapTest, SupportsLuminanceAlpha)
+{
+    constexpr uint8_t kPixels[]{100, 255, 0, 0};
+
+    auto image = generate_mipmaps(make_image(2, 1, 2, kPixels));
+    ASSERT_EQ(image.levels, 2U);
+    ASSERT_EQ(image.size, sizeof(kPixels) + 2);
+
+    const auto level1 = image.data + sizeof(kPixels);
+    ASSERT_EQ(level1[0], 100);
+    ASSERT_EQ(level1[1], 128);
+}
+
+TEST(MipmapTest, IgnoresUnsupportedFormats)
+{
+    constexpr uint8_t kPixels[]{255, 0, 0, 0, 255, 0};
+
+    auto image = generate_mipmaps(make_image(2, 1, 3, kPixels));
+    ASSERT_EQ(image.levels, 1U);
+    ASSERT_EQ(image.size, sizeof(kPixels));
+}
@@ -0,0 +1,217 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Graphics/TextBatch.h"
+
+#include <algorithm>
+#include <cstddef>
+
+#include <gtest/gtest.h>
+
+#include "Graphics/Label.h"
+#include "Tests/TestHelpers.h"
+#include "Text/Typesetter.h"
+
+using rainbow::ISolemnlySwearThatIAmOnlyTesting;
+using rainbow::Label;
+using rainbow::SpriteVertex;
+using rainbow::TextBatch;
+using rainbow::Typesetter;
+
+namespace
+{
+    auto is_degenerate(const SpriteVertex& vertex)
+    {
+        return vertex.color == rainbow::Color{} &&
+               vertex.texcoord == rainbow::Vec2f::Zero &&
+               vertex.position == rainbow::Vec2f::Zero;
+    }
+
+    /// <summary>
+    ///   Returns the index of the first vertex of <paramref name="label"/> in
+    ///   the batch, or -1 if it is not there.
+    /// </summary>
+    auto offset_of(const TextBatch& batch, const Label& label) -> ptrdiff_t
+    {
+        const auto& vertices = batch.vertices();
+        const auto& label_vertices = label.vertices();
+        const auto i = std::search(
+            vertices.cbegin(),
+            vertices.cend(),
+            label_vertices.cbegin(),
+            label_vertices.cend(),
+            [](const SpriteVertex& lhs, const SpriteVertex& rhs) {
+                return lhs.color == rhs.color &&
+                       lhs.texcoord == rhs.texcoord &&
+                       lhs.position == rhs.position;
+            });
+        return i == vertices.cend() ? -1 : i - vertices.cbegin();
+    }
+
+    class TextBatchTest : public ::testing::Test
+    {
+    public:
+        TextBatchTest()
+            : batch(ISolemnlySwearThatIAmOnlyTesting{}),
+              alpha(ISolemnlySwearThatIAmOnlyTesting{}),
+              bravo(ISolemnlySwearThatIAmOnlyTesting{}),
+              charlie(ISolemnlySwearThatIAmOnlyTesting{})
+        {
+        }
+
+    protected:
+        Typesetter typesetter;
+        TextBatch batch;
+        Label alpha;
+        Label bravo;
+        Label charlie;
+
+        void update()
+        {
+            // Saving waits for all glyphs to be rasterised, so that labels
+            // are fully laid out on the second update.
+            batch.update_vertices(typesetter);
+            [[maybe_unused]] auto atlas = typesetter.font_cache().save();
+            batch.update_vertices(typesetter);
+        }
+    };
+}  // namespace
+
+TEST_F(TextBatchTest, AddsLabels)
+{
+    alpha.text("Alpha");
+    bravo.text("Bravo");
+    batch.add(alpha);
+    batch.add(bravo);
+    ASSERT_EQ(batch.size(), 2U);
+
+    update();
+
+    ASSERT_GT(alpha.vertices().size(), 0U);
+    ASSERT_GT(bravo.vertices().size(), 0U);
+    ASSERT_EQ(offset_of(batch, alpha), 0);
+
+    // Each label is given some room to grow
+    const auto offset = offset_of(batch, bravo);
+    ASSERT_GT(offset, static_cast<ptrdiff_t>(alpha.vertices().size()));
+    const auto& vertices = batch.vertices();
+    ASSERT_TRUE(std::all_of(vertices.cbegin() + alpha.vertices().size(),
+                            vertices.cbegin() + offset,
+                            is_degenerate));
+}
+
+TEST_F(TextBatchTest, GrowsLastLabelInPlace)
+{
+    alpha.text("Alpha");
+    bravo.text("Bravo");
+    batch.add(alpha);
+    batch.add(bravo);
+    update();
+
+    const auto offset = offset_of(batch, bravo);
+    bravo.text("BravoBravoBravo");
+    update();
+
+    ASSERT_EQ(offset_of(batch, alpha), 0);
+    ASSERT_EQ(offset_of(batch, bravo), offset);
+    ASSERT_GE(batch.vertices().size() - offset, bravo.vertices().size());
+}
+
+TEST_F(TextBatchTest, RelocatesLabelsThatOutgrowTheirRange)
+{
+    alpha.text("Alpha");
+    bravo.text("BravoBravoBravo");
+    batch.add(alpha);
+    batch.add(bravo);
+    update();
+
+    const auto length = alpha.vertices().size();
+    const auto offset = offset_of(batch, bravo);
+    alpha.text("AlphaAlpha");
+    update();
+
+    // The old range is cleared, and the label is moved to the end
+    ASSERT_TRUE(std::all_of(batch.vertices().cbegin(),
+                            batch.vertices().cbegin() + length,
+                            is_degenerate));
+    ASSERT_EQ(offset_of(batch, bravo), offset);
+    ASSERT_GT(offset_of(batch, alpha), offset);
+}
+
+TEST_F(TextBatchTest, HidesLeftoverGlyphsWhenLabelsShrink)
+{
+    alpha.text("AlphaAlpha");
+    bravo.text("BravoBravoBravoBravo");
+    batch.add(alpha);
+    batch.add(bravo);
+    update();
+
+    const auto length = alpha.vertices().size();
+    const auto offset = offset_of(batch, bravo);
+    alpha.text("Alpha");
+    update();
+
+    ASSERT_LT(alpha.vertices().size(), length);
+    ASSERT_EQ(offset_of(batch, alpha), 0);
+    ASSERT_EQ(offset_of(batch, bravo), offset);
+    const auto& vertices = batch.vertices();
+    ASSERT_TRUE(std::all_of(vertices.cbegin() + alpha.vertices().size(),
+                            vertices.cbegin() + length,
+                            is_degenerate));
+}
+
+TEST_F(TextBatchTest, RemovesAndCompactsLabels)
+{
+    alpha.text("Alpha");
+    bravo.text("BravoBravoBravo");
+    charlie.text("Charlie");
+    batch.add(alpha);
+    batch.add(bravo);
+    batch.add(charlie);
+    update();
+
+    const auto size = batch.vertices().size();
+    const auto offset = offset_of(batch, charlie);
+    batch.remove(bravo);
+    ASSERT_EQ(batch.size(), 2U);
+
+    // Removed labels are cleared immediately
+    ASSERT_EQ(offset_of(batch, bravo), -1);
+
+    // Space is reclaimed on the next update once most of it is unused
+    update();
+
+    ASSERT_LT(batch.vertices().size(), size);
+    ASSERT_EQ(offset_of(batch, alpha), 0);
+    ASSERT_GT(offset_of(batch, charlie), 0);
+    ASSERT_LT(offset_of(batch, charlie), offset);
+
+    // Removing a label that is not in the batch is a no-op
+    batch.remove(bravo);
+    ASSERT_EQ(batch.size(), 2U);
+}
+
+TEST_F(TextBatchTest, KeepsLabelsInOrder)
+{
+    alpha.text("Alpha");
+    bravo.text("Bravo");
+    charlie.text("CharlieCharlieCharlie");
+    batch.add(alpha);
+    batch.add(bravo);
+    batch.add(charlie);
+    update();
+
+    // Alpha outgrows its range and is moved behind the others
+    alpha.text("AlphaAlpha");
+    update();
+
+    ASSERT_GT(offset_of(batch, alpha), offset_of(batch, charlie));
+
+    // Compaction restores the order labels were added in
+    batch.remove(charlie);
+    update();
+
+    ASSERT_EQ(offset_of(batch, alpha), 0);
+    ASSERT_GT(offset_of(batch, bravo), offset_of(batch, alpha));
+}
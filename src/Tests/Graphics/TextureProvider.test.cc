@@ -4,17 +4,23 @@
 
 #include "Graphics/Texture.h"
 
+#include <chrono>
+#include <memory>
 #include <string_view>
+#include <thread>
 
 #include <gtest/gtest.h>
 
 #include "Common/Data.h"
+#include "FileSystem/FileSystem.h"
 #include "Graphics/Image.h"
+#include "Graphics/ImageCache.h"
 #include "Tests/TestHelpers.h"
 #include "Tests/__fixtures/ImageTest/Images.h"
 
 using namespace rainbow::graphics;
 using namespace rainbow::test;
+using namespace std::literals::chrono_literals;
 using namespace std::literals::string_view_literals;
 
 using rainbow::Data;
@@ -128,6 +134,103 @@ TEST(TextureProviderTest, ReferenceCounts)
     ASSERT_EQ(allocator.released, allocator.current_id);
 }
 
+TEST(TextureProviderTest, AsyncTexturesFallBackUntilReady)
+{
+    MockTextureAllocator allocator;
+    {
+        TextureProvider provider{allocator};
+
+        auto tex1 = provider.get_async("rainbow://does-not-exist-1.png");
+        ASSERT_TRUE(tex1);
+        ASSERT_FALSE(tex1.is_ready());
+        ASSERT_EQ(allocator.current_id, 1);
+
+        auto tex1_raw = provider.raw_get(tex1);
+        ASSERT_TRUE(tex1_raw.is_pending);
+        ASSERT_EQ(tex1_raw.width, 1U);
+        ASSERT_EQ(tex1_raw.height, 1U);
+        ASSERT_EQ(tex1_raw.use_count, 1U);
+
+        auto tex2 = provider.get_async("rainbow://does-not-exist-2.png");
+        ASSERT_FALSE(tex2.is_ready());
+        ASSERT_EQ(allocator.current_id, 1);
+        ASSERT_EQ(provider.raw_get(tex2).data[0], tex1_raw.data[0]);
+
+        // Releasing a pending texture must not destroy the fallback.
+        provider.release(tex2);
+        ASSERT_EQ(allocator.released, 0);
+
+        provider.update();
+        ASSERT_FALSE(tex1.is_ready());
+    }
+
+    ASSERT_EQ(allocator.released, 1);
+}
+
+TEST(TextureProviderTest, EvictsLeastRecentlyDrawnTextures)
+{
+    ScopedAssetsDirectory scoped_assets{"TextureProviderTest"};
+
+    MockTextureAllocator allocator;
+    TextureProvider provider{allocator};
+
+    auto red = provider.get("red.png");
+    auto blue = provider.get("blue.png");
+    ASSERT_TRUE(red.is_ready());
+    ASSERT_TRUE(blue.is_ready());
+
+    const auto [used, peak] = provider.memory_usage();
+    ASSERT_GT(used, 0U);
+    ASSERT_EQ(used, peak);
+
+    provider.set_memory_budget(used / 2);
+    provider.update();
+    ASSERT_EQ(provider.use(red)[0], provider.raw_get(red).data[0]);
+
+    // Only the texture that was not drawn in the previous frame is evicted.
+    provider.update();
+    ASSERT_TRUE(red.is_ready());
+    ASSERT_FALSE(blue.is_ready());
+    ASSERT_EQ(std::get<0>(provider.memory_usage()), used / 2);
+
+    // Evicted textures are reloaded when drawn.
+    ASSERT_NE(provider.use(blue)[0], 0);
+    for (int i = 0; i < 1000 && !blue.is_ready(); ++i) {
+        std::this_thread::sleep_for(1ms);
+        provider.update();
+    }
+    ASSERT_TRUE(blue.is_ready());
+
+    provider.update();
+    provider.update();
+    provider.purge();
+    ASSERT_FALSE(red.is_ready());
+    ASSERT_FALSE(blue.is_ready());
+    ASSERT_EQ(std::get<0>(provider.memory_usage()), 0U);
+}
+
+TEST(TextureProviderTest, EvictsStaleTexturesBeforePreloadedOnes)
+{
+    ScopedAssetsDirectory scoped_assets{"TextureProviderTest"};
+
+    MockTextureAllocator allocator;
+    TextureProvider provider{allocator};
+
+    auto red = provider.get("red.png");
+    provider.update();
+    ASSERT_EQ(provider.use(red)[0], provider.raw_get(red).data[0]);
+    for (int i = 0; i < 3; ++i)
+        provider.update();
+
+    // Textures loaded ahead of time count as used when they were loaded.
+    auto blue = provider.get("blue.png");
+    provider.set_memory_budget(std::get<0>(provider.memory_usage()) / 2);
+    provider.update();
+
+    ASSERT_FALSE(red.is_ready());
+    ASSERT_TRUE(blue.is_ready());
+}
+
 TEST(TextureProviderTest, GetsPreloadedTexture)
 {
     MockTextureAllocator allocator;
@@ -141,13 +244,231 @@ TEST(TextureProviderTest, GetsPreloadedTexture)
     ASSERT_TRUE(texture);
 }
 
+TEST(TextureProviderTest, PacksSmallImagesIntoSharedPages)
+{
+    ScopedAssetsDirectory scoped_assets{"TextureProviderTest"};
+
+    MockTextureAllocator allocator;
+    TextureProvider provider{allocator};
+
+    auto red = provider.get_packed("red.png");
+    auto blue = provider.get_packed("blue.png");
+    ASSERT_TRUE(red);
+    ASSERT_TRUE(blue);
+    ASSERT_EQ(allocator.current_id, 1);
+    ASSERT_EQ(provider.raw_get(red).data[0], provider.raw_get(blue).data[0]);
+    ASSERT_EQ(provider.raw_get(red).width, TextureProvider::kAtlasPageSize);
+
+    const auto r = red.region();
+    const auto b = blue.region();
+    ASSERT_EQ(r.width, 2.0F);
+    ASSERT_EQ(r.height, 2.0F);
+    ASSERT_EQ(b.width, 2.0F);
+    ASSERT_EQ(b.height, 2.0F);
+    ASSERT_TRUE(r.left + r.width < b.left || b.left + b.width < r.left ||
+                r.bottom + r.height < b.bottom ||
+                b.bottom + b.height < r.bottom);
+
+    // Pages are uploaded once per update, and only when changed
+    ASSERT_EQ(allocator.updated, 0);
+    provider.update();
+    ASSERT_EQ(allocator.updated, 1);
+    provider.update();
+    ASSERT_EQ(allocator.updated, 1);
+
+    Texture red2;
+    red2 = provider.get_packed("red.png");
+    ASSERT_EQ(allocator.current_id, 1);
+    ASSERT_EQ(red2.region().left, r.left);
+    ASSERT_EQ(red2.region().bottom, r.bottom);
+
+    // Unpacked textures span the whole texture
+    auto standalone = provider.get("red.png");
+    ASSERT_EQ(allocator.current_id, 2);
+    ASSERT_EQ(standalone.region().left, 0.0F);
+    ASSERT_EQ(standalone.region().bottom, 0.0F);
+    ASSERT_EQ(standalone.region().width, 2.0F);
+    ASSERT_EQ(standalone.region().height, 2.0F);
+}
+
+TEST(TextureProviderTest, ReloadsTextures)
+{
+    ScopedAssetsDirectory scoped_assets{"TextureProviderTest"};
+
+    MockTextureAllocator allocator;
+    TextureProvider provider{allocator};
+
+    ASSERT_FALSE(provider.reload("red.png"));
+
+    auto red = provider.get("red.png");
+    const auto handle = provider.raw_get(red).data[0];
+    const auto [used, peak] = provider.memory_usage();
+
+    ASSERT_TRUE(provider.reload("red.png"));
+
+    // The current texture stays bound until the new one is uploaded.
+    ASSERT_TRUE(red.is_ready());
+    ASSERT_EQ(provider.raw_get(red).data[0], handle);
+
+    for (int i = 0; i < 1000 && provider.raw_get(red).data[0] == handle;
+         ++i) {
+        std::this_thread::sleep_for(1ms);
+        provider.update();
+    }
+
+    ASSERT_TRUE(red.is_ready());
+    ASSERT_NE(provider.raw_get(red).data[0], handle);
+    ASSERT_EQ(allocator.released, 1);
+    ASSERT_EQ(provider.memory_usage(), std::make_tuple(used, peak));
+
+    ASSERT_FALSE(provider.reload("blue.png"));
+}
+
+TEST(TextureProviderTest, FailsToLoadTruncatedImages)
+{
+    ScopedAssetsDirectory scoped_assets{"TextureProviderTest"};
+
+    MockTextureAllocator allocator;
+    TextureProvider provider{allocator};
+
+    auto texture = provider.get("truncated.png");
+    ASSERT_EQ(provider.raw_get(texture).width, 0U);
+    ASSERT_EQ(provider.raw_get(texture).height, 0U);
+}
+
+TEST(TextureProviderTest, LoadsUnpackableImagesByPath)
+{
+    ScopedAssetsDirectory scoped_assets{"TextureProviderTest"};
+
+    MockTextureAllocator allocator;
+    TextureProvider provider{allocator};
+
+    // Images wider than the atlas allows get their own texture
+    auto wide = provider.get_packed("wide.png");
+    ASSERT_EQ(provider.raw_get(wide).width, 257U);
+    ASSERT_EQ(provider.raw_get(wide).height, 1U);
+    ASSERT_EQ(wide.region().width, 257.0F);
+    ASSERT_EQ(allocator.current_id, 1);
+
+    // ... which is keyed by its path so that it can be reloaded
+    auto same = provider.get("wide.png");
+    ASSERT_EQ(allocator.current_id, 1);
+    ASSERT_TRUE(provider.reload("wide.png"));
+}
+
+TEST(TextureProviderTest, SharesTexturesWithIdenticalContents)
+{
+    const auto pack = fixture_path("TextureProviderTest/textures.rpak");
+    ASSERT_TRUE(rainbow::filesystem::mount(pack.c_str()));
+
+    {
+        MockTextureAllocator allocator;
+        TextureProvider provider{allocator};
+
+        {
+            auto red = provider.get("a/red.png");
+            auto red_copy = provider.get_async("b/red.png");
+            ASSERT_EQ(allocator.current_id, 1);
+            ASSERT_TRUE(red_copy.is_ready());
+            ASSERT_EQ(provider.raw_get(red_copy).data[0],
+                      provider.raw_get(red).data[0]);
+
+            auto blue = provider.get("blue.png");
+            ASSERT_EQ(allocator.current_id, 2);
+        }
+
+        // Released textures are no longer shared
+        ASSERT_EQ(allocator.released, 2);
+        auto red_copy = provider.get("b/red.png");
+        ASSERT_EQ(allocator.current_id, 3);
+    }
+
+    {
+        MockTextureAllocator allocator;
+        TextureProvider provider{allocator};
+
+        auto red = provider.get_packed("a/red.png");
+        auto red_copy = provider.get_packed("b/red.png");
+        ASSERT_EQ(allocator.current_id, 1);
+        ASSERT_EQ(red_copy.region().left, red.region().left);
+        ASSERT_EQ(red_copy.region().bottom, red.region().bottom);
+
+        auto blue = provider.get_packed("blue.png");
+        ASSERT_TRUE(blue.region().left != red.region().left ||
+                    blue.region().bottom != red.region().bottom);
+    }
+
+    ASSERT_TRUE(rainbow::filesystem::unmount(pack.c_str()));
+}
+
+TEST(TextureProviderTest, CachesImagesInPacksByContentHash)
+{
+    const auto pack = fixture_path("TextureProviderTest/textures.rpak");
+    ASSERT_TRUE(rainbow::filesystem::mount(pack.c_str()));
+
+    const auto content_hash = rainbow::filesystem::content_hash("blue.png");
+    ASSERT_TRUE(content_hash);
+
+    const auto key = ImageCache::key(*content_hash, 1.0F, false);
+    auto cache =
+        std::make_unique<ImageCache>(fixture_path("TextureProviderTest/cache"));
+    cache->erase(key);
+    const auto& image_cache = *cache;
+
+    {
+        MockTextureAllocator allocator;
+        TextureProvider provider{allocator};
+        provider.set_image_cache(std::move(cache));
+
+        // Images are streamed from the pack, and cached under their content
+        // hash, which is known without reading them
+        auto blue = provider.get("blue.png");
+        ASSERT_EQ(provider.raw_get(blue).width, 2U);
+        ASSERT_TRUE(image_cache.find(key));
+        image_cache.erase(key);
+
+        // Streaming decoders notice when an image is cut short
+        const auto truncated_pack =
+            fixture_path("TextureProviderTest/truncated.rpak");
+        ASSERT_TRUE(rainbow::filesystem::mount(truncated_pack.c_str()));
+
+        auto truncated = provider.get("truncated.png");
+        ASSERT_EQ(provider.raw_get(truncated).width, 0U);
+
+        ASSERT_TRUE(rainbow::filesystem::unmount(truncated_pack.c_str()));
+    }
+
+    ASSERT_TRUE(rainbow::filesystem::unmount(pack.c_str()));
+}
+
 TEST(TextureProviderTest, ReleasesNothing)
 {
     MockTextureAllocator allocator;
     TextureProvider provider{allocator};
     rainbow::ISolemnlySwearThatIAmOnlyTesting contract{};
-    provider.release(Texture{"", contract});
-    provider.release(Texture{"test", contract});
+    provider.release(Texture{0, 0, contract});
+    provider.release(Texture{42, 0, contract});
+}
+
+TEST(TextureProviderTest, RejectsStaleHandles)
+{
+    MockTextureAllocator allocator;
+    TextureProvider provider{allocator};
+
+    auto mock_image = Data::from_literal(kMockImageData);
+    auto texture = provider.get("test", mock_image);
+    ASSERT_TRUE(provider.is_ready(texture));
+
+    provider.release(texture);
+    ASSERT_EQ(allocator.released, 1);
+
+    // The slot is reused, but handles to the old texture must not see it.
+    auto texture2 = provider.get("test2", mock_image);
+    ASSERT_EQ(allocator.current_id, 2);
+    ASSERT_TRUE(provider.is_ready(texture2));
+    ASSERT_FALSE(provider.is_ready(texture));
+    ASSERT_FALSE(provider.try_get(texture));
+    ASSERT_EQ(provider.raw_get(texture2).use_count, 1U);
 }
 
 TEST(TextureProviderTest, TryGetDoesNotConstruct)
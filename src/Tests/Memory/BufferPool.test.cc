@@ -0,0 +1,121 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Memory/BufferPool.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/Data.h"
+
+using rainbow::Data;
+
+namespace buffer_pool = rainbow::buffer_pool;
+
+TEST(BufferPoolTest, ReusesReleasedBuffers)
+{
+    buffer_pool::clear();
+    const auto stats = buffer_pool::stats();
+    ASSERT_EQ(stats.size, 0U);
+
+    const void* first = nullptr;
+    {
+        auto data = Data::allocate(100);
+        ASSERT_EQ(data.size(), 100U);
+        ASSERT_EQ(data.bytes()[100], 0);
+        ASSERT_EQ(data.ownership(), Data::Ownership::Pooled);
+        first = data.bytes();
+    }
+
+    ASSERT_EQ(buffer_pool::stats().misses, stats.misses + 1);
+    ASSERT_GT(buffer_pool::stats().size, 0U);
+
+    // Buffers in the same size class are interchangeable
+    {
+        auto data = Data::allocate(120);
+        ASSERT_EQ(data.bytes(), first);
+        ASSERT_EQ(data.bytes()[120], 0);
+        ASSERT_EQ(buffer_pool::stats().size, 0U);
+    }
+
+    ASSERT_EQ(buffer_pool::stats().hits, stats.hits + 1);
+    ASSERT_EQ(buffer_pool::stats().misses, stats.misses + 1);
+
+    buffer_pool::clear();
+    ASSERT_EQ(buffer_pool::stats().size, 0U);
+}
+
+TEST(BufferPoolTest, SeparatesSizeClasses)
+{
+    buffer_pool::clear();
+    const auto stats = buffer_pool::stats();
+
+    Data::allocate(100);
+    auto data = Data::allocate(1000);
+
+    ASSERT_EQ(buffer_pool::stats().hits, stats.hits);
+    ASSERT_EQ(buffer_pool::stats().misses, stats.misses + 2);
+
+    buffer_pool::clear();
+}
+
+TEST(BufferPoolTest, DoesNotPoolLargeBuffers)
+{
+    buffer_pool::clear();
+    const auto stats = buffer_pool::stats();
+
+    Data::allocate(buffer_pool::kMaxPooledSize);
+
+    ASSERT_EQ(buffer_pool::stats().hits, stats.hits);
+    ASSERT_EQ(buffer_pool::stats().misses, stats.misses);
+    ASSERT_EQ(buffer_pool::stats().size, 0U);
+}
+
+TEST(BufferPoolTest, KeepsWithinBudget)
+{
+    buffer_pool::clear();
+
+    constexpr size_t kSize = buffer_pool::kMaxPooledSize - 1;
+    constexpr size_t kCount = buffer_pool::kBudget / kSize + 2;
+    {
+        std::vector<Data> buffers;
+        for (size_t i = 0; i < kCount; ++i)
+            buffers.push_back(Data::allocate(kSize));
+    }
+
+    ASSERT_LE(buffer_pool::stats().size, buffer_pool::kBudget);
+
+    buffer_pool::clear();
+    ASSERT_EQ(buffer_pool::stats().size, 0U);
+}
+
+TEST(BufferPoolTest, ReleasesMovedBuffersOnce)
+{
+    buffer_pool::clear();
+    const auto stats = buffer_pool::stats();
+
+    size_t size = 0;
+    {
+        auto data = Data::allocate(100);
+        {
+            Data moved{std::move(data)};
+            ASSERT_EQ(moved.ownership(), Data::Ownership::Pooled);
+        }
+        size = buffer_pool::stats().size;
+        ASSERT_GT(size, 0U);
+
+        auto other = Data::allocate(100);
+        Data assigned;
+        assigned = std::move(other);
+        ASSERT_EQ(buffer_pool::stats().size, 0U);
+        ASSERT_EQ(buffer_pool::stats().hits, stats.hits + 1);
+    }
+
+    // Moved-from buffers must not return anything to the pool
+    ASSERT_EQ(buffer_pool::stats().size, size);
+    ASSERT_EQ(buffer_pool::stats().hits, stats.hits + 1);
+
+    buffer_pool::clear();
+}
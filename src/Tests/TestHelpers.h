@@ -2,15 +2,57 @@
 // Distributed under the MIT License.
 // (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
 
+#include <cstdint>
 #include <cstdio>
+#include <memory>
 
-#include <physfs.h>
+#include <gtest/gtest.h>
 
 #include "FileSystem/Bundle.h"
 #include "FileSystem/FileSystem.h"
+#include "Graphics/Image.h"
 
 namespace rainbow::test
 {
+    /// <summary>
+    ///   Returns a decoded image with 8 bits per channel, where each byte is
+    ///   <c>pixel(i)</c> for its index <c>i</c>.
+    /// </summary>
+    template <typename F>
+    auto make_image(uint32_t width,
+                    uint32_t height,
+                    uint32_t channels,
+                    F&& pixel) -> Image
+    {
+        const size_t size = size_t{width} * height * channels;
+        auto buffer = std::make_unique<uint8_t[]>(size);
+        for (size_t i = 0; i < size; ++i)
+            buffer[i] = static_cast<uint8_t>(pixel(i));
+
+        return Image{Image::Format::PNG,
+                     width,
+                     height,
+                     channels * 8,
+                     channels,
+                     size,
+                     buffer.release()};
+    }
+
+    /// <summary>
+    ///   Returns a decoded image with 8 bits per channel, copied from
+    ///   <paramref name="pixels"/>.
+    /// </summary>
+    template <size_t N>
+    auto make_image(uint32_t width,
+                    uint32_t height,
+                    uint32_t channels,
+                    const uint8_t (&pixels)[N]) -> Image
+    {
+        [&] { ASSERT_EQ(size_t{width} * height * channels, N); }();
+        return make_image(
+            width, height, channels, [&pixels](size_t i) { return pixels[i]; });
+    }
+
     inline auto fixture_path(czstring path)
     {
         filesystem::Path fixture_path{__FILE__};
@@ -26,15 +68,15 @@ namespace rainbow::test
         explicit ScopedAssetsDirectory(czstring path)
             : assets_path_(fixture_path(path))
         {
-            PHYSFS_unmount(filesystem::bundle().assets_path());
-            PHYSFS_mount(c_str(), nullptr, 0);
-            PHYSFS_setWriteDir(c_str());
+            filesystem::unmount(filesystem::bundle().assets_path());
+            filesystem::mount(c_str());
+            filesystem::set_write_directory(c_str());
         }
 
         ~ScopedAssetsDirectory()
         {
-            PHYSFS_setWriteDir(nullptr);
-            PHYSFS_unmount(c_str());
+            filesystem::set_write_directory(nullptr);
+            filesystem::unmount(c_str());
         }
 
         auto c_str() const -> czstring { return assets_path_.c_str(); }
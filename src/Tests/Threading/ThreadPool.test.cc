@@ -0,0 +1,32 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Threading/ThreadPool.h"
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+using rainbow::ThreadPool;
+
+TEST(ThreadPoolTest, ProcessesAllJobs)
+{
+    std::atomic<int> processed{0};
+    ThreadPool pool(4);
+
+    ASSERT_EQ(pool.size(), 4U);
+    ASSERT_TRUE(pool.is_idle());
+
+    for (int i = 0; i < 100; ++i)
+        pool.post([&processed] { ++processed; });
+    pool.wait();
+
+    ASSERT_TRUE(pool.is_idle());
+    ASSERT_EQ(processed, 100);
+}
+
+TEST(ThreadPoolTest, HasAtLeastOneThread)
+{
+    ASSERT_GE(ThreadPool::default_size(), 1U);
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Threading/Worker.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using rainbow::Worker;
+
+TEST(WorkerTest, ProcessesJobsInOrder)
+{
+    std::vector<int> processed;
+    Worker<int> worker([&processed](int job) { processed.push_back(job); });
+
+    ASSERT_TRUE(worker.is_idle());
+
+    for (int i = 0; i < 100; ++i)
+        worker.post(i);
+    worker.wait();
+
+    ASSERT_TRUE(worker.is_idle());
+    ASSERT_EQ(processed.size(), 100U);
+    for (int i = 0; i < 100; ++i)
+        ASSERT_EQ(processed[i], i);
+}
+
+TEST(WorkerTest, DiscardsUnstartedJobs)
+{
+    int processed = 0;
+    {
+        Worker<int> worker([&processed](int) { ++processed; });
+        worker.clear();
+        worker.wait();
+    }
+
+    ASSERT_EQ(processed, 0);
+}
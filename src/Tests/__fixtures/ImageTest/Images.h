@@ -256,4 +256,99 @@ namespace rainbow::test::fixtures
         22,  15,  184, 76,  0,   0,   0,   0,   73,  69,  78,  68,  174, 66,
         96,  130,
     };
+
+    constexpr std::array<uint8_t, 389> qoiops_png{
+        137, 80,  78,  71,  13,  10,  26,  10,  0,   0,   0,   13,  73,  72,
+        68,  82,  0,   0,   0,   16,  0,   0,   0,   16,  8,   6,   0,   0,
+        0,   31,  243, 255, 97,  0,   0,   1,   76,  73,  68,  65,  84,  120,
+        218, 221, 208, 207, 43,  195, 113, 28,  199, 241, 47,  54,  63,  231,
+        71,  172, 108, 197, 119, 211, 44,  63,  242, 99,  36,  148, 111, 97,
+        73,  36,  114, 144, 131, 28,  118, 240, 155, 153, 205, 145, 112, 118,
+        34,  46,  14,  180, 139, 171, 31,  201, 65,  74,  46,  234, 29,  23,
+        167, 137, 131, 28,  40,  74,  146, 163, 216, 211, 103, 254, 4,   83,
+        202, 225, 209, 235, 244, 126, 245, 234, 173, 161, 105, 196, 67,  251,
+        7,   5,   218, 144, 144, 48,  44,  36,  142, 8,   73,  163, 130, 105,
+        76,  48,  143, 11,  201, 19,  66,  202, 164, 144, 58,  37,  164, 249,
+        133, 244, 105, 33,  35,  32,  88,  102, 132, 204, 160, 144, 21,  18,
+        178, 103, 229, 55,  10,  212, 12,  115, 178, 137, 116, 75,  42,  217,
+        185, 22,  172, 182, 28,  236, 186, 21,  189, 216, 134, 171, 188, 128,
+        82,  143, 147, 202, 250, 98,  106, 141, 82,  26,  188, 21,  24,  29,
+        30,  90,  123, 234, 104, 239, 107, 164, 107, 192, 248, 133, 2,   98,
+        127, 92,  130, 159, 166, 22,  207, 241, 119, 254, 253, 130, 237, 238,
+        115, 108, 110, 15,  199, 133, 126, 242, 42,  110, 137, 184, 230, 168,
+        186, 214, 105, 14,  57,  184, 176, 7,   201, 111, 91,  39,  210, 105,
+        176, 57,  88,  135, 239, 164, 6,   167, 62,  78,  244, 38,  204, 203,
+        227, 17,  27,  139, 131, 104, 243, 101, 27,  124, 238, 62,  176, 230,
+        54,  136, 244, 237, 210, 253, 126, 133, 181, 36,  204, 206, 65,  148,
+        39,  87,  53,  203, 111, 69,  56,  182, 238, 89,  61,  219, 39,  227,
+        249, 144, 254, 166, 15,  244, 192, 26,  222, 133, 11,  36,  90,  134,
+        86,  107, 180, 199, 228, 40,  78,  197, 163, 180, 40,  189, 138, 79,
+        153, 81,  150, 148, 21,  37,  172, 236, 41,  167, 202, 165, 114, 167,
+        188, 198, 93,  240, 5,   173, 47,  25,  7,   95,  145, 42,  109, 0,
+        0,   0,   0,   73,  69,  78,  68,  174, 66,  96,  130,
+    };
+
+    constexpr std::array<uint8_t, 471> qoiops_qoi{
+        113, 111, 105, 102, 0,   0,   0,   16,  0,   0,   0,   16,  4,   0,
+        90,  253, 192, 254, 0,   100, 200, 126, 126, 126, 126, 126, 126, 126,
+        126, 126, 126, 126, 126, 126, 126, 126, 254, 0,   100, 200, 126, 126,
+        126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 254,
+        0,   0,   0,   166, 118, 166, 118, 166, 118, 166, 118, 166, 118, 166,
+        118, 166, 118, 166, 118, 166, 118, 166, 118, 166, 118, 166, 118, 166,
+        118, 166, 118, 166, 118, 53,  62,  7,   16,  25,  34,  43,  52,  61,
+        6,   15,  24,  33,  42,  51,  60,  254, 255, 255, 0,   254, 0,   128,
+        255, 45,  46,  45,  46,  45,  46,  45,  46,  45,  46,  45,  46,  45,
+        46,  192, 45,  46,  45,  46,  45,  46,  45,  46,  45,  46,  45,  46,
+        45,  46,  45,  192, 46,  45,  46,  45,  46,  45,  46,  45,  46,  45,
+        46,  45,  46,  45,  46,  192, 45,  46,  45,  46,  45,  46,  45,  46,
+        45,  46,  45,  46,  45,  46,  45,  254, 165, 77,  202, 254, 24,  37,
+        48,  254, 187, 29,  109, 254, 19,  44,  222, 254, 214, 35,  123, 254,
+        46,  217, 30,  254, 63,  114, 31,  254, 203, 25,  113, 254, 23,  68,
+        148, 254, 214, 73,  60,  254, 157, 92,  52,  254, 96,  190, 49,  254,
+        32,  30,  105, 254, 254, 218, 160, 254, 238, 232, 185, 254, 153, 127,
+        92,  254, 124, 41,  153, 254, 253, 175, 229, 254, 147, 37,  60,  254,
+        214, 84,  175, 254, 77,  250, 215, 254, 20,  39,  160, 254, 174, 179,
+        254, 254, 233, 35,  47,  254, 138, 242, 33,  254, 31,  158, 228, 254,
+        145, 197, 177, 254, 11,  236, 181, 254, 86,  59,  252, 254, 30,  111,
+        147, 254, 66,  126, 203, 254, 200, 254, 41,  255, 50,  60,  70,  0,
+        255, 50,  60,  70,  16,  255, 50,  60,  70,  32,  255, 50,  60,  70,
+        48,  255, 50,  60,  70,  64,  255, 50,  60,  70,  80,  255, 50,  60,
+        70,  96,  255, 50,  60,  70,  112, 255, 50,  60,  70,  128, 255, 50,
+        60,  70,  144, 255, 50,  60,  70,  160, 255, 50,  60,  70,  176, 255,
+        50,  60,  70,  192, 255, 50,  60,  70,  208, 255, 50,  60,  70,  224,
+        255, 50,  60,  70,  240, 255, 50,  60,  70,  0,   255, 50,  60,  70,
+        16,  255, 50,  60,  70,  32,  255, 50,  60,  70,  48,  255, 50,  60,
+        70,  64,  255, 50,  60,  70,  80,  255, 50,  60,  70,  96,  255, 50,
+        60,  70,  112, 255, 50,  60,  70,  128, 255, 50,  60,  70,  144, 255,
+        50,  60,  70,  160, 255, 50,  60,  70,  176, 255, 50,  60,  70,  192,
+        255, 50,  60,  70,  208, 255, 50,  60,  70,  224, 255, 50,  60,  70,
+        240, 0,   0,   0,   0,   0,   0,   0,   1,
+    };
+
+    constexpr std::array<uint8_t, 100> etc2_ktx{
+        171, 75,  84,  88,  32,  49,  49,  187, 13,  10,  26,  10,  1,   2,
+        3,   4,   0,   0,   0,   0,   1,   0,   0,   0,   0,   0,   0,   0,
+        116, 146, 0,   0,   7,   25,  0,   0,   4,   0,   0,   0,   4,   0,
+        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,   0,   0,   0,
+        3,   0,   0,   0,   0,   0,   0,   0,   8,   0,   0,   0,   16,  16,
+        16,  16,  16,  16,  16,  16,  8,   0,   0,   0,   17,  17,  17,  17,
+        17,  17,  17,  17,  8,   0,   0,   0,   18,  18,  18,  18,  18,  18,
+        18,  18,
+    };
+
+    constexpr std::array<uint8_t, 176> etc2_ktx2{
+        171, 75,  84,  88,  32,  50,  48,  187, 13,  10,  26,  10,  147, 0,
+        0,   0,   1,   0,   0,   0,   4,   0,   0,   0,   4,   0,   0,   0,
+        0,   0,   0,   0,   0,   0,   0,   0,   1,   0,   0,   0,   3,   0,
+        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+        0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   168, 0,   0,   0,
+        0,   0,   0,   0,   8,   0,   0,   0,   0,   0,   0,   0,   8,   0,
+        0,   0,   0,   0,   0,   0,   160, 0,   0,   0,   0,   0,   0,   0,
+        8,   0,   0,   0,   0,   0,   0,   0,   8,   0,   0,   0,   0,   0,
+        0,   0,   152, 0,   0,   0,   0,   0,   0,   0,   8,   0,   0,   0,
+        0,   0,   0,   0,   8,   0,   0,   0,   0,   0,   0,   0,   18,  18,
+        18,  18,  18,  18,  18,  18,  17,  17,  17,  17,  17,  17,  17,  17,
+        16,  16,  16,  16,  16,  16,  16,  16,
+    };
 }  // namespace rainbow::test::fixtures
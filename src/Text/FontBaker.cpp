@@ -0,0 +1,105 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#include "Text/FontBaker.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "Common/Logging.h"
+#include "FileSystem/File.h"
+#include "Text/Typesetter.h"
+
+using namespace std::literals::string_view_literals;
+
+namespace
+{
+    constexpr int kMinArguments = 5;
+
+    auto bake_font_sizes(rainbow::Typesetter& typesetter,
+                         std::string_view charset,
+                         std::string_view font_spec) -> bool
+    {
+        const auto separator = font_spec.rfind(':');
+        if (separator == std::string_view::npos) {
+            LOGE("Missing font sizes: %s", font_spec.data());
+            return false;
+        }
+
+        const std::string font_name{font_spec.substr(0, separator)};
+        auto& font_cache = typesetter.font_cache();
+        auto font_face = font_cache.get(font_name);
+
+        auto sizes = font_spec.substr(separator + 1);
+        while (!sizes.empty()) {
+            const auto next = sizes.find(',');
+            const std::string size_str{sizes.substr(0, next)};
+            const int font_size = atoi(size_str.c_str());
+            if (font_size <= 0) {
+                LOGE("Invalid font size: %s", size_str.c_str());
+                return false;
+            }
+
+            const rainbow::TextAttributes attributes{
+                font_name, font_size, rainbow::TextAlignment::Left};
+            for (auto&& glyph : typesetter.layout_text(charset, attributes))
+                font_cache.get_glyph(font_face, font_size, glyph.glyph_index);
+
+            sizes = next == std::string_view::npos ? std::string_view{}
+                                                   : sizes.substr(next + 1);
+        }
+
+        return true;
+    }
+}  // namespace
+
+auto rainbow::text::bake_font(int argc, char* argv[]) -> int
+{
+    if (argc < kMinArguments) {
+        LOGE("Usage: %s --bake-font <output> <charset> <font>:<sizes>...",
+             argv[0]);
+        return 1;
+    }
+
+    czstring output_path = argv[2];
+    const auto charset = File::read(argv[3], FileType::Asset);
+    if (!charset) {
+        LOGE("Failed to read character set: %s", argv[3]);
+        return 1;
+    }
+
+    Typesetter typesetter;
+    for (int i = 4; i < argc; ++i) {
+        if (!bake_font_sizes(
+                typesetter,
+                std::string_view{charset.as<const char*>(), charset.size()},
+                argv[i])) {
+            return 1;
+        }
+    }
+
+    const auto atlas = typesetter.font_cache().save();
+    auto file = fopen(output_path, "wb");
+    if (file == nullptr) {
+        LOGE("Failed to open '%s' for writing", output_path);
+        return 1;
+    }
+
+    const auto written = fwrite(atlas.data(), 1, atlas.size(), file);
+    fclose(file);
+    if (written != atlas.size()) {
+        LOGE("Failed to write '%s'", output_path);
+        return 1;
+    }
+
+    LOGI("Wrote %zu bytes to %s", atlas.size(), output_path);
+    return 0;
+}
+
+auto rainbow::text::should_bake_font(int argc, char* argv[]) -> bool
+{
+    return argc >= 2 && argv[1] == "--bake-font"sv;
+}
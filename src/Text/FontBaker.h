@@ -0,0 +1,35 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef TEXT_FONTBAKER_H_
+#define TEXT_FONTBAKER_H_
+
+namespace rainbow::text
+{
+    /// <summary>
+    ///   Name of the font atlas that is loaded at startup, if present.
+    /// </summary>
+    constexpr char kFontAtlasFile[] = "fonts.atlas";
+
+    /// <summary>
+    ///   Rasterises a fixed set of glyphs offline and writes them to a font
+    ///   atlas that can be loaded with <c>FontCache::load</c>.
+    /// </summary>
+    /// <remarks>
+    ///   <code>
+    ///   rainbow --bake-font &lt;output&gt; &lt;charset&gt; &lt;font&gt;:&lt;sizes&gt;...
+    ///   </code>
+    ///   <c>charset</c> is a UTF-8 encoded text file containing all the
+    ///   characters that should be baked. Fonts are resolved the same way as
+    ///   at runtime so this should be run from the assets directory. An empty
+    ///   font name selects the system monospace font. Sizes are separated by
+    ///   commas, e.g. <c>OpenSans-Regular.ttf:12,16,24</c>.
+    /// </remarks>
+    auto bake_font(int argc, char* argv[]) -> int;
+
+    /// <summary>Returns whether <c>--bake-font</c> was specified.</summary>
+    auto should_bake_font(int argc, char* argv[]) -> bool;
+}  // namespace rainbow::text
+
+#endif
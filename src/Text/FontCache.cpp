@@ -4,9 +4,16 @@
 
 #include "Text/FontCache.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <tuple>
+
 #include "Common/Logging.h"
 #include "Common/TypeCast.h"
 #include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
 #include "Graphics/Image.h"
 #include "Text/SystemFonts.h"
 
@@ -29,6 +36,74 @@ namespace
     constexpr size_t kTextureSizeBytes =
         FontCache::kTextureSize * FontCache::kTextureSize * 4;
 
+    /// <summary>Font atlas file header.</summary>
+    /// <remarks>
+    ///   The header is followed by <c>font_count</c> font names (each
+    ///   prefixed with its length as a 32-bit integer), <c>glyph_count</c>
+    ///   glyph records, and finally the alpha channel of the top
+    ///   <c>height</c> rows of the texture.
+    /// </remarks>
+    struct AtlasHeader {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint32_t texture_size;
+        uint32_t height;
+        uint32_t font_count;
+        uint32_t glyph_count;
+    };
+
+    struct AtlasGlyph {
+        uint32_t font;
+        int32_t font_size;
+        uint32_t glyph_index;
+        std::array<float, 16> vertices;  // {texcoord, position} * 4
+    };
+
+    constexpr std::array<char, 4> kAtlasMagic{'R', 'F', 'N', 'T'};
+    constexpr uint32_t kAtlasVersion = 1;
+
+    /// <summary>
+    ///   Maps the font into memory if it is on the local filesystem. Fonts
+    ///   inside archives cannot be mapped and must be read instead. With
+    ///   Heimdall, fonts are always read so that they can be edited safely.
+    /// </summary>
+    auto map_font(std::string_view font_name) -> rainbow::MemoryMappedFile
+    {
+        if (font_name.empty())
+            return rainbow::MemoryMappedFile{rainbow::text::monospace_font_path()};
+
+#ifdef USE_HEIMDALL
+        // Fonts may be rewritten in place while they are being edited, which
+        // would fault any mapping of them before we get to reload them.
+        return {};
+#else
+        const auto path = rainbow::filesystem::real_path(font_name.data());
+        if (!rainbow::system::is_regular_file(path.c_str()))
+            return {};
+
+        return rainbow::MemoryMappedFile{path.c_str()};
+#endif
+    }
+
+    template <typename T>
+    void append(std::vector<uint8_t>& buffer, const T& value)
+    {
+        const auto offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    auto read(const rainbow::Data& data, size_t& offset, T& value) -> bool
+    {
+        if (data.size() - offset < sizeof(T))
+            return false;
+
+        memcpy(&value, data.bytes() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
     void blit(const uint8_t* src,
               const stbrp_rect& src_rect,
               Color* dst,
@@ -46,6 +121,10 @@ namespace
 }  // namespace
 
 FontCache::FontCache()
+    : rasterizer_(rasterized_glyphs_),
+      worker_([this](const GlyphRequest& request) {
+          rasterizer_.rasterize(request);
+      })
 {
     const auto texture_size = ceil_pow2(kTextureSize);
     stbrp_init_target(&bin_context_,
@@ -66,6 +145,10 @@ FontCache::FontCache()
 
 FontCache::~FontCache()
 {
+    // Make sure the worker is done with the font data before we release it.
+    worker_.clear();
+    worker_.wait();
+
     if (library_ == nullptr)
         return;
 
@@ -79,9 +162,32 @@ auto FontCache::get(std::string_view font_name) -> FT_Face
 {
     auto search = font_cache_.find(font_name);
     if (search == font_cache_.end()) {
-        auto data = font_name.empty()
-                        ? text::monospace_font()
-                        : File::read(font_name.data(), FileType::Asset);
+        if (auto alias = font_aliases_.find(font_name);
+            alias != font_aliases_.end()) {
+            return alias->second;
+        }
+
+        const auto content_hash = font_name.empty()
+                                      ? std::nullopt
+                                      : filesystem::content_hash(font_name);
+        if (content_hash) {
+            // The same font may be bundled under several names
+            for (auto&& font : font_cache_) {
+                if (font.second.content_hash == content_hash) {
+                    font_aliases_.emplace(font_name, font.second.face);
+                    return font.second.face;
+                }
+            }
+        }
+
+        auto mapping = map_font(font_name);
+        auto data =
+            mapping ? Data{mapping.data(),
+                           mapping.size(),
+                           Data::Ownership::Reference}
+            : font_name.empty()
+                ? text::monospace_font()
+                : File::read(font_name.data(), FileType::Asset);
         FT_Face face;
         [[maybe_unused]] FT_Error error =
             FT_New_Memory_Face(library_,
@@ -97,7 +203,9 @@ auto FontCache::get(std::string_view font_name) -> FT_Face
 
         R_ASSERT(error == FT_Err_Ok, "Failed to select character map");
 
-        font_cache_.emplace(font_name, FontFace{face, std::move(data)});
+        font_cache_.emplace(
+            font_name,
+            FontFace{face, std::move(mapping), std::move(data), content_hash});
         return face;
     }
 
@@ -105,73 +213,31 @@ auto FontCache::get(std::string_view font_name) -> FT_Face
 }
 
 auto FontCache::get_glyph(FT_Face face, int32_t font_size, uint32_t glyph_index)
-    -> std::array<SpriteVertex, 4>
+    -> std::optional<std::array<SpriteVertex, 4>>
 {
     const Index cache_index{face, font_size, glyph_index};
     auto search = glyph_cache_.find(cache_index);
     if (search == glyph_cache_.end()) {
-        FT_Set_Char_Size(face, 0, font_size * kPixelFormat, 0, kDPI);
-        FT_Load_Glyph(face, glyph_index, FT_LOAD_RENDER);
-        FT_GlyphSlot slot = face->glyph;
-        const FT_Bitmap& bitmap = slot->bitmap;
-
-        R_ASSERT(bitmap.num_grays == 256, "");
-        R_ASSERT(bitmap.pixel_mode == FT_PIXEL_MODE_GRAY, "");
-
-        stbrp_rect rect{
-            0,
-            static_cast<stbrp_coord>(bitmap.width + kGlyphMargin * 2),
-            static_cast<stbrp_coord>(bitmap.rows + kGlyphMargin * 2),
-            0,
-            0,
-            0};
-        stbrp_pack_rects(&bin_context_, &rect, 1);
-
-        R_ASSERT(rect.was_packed != 0,
-                 "Failed to pack a glyph, please increase your texture size");
-
-        // Adjust coordinates to compensate for margins.
-        rect.w -= kGlyphMargin * 2;
-        rect.h -= kGlyphMargin * 2;
-        rect.x += kGlyphMargin;
-        rect.y += kGlyphMargin;
-
-        blit(bitmap.buffer,
-             rect,
-             reinterpret_cast<Color*>(bitmap_.get()),
-             {kTextureSize, kTextureSize});
-        state_ = State::NeedsUpdate;
-
-        std::array<SpriteVertex, 4> vx;
-
-        vx[0].position.x = slot->bitmap_left;
-        vx[0].position.y = narrow_cast<float>(slot->bitmap_top -
-                                              narrow_cast<FT_Int>(bitmap.rows));
-        vx[1].position.x = narrow_cast<float>(slot->bitmap_left + bitmap.width);
-        vx[1].position.y = vx[0].position.y;
-        vx[2].position.x = vx[1].position.x;
-        vx[2].position.y = narrow_cast<float>(slot->bitmap_top);
-        vx[3].position.x = vx[0].position.x;
-        vx[3].position.y = vx[2].position.y;
-
-        vx[0].texcoord.x = rect.x / narrow_cast<float>(kTextureSize);
-        vx[0].texcoord.y = (rect.y + rect.h) / narrow_cast<float>(kTextureSize);
-        vx[1].texcoord.x = (rect.x + rect.w) / narrow_cast<float>(kTextureSize);
-        vx[1].texcoord.y = vx[0].texcoord.y;
-        vx[2].texcoord.x = vx[1].texcoord.x;
-        vx[2].texcoord.y = rect.y / narrow_cast<float>(kTextureSize);
-        vx[3].texcoord.x = vx[0].texcoord.x;
-        vx[3].texcoord.y = vx[2].texcoord.y;
-
-        glyph_cache_[cache_index] = {vx};
-        return vx;
+        const auto font = find_font(face);
+        R_ASSERT(font != nullptr, "Font face was not loaded by FontCache");
+
+        glyph_cache_[cache_index] = {{}, false};
+        worker_.post({cache_index,
+                      font->data.as<FT_Byte*>(),
+                      narrow_cast<FT_Long>(font->data.size())});
+        return std::nullopt;
     }
 
+    if (!search->second.is_ready)
+        return std::nullopt;
+
     return search->second.vertices;
 }
 
 void FontCache::update(TextureProvider& texture_provider)
 {
+    add_rasterized_glyphs();
+
     if (state_ != State::Ready) {
         const auto image = Image{
             Image::Format::RGBA,
@@ -190,6 +256,355 @@ void FontCache::update(TextureProvider& texture_provider)
     }
 }
 
+auto FontCache::load(const Data& atlas) -> bool
+{
+    R_ASSERT(glyph_cache_.empty(),
+             "Font atlas must be loaded before any glyphs are cached");
+
+    size_t offset = 0;
+    AtlasHeader header{};
+    if (!read(atlas, offset, header) || header.magic != kAtlasMagic ||
+        header.version != kAtlasVersion) {
+        LOGE("Invalid font atlas");
+        return false;
+    }
+
+    if (header.texture_size != kTextureSize ||
+        header.height > header.texture_size) {
+        LOGE("Font atlas was baked with a different texture size (%u)",
+             header.texture_size);
+        return false;
+    }
+
+    std::vector<FT_Face> faces;
+    faces.reserve(header.font_count);
+    for (uint32_t i = 0; i < header.font_count; ++i) {
+        uint32_t length = 0;
+        if (!read(atlas, offset, length) || atlas.size() - offset < length) {
+            LOGE("Font atlas is truncated");
+            return false;
+        }
+
+        const std::string font_name(atlas.as<const char*>() + offset, length);
+        offset += length;
+        faces.push_back(get(font_name));
+    }
+
+    const size_t bitmap_size =
+        static_cast<size_t>(header.texture_size) * header.height;
+    if ((atlas.size() - offset) / sizeof(AtlasGlyph) < header.glyph_count ||
+        atlas.size() - offset - header.glyph_count * sizeof(AtlasGlyph) <
+            bitmap_size) {
+        LOGE("Font atlas is truncated");
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header.glyph_count; ++i) {
+        AtlasGlyph glyph{};
+        read(atlas, offset, glyph);
+        if (glyph.font >= faces.size()) {
+            LOGE("Font atlas refers to an unknown font");
+            glyph_cache_.clear();
+            return false;
+        }
+
+        std::array<SpriteVertex, 4> vx;
+        for (size_t j = 0; j < vx.size(); ++j) {
+            vx[j].texcoord.x = glyph.vertices[j * 4];
+            vx[j].texcoord.y = glyph.vertices[j * 4 + 1];
+            vx[j].position.x = glyph.vertices[j * 4 + 2];
+            vx[j].position.y = glyph.vertices[j * 4 + 3];
+        }
+
+        const Index index{
+            faces[glyph.font], glyph.font_size, glyph.glyph_index};
+        glyph_cache_[index] = {vx, true};
+    }
+
+    const auto alpha = atlas.bytes() + offset;
+    std::transform(alpha,
+                   alpha + bitmap_size,
+                   reinterpret_cast<Color*>(bitmap_.get()),
+                   [](uint8_t a) {
+                       // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers)
+                       return Color{0xff, a};
+                   });
+
+    // Reserve the baked rows so that new glyphs are packed below them.
+    if (header.height > 0) {
+        stbrp_rect rect{0,
+                        static_cast<stbrp_coord>(header.texture_size),
+                        static_cast<stbrp_coord>(header.height),
+                        0,
+                        0,
+                        0};
+        stbrp_pack_rects(&bin_context_, &rect, 1);
+
+        R_ASSERT(rect.was_packed != 0 && rect.x == 0 && rect.y == 0,
+                 "Failed to reserve space for font atlas");
+    }
+
+    ++generation_;
+    state_ = State::NeedsUpdate;
+    return true;
+}
+
+auto FontCache::reload(std::string_view font_name) -> bool
+{
+    auto search = font_cache_.find(font_name);
+    if (search == font_cache_.end()) {
+        auto alias = font_aliases_.find(font_name);
+        if (alias == font_aliases_.end())
+            return false;
+
+        search = std::find_if(  //
+            font_cache_.begin(),
+            font_cache_.end(),
+            [face = alias->second](auto&& font) {
+                return font.second.face == face;
+            });
+        R_ASSERT(search != font_cache_.end(), "Alias of an unloaded font");
+    }
+
+    // Let the worker finish with the font data before we release it.
+    worker_.wait();
+    add_rasterized_glyphs();
+
+    const auto face = search->second.face;
+    for (auto i = glyph_cache_.begin(); i != glyph_cache_.end();) {
+        if (i->first.face == face)
+            glyph_cache_.erase(i++);
+        else
+            ++i;
+    }
+
+    rasterizer_.forget(face);
+    FT_Done_Face(face);
+    font_cache_.erase(search);
+    for (auto i = font_aliases_.find_value(face); i != font_aliases_.end();
+         i = font_aliases_.find_value(face)) {
+        font_aliases_.erase(i);
+    }
+
+    // Labels must lay out their text again with the new font.
+    ++epoch_;
+    return true;
+}
+
+auto FontCache::save() -> std::vector<uint8_t>
+{
+    worker_.wait();
+    add_rasterized_glyphs();
+
+    std::vector<FT_Face> faces;
+    std::vector<AtlasGlyph> glyphs;
+    glyphs.reserve(glyph_cache_.size());
+    uint32_t height = 0;
+    for (auto&& [index, info] : glyph_cache_) {
+        R_ASSERT(info.is_ready, "All glyphs should have been rasterised");
+
+        auto font = std::find(faces.begin(), faces.end(), index.face);
+        if (font == faces.end())
+            font = faces.insert(faces.end(), index.face);
+
+        AtlasGlyph glyph{narrow_cast<uint32_t>(font - faces.begin()),
+                         index.font_size,
+                         index.index,
+                         {}};
+        for (size_t j = 0; j < info.vertices.size(); ++j) {
+            const auto& vx = info.vertices[j];
+            glyph.vertices[j * 4] = vx.texcoord.x;
+            glyph.vertices[j * 4 + 1] = vx.texcoord.y;
+            glyph.vertices[j * 4 + 2] = vx.position.x;
+            glyph.vertices[j * 4 + 3] = vx.position.y;
+        }
+        glyphs.push_back(glyph);
+
+        // The bottom texture coordinate is stored in the first vertex.
+        const auto bottom = narrow_cast<uint32_t>(std::ceil(
+            info.vertices[0].texcoord.y * narrow_cast<float>(kTextureSize)));
+        height = std::max(height, bottom + kGlyphMargin);
+    }
+    height = std::min<uint32_t>(height, kTextureSize);
+
+    // Keep the output stable between runs.
+    std::sort(glyphs.begin(), glyphs.end(), [](auto&& lhs, auto&& rhs) {
+        return std::tie(lhs.font, lhs.font_size, lhs.glyph_index) <
+               std::tie(rhs.font, rhs.font_size, rhs.glyph_index);
+    });
+
+    std::vector<uint8_t> atlas;
+    append(atlas,
+           AtlasHeader{kAtlasMagic,
+                       kAtlasVersion,
+                       kTextureSize,
+                       height,
+                       narrow_cast<uint32_t>(faces.size()),
+                       narrow_cast<uint32_t>(glyphs.size())});
+
+    for (auto&& face : faces) {
+        const auto search = std::find_if(
+            font_cache_.begin(), font_cache_.end(), [face](auto&& font) {
+                return font.second.face == face;
+            });
+        const auto& font_name = search->first;
+        append(atlas, narrow_cast<uint32_t>(font_name.size()));
+        atlas.insert(atlas.end(), font_name.begin(), font_name.end());
+    }
+
+    for (auto&& glyph : glyphs)
+        append(atlas, glyph);
+
+    const auto pixels = reinterpret_cast<const Color*>(bitmap_.get());
+    std::transform(pixels,
+                   pixels + static_cast<size_t>(kTextureSize) * height,
+                   std::back_inserter(atlas),
+                   [](const Color& c) { return c.a; });
+
+    return atlas;
+}
+
+void FontCache::add_glyph(const GlyphBitmap& glyph)
+{
+    stbrp_rect rect{
+        0,
+        static_cast<stbrp_coord>(glyph.width + kGlyphMargin * 2),
+        static_cast<stbrp_coord>(glyph.rows + kGlyphMargin * 2),
+        0,
+        0,
+        0};
+    stbrp_pack_rects(&bin_context_, &rect, 1);
+
+    R_ASSERT(rect.was_packed != 0,
+             "Failed to pack a glyph, please increase your texture size");
+
+    // Adjust coordinates to compensate for margins.
+    rect.w -= kGlyphMargin * 2;
+    rect.h -= kGlyphMargin * 2;
+    rect.x += kGlyphMargin;
+    rect.y += kGlyphMargin;
+
+    blit(glyph.buffer.get(),
+         rect,
+         reinterpret_cast<Color*>(bitmap_.get()),
+         {kTextureSize, kTextureSize});
+
+    std::array<SpriteVertex, 4> vx;
+
+    vx[0].position.x = glyph.left;
+    vx[0].position.y =
+        narrow_cast<float>(glyph.top - narrow_cast<int32_t>(glyph.rows));
+    vx[1].position.x = narrow_cast<float>(glyph.left + glyph.width);
+    vx[1].position.y = vx[0].position.y;
+    vx[2].position.x = vx[1].position.x;
+    vx[2].position.y = narrow_cast<float>(glyph.top);
+    vx[3].position.x = vx[0].position.x;
+    vx[3].position.y = vx[2].position.y;
+
+    vx[0].texcoord.x = rect.x / narrow_cast<float>(kTextureSize);
+    vx[0].texcoord.y = (rect.y + rect.h) / narrow_cast<float>(kTextureSize);
+    vx[1].texcoord.x = (rect.x + rect.w) / narrow_cast<float>(kTextureSize);
+    vx[1].texcoord.y = vx[0].texcoord.y;
+    vx[2].texcoord.x = vx[1].texcoord.x;
+    vx[2].texcoord.y = rect.y / narrow_cast<float>(kTextureSize);
+    vx[3].texcoord.x = vx[0].texcoord.x;
+    vx[3].texcoord.y = vx[2].texcoord.y;
+
+    glyph_cache_[glyph.index] = {vx, true};
+}
+
+auto FontCache::add_rasterized_glyphs() -> bool
+{
+    std::vector<GlyphBitmap> glyphs;
+    rasterized_glyphs_->swap(glyphs);
+    if (glyphs.empty())
+        return false;
+
+    for (auto&& glyph : glyphs)
+        add_glyph(glyph);
+
+    ++generation_;
+    state_ = State::NeedsUpdate;
+    return true;
+}
+
+auto FontCache::find_font(FT_Face face) const -> const FontFace*
+{
+    for (auto&& font : font_cache_) {
+        if (font.second.face == face)
+            return &font.second;
+    }
+    return nullptr;
+}
+
+FontCache::GlyphRasterizer::GlyphRasterizer(
+    Synchronized<std::vector<GlyphBitmap>>& output)
+    : output_(output)
+{
+    FT_Init_FreeType(&library_);
+    R_ASSERT(library_, "Failed to initialise FreeType");
+}
+
+FontCache::GlyphRasterizer::~GlyphRasterizer()
+{
+    if (library_ == nullptr)
+        return;
+
+    for (auto&& i : faces_)
+        FT_Done_Face(i.second);
+
+    FT_Done_FreeType(library_);
+}
+
+void FontCache::GlyphRasterizer::forget(FT_Face face)
+{
+    auto search = faces_.find(face);
+    if (search == faces_.end())
+        return;
+
+    FT_Done_Face(search->second);
+    faces_.erase(search);
+}
+
+void FontCache::GlyphRasterizer::rasterize(const GlyphRequest& request)
+{
+    // FreeType faces cannot be shared between threads so we need to create
+    // our own from the same font data.
+    auto& face = faces_[request.index.face];
+    if (face == nullptr) {
+        [[maybe_unused]] FT_Error error = FT_New_Memory_Face(
+            library_, request.font_data, request.font_data_size, 0, &face);
+
+        R_ASSERT(error == FT_Err_Ok, "Failed to load font face");
+    }
+
+    FT_Set_Char_Size(
+        face, 0, request.index.font_size * kPixelFormat, 0, kDPI);
+    FT_Load_Glyph(face, request.index.index, FT_LOAD_RENDER);
+    FT_GlyphSlot slot = face->glyph;
+    const FT_Bitmap& bitmap = slot->bitmap;
+
+    R_ASSERT(bitmap.num_grays == 256, "");
+    R_ASSERT(bitmap.pixel_mode == FT_PIXEL_MODE_GRAY, "");
+
+    // Copy the bitmap row by row as pitch may be larger than the width.
+    const size_t size = static_cast<size_t>(bitmap.width) * bitmap.rows;
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+    auto buffer = std::make_unique<uint8_t[]>(size);
+    for (uint32_t row = 0; row < bitmap.rows; ++row) {
+        const auto src = bitmap.buffer + narrow_cast<ptrdiff_t>(row) *
+                                             bitmap.pitch;
+        std::copy_n(src, bitmap.width, buffer.get() + row * bitmap.width);
+    }
+
+    output_->push_back({request.index,
+                        std::move(buffer),
+                        bitmap.width,
+                        bitmap.rows,
+                        slot->bitmap_left,
+                        slot->bitmap_top});
+}
+
 #define STB_RECT_PACK_IMPLEMENTATION
 // clang-format off
 #include "ThirdParty/DisableWarnings.h"
@@ -6,7 +6,10 @@
 #define TEXT_FONTCACHE_H_
 
 #include <array>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 // clang-format off
 #include "ThirdParty/DisableWarnings.h"
@@ -20,9 +23,12 @@
 
 #include "Common/Data.h"
 #include "Common/Global.h"
+#include "FileSystem/MemoryMappedFile.h"
 #include "Graphics/SpriteVertex.h"
 #include "Graphics/Texture.h"
 #include "Memory/ArrayMap.h"
+#include "Threading/Synchronized.h"
+#include "Threading/Worker.h"
 
 namespace rainbow
 {
@@ -39,20 +45,78 @@ namespace rainbow
             return texture_;
         }
 
+        /// <summary>
+        ///   Returns a number that is incremented every time newly rasterised
+        ///   glyphs are added to the cache.
+        /// </summary>
+        [[nodiscard]] auto generation() const { return generation_; }
+
+        /// <summary>
+        ///   Returns a number that is incremented every time a font is
+        ///   unloaded. Text laid out before then must be laid out again.
+        /// </summary>
+        [[nodiscard]] auto epoch() const { return epoch_; }
+
         auto get(std::string_view font_name) -> FT_Face;
+
+        /// <summary>
+        ///   Returns the vertices of the specified glyph, or
+        ///   <c>std::nullopt</c> if it is still being rasterised.
+        /// </summary>
+        /// <remarks>
+        ///   Glyphs that are not in the cache are queued for rasterisation on
+        ///   a background thread, and become available after the next call to
+        ///   <see cref="update"/> following their completion.
+        /// </remarks>
         auto get_glyph(FT_Face face, int32_t font_size, uint32_t glyph_index)
-            -> std::array<SpriteVertex, 4>;
+            -> std::optional<std::array<SpriteVertex, 4>>;
 
+        /// <summary>
+        ///   Adds rasterised glyphs to the cache and uploads the texture if
+        ///   anything changed.
+        /// </summary>
         void update(graphics::TextureProvider&);
 
+        /// <summary>
+        ///   Loads pre-rasterised glyphs from a font atlas created with
+        ///   <c>--bake-font</c>. Must be called before any glyphs are cached.
+        /// </summary>
+        /// <returns><c>true</c> if the atlas was loaded.</returns>
+        auto load(const Data& atlas) -> bool;
+
+        /// <summary>
+        ///   Unloads <paramref name="font_name"/> and drops its glyphs, so
+        ///   that it is read from disk again the next time it is used.
+        /// </summary>
+        /// <remarks>
+        ///   Texture space occupied by the old glyphs is not reclaimed. Fonts
+        ///   sharing a face because of identical contents are unloaded too.
+        /// </remarks>
+        /// <returns><c>true</c> if the font was loaded.</returns>
+        auto reload(std::string_view font_name) -> bool;
+
+        /// <summary>
+        ///   Waits for pending glyphs to finish rasterising, then serialises
+        ///   all cached glyphs and the used portion of the texture.
+        /// </summary>
+        auto save() -> std::vector<uint8_t>;
+
     private:
         struct FontFace {
             FT_Face face;
-            Data data;
+            MemoryMappedFile mapping;
+            Data data;  ///< Font data; references mapping if mapped.
+
+            /// <summary>
+            ///   Hash of the font file's contents, if it is known. Fonts with
+            ///   identical contents share a face.
+            /// </summary>
+            std::optional<uint64_t> content_hash;
         };
 
         struct GlyphInfo {
             std::array<SpriteVertex, 4> vertices;
+            bool is_ready;
         };
 
         struct Index {
@@ -74,19 +138,73 @@ namespace rainbow
             }
         };
 
+        struct GlyphRequest {
+            Index index;
+            const FT_Byte* font_data;
+            FT_Long font_data_size;
+        };
+
+        struct GlyphBitmap {
+            Index index;
+            std::unique_ptr<uint8_t[]> buffer;
+            uint32_t width;
+            uint32_t rows;
+            int32_t left;
+            int32_t top;
+        };
+
+        /// <summary>
+        ///   Renders glyph bitmaps. Owns its own FreeType state and must only
+        ///   be used from the worker thread.
+        /// </summary>
+        class GlyphRasterizer : private rainbow::NonCopyable<GlyphRasterizer>
+        {
+        public:
+            explicit GlyphRasterizer(
+                Synchronized<std::vector<GlyphBitmap>>& output);
+            ~GlyphRasterizer();
+
+            /// <summary>
+            ///   Releases the copy of <paramref name="face"/>, if any.
+            /// </summary>
+            void forget(FT_Face face);
+
+            void rasterize(const GlyphRequest&);
+
+        private:
+            FT_Library library_;
+            absl::flat_hash_map<FT_Face, FT_Face> faces_;
+            Synchronized<std::vector<GlyphBitmap>>& output_;
+        };
+
         enum class State {
             Ready,
             NeedsUpdate,
         };
 
-        State state_ = State::Ready;
+        State state_ = State::NeedsUpdate;
+        uint32_t generation_ = 0;
+        uint32_t epoch_ = 0;
         graphics::Texture texture_;
         absl::flat_hash_map<Index, GlyphInfo> glyph_cache_;
         ArrayMap<std::string, FontFace> font_cache_;
+
+        /// <summary>
+        ///   Names of fonts whose contents are identical to a font that was
+        ///   loaded under another name, and the face they share.
+        /// </summary>
+        ArrayMap<std::string, FT_Face> font_aliases_;
         stbrp_context bin_context_;
         std::array<stbrp_node, kTextureSize> bin_nodes_;
         std::unique_ptr<uint8_t[]> bitmap_;
         FT_Library library_;
+        Synchronized<std::vector<GlyphBitmap>> rasterized_glyphs_;
+        GlyphRasterizer rasterizer_;
+        Worker<GlyphRequest> worker_;
+
+        void add_glyph(const GlyphBitmap&);
+        auto add_rasterized_glyphs() -> bool;
+        [[nodiscard]] auto find_font(FT_Face face) const -> const FontFace*;
     };
 }  // namespace rainbow
 
@@ -68,15 +68,39 @@ Typesetter::~Typesetter()
 auto Typesetter::draw_text(std::string_view text,
                            const Vec2f& position,
                            const TextAttributes& attributes,
-                           Vec2f* size) -> std::vector<SpriteVertex>
+                           Vec2f* size,
+                           uint32_t* pending_glyphs,
+                           TextLayout* layout) -> std::vector<SpriteVertex>
 {
-    auto glyph_positions = layout_text(text, attributes, size);
+    const auto glyph_start = layout == nullptr ? 0 : layout->glyph_start;
+    auto glyph_positions = layout_text(text, attributes, size, layout);
+
+    // Glyphs from here on make up the last line, which will be laid out again
+    // on the next append.
+    const auto last_line =
+        layout == nullptr ? 0 : layout->glyph_start - glyph_start;
+
     std::vector<SpriteVertex> vertices;
     vertices.reserve(glyph_positions.size() * 4);
+    uint32_t pending = 0;
+    uint32_t last_line_pending = 0;
     auto font_face = font_cache_.get(attributes.font_face);
-    for (auto&& glyph : glyph_positions) {
-        auto vx = font_cache_.get_glyph(
+    for (uint32_t i = 0; i < glyph_positions.size(); ++i) {
+        const auto& glyph = glyph_positions[i];
+        auto glyph_vx = font_cache_.get_glyph(
             font_face, attributes.font_size, glyph.glyph_index);
+
+        // Keep the number of vertices stable while the glyph is being
+        // rasterised by emitting a degenerate quad in its place.
+        std::array<SpriteVertex, 4> vx{};
+        if (glyph_vx.has_value()) {
+            vx = *glyph_vx;
+        } else {
+            ++pending;
+            if (i >= last_line)
+                ++last_line_pending;
+        }
+
         auto p = glyph.position + position;
         vx[0].position += p;
         vx[1].position += p;
@@ -84,12 +108,17 @@ auto Typesetter::draw_text(std::string_view text,
         vx[3].position += p;
         vertices.insert(vertices.end(), vx.begin(), vx.end());
     }
+    if (pending_glyphs != nullptr)
+        *pending_glyphs = pending;
+    if (layout != nullptr)
+        layout->pending_glyphs = last_line_pending;
     return vertices;
 }
 
 auto Typesetter::layout_text(std::string_view text,
                              const TextAttributes& attributes,
-                             Vec2f* size) -> std::vector<GlyphPosition>
+                             Vec2f* size,
+                             TextLayout* layout) -> std::vector<GlyphPosition>
 {
     std::vector<GlyphPosition> result;
 
@@ -101,9 +130,14 @@ auto Typesetter::layout_text(std::string_view text,
     auto font = hb_ft_font_create(font_face, nullptr);
     hb_ft_font_set_load_flags(font, FT_LOAD_DEFAULT);
 
-    float width = 0.0F;
-    int line_count = 0;
-    int start = 0;
+    TextLayout state{};
+    if (layout != nullptr)
+        state = *layout;
+
+    const auto glyph_start = state.glyph_start;
+    float width = state.width;
+    int line_count = state.line_count;
+    int start = narrow_cast<int>(state.line_start);
     const auto length = narrow_cast<int>(text.length());
     while (start < length) {
         hb_buffer_reset(buffer_);
@@ -144,8 +178,20 @@ auto Typesetter::layout_text(std::string_view text,
         ++line_count;
 
         width = std::max(width, origin.x);
+
+        // Lines are complete once they're terminated by a newline.
+        if (start <= length) {
+            state.line_start = start;
+            state.glyph_start =
+                glyph_start + narrow_cast<uint32_t>(result.size());
+            state.line_count = line_count;
+            state.width = width;
+        }
     }
 
+    if (layout != nullptr)
+        *layout = state;
+
     hb_font_destroy(font);
 
     if (size != nullptr) {
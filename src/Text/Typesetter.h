@@ -30,6 +30,30 @@ namespace rainbow
         TextAlignment text_alignment;
     };
 
+    /// <summary>
+    ///   Keeps track of where the last line of a text begins, so that text
+    ///   can be appended without laying out preceding lines again.
+    /// </summary>
+    struct TextLayout {
+        /// <summary>Byte offset of the last line.</summary>
+        size_t line_start = 0;
+
+        /// <summary>Number of glyphs preceding the last line.</summary>
+        uint32_t glyph_start = 0;
+
+        /// <summary>Number of lines preceding the last line.</summary>
+        int line_count = 0;
+
+        /// <summary>Width of the widest line preceding the last line.</summary>
+        float width = 0.0F;
+
+        /// <summary>
+        ///   Number of glyphs on the last line that were still being
+        ///   rasterised. Only set by <c>Typesetter::draw_text()</c>.
+        /// </summary>
+        uint32_t pending_glyphs = 0;
+    };
+
     class Typesetter : private NonCopyable<Typesetter>
     {
     public:
@@ -38,14 +62,32 @@ namespace rainbow
 
         auto font_cache() -> FontCache& { return font_cache_; }
 
+        /// <summary>
+        ///   Returns the vertices for the specified text. Glyphs that are
+        ///   still being rasterised are replaced with empty quads.
+        /// </summary>
+        /// <param name="pending_glyphs">
+        ///   [out] Number of glyphs that are still being rasterised.
+        /// </param>
+        /// <param name="layout">
+        ///   [in,out] If set, only lines starting from
+        ///   <c>layout->line_start</c> are laid out, and the returned vertices
+        ///   replace those from <c>layout->glyph_start</c>. The pending glyphs
+        ///   of the replaced line are in <c>layout->pending_glyphs</c>.
+        /// </param>
         auto draw_text(std::string_view text,
                        const Vec2f& position,
                        const TextAttributes& attributes,
-                       Vec2f* size = nullptr) -> std::vector<SpriteVertex>;
+                       Vec2f* size = nullptr,
+                       uint32_t* pending_glyphs = nullptr,
+                       TextLayout* layout = nullptr)
+            -> std::vector<SpriteVertex>;
 
         auto layout_text(std::string_view text,
                          const TextAttributes& attributes,
-                         Vec2f* size = nullptr) -> std::vector<GlyphPosition>;
+                         Vec2f* size = nullptr,
+                         TextLayout* layout = nullptr)
+            -> std::vector<GlyphPosition>;
 
     private:
         FontCache font_cache_;
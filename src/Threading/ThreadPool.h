@@ -0,0 +1,133 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef THREADING_THREADPOOL_H_
+#define THREADING_THREADPOOL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common/NonCopyable.h"
+
+namespace rainbow
+{
+    /// <summary>
+    ///   Processes jobs on a fixed set of threads. Jobs are started in the
+    ///   order they were posted, but may finish in any order.
+    /// </summary>
+    /// <remarks>
+    ///   Jobs that have not been started when the pool is destroyed, are
+    ///   discarded. Call <see cref="wait"/> first if they must be processed.
+    /// </remarks>
+    class ThreadPool : private NonCopyable<ThreadPool>
+    {
+    public:
+        using Job = std::function<void()>;
+
+        /// <summary>
+        ///   Returns the default number of threads; one less than the number
+        ///   of hardware threads to leave room for the main thread.
+        /// </summary>
+        static auto default_size() -> unsigned int
+        {
+            return std::max(std::thread::hardware_concurrency(), 2U) - 1;
+        }
+
+        explicit ThreadPool(unsigned int size = default_size())
+        {
+            threads_.reserve(size);
+            for (unsigned int i = 0; i < size; ++i)
+                threads_.emplace_back([this] { run(); });
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_ = false;
+            }
+            job_posted_.notify_all();
+            for (auto&& thread : threads_)
+                thread.join();
+        }
+
+        /// <summary>Returns whether there are no unfinished jobs.</summary>
+        [[nodiscard]] auto is_idle() -> bool
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return queue_.empty() && busy_ == 0;
+        }
+
+        [[nodiscard]] auto size() const { return threads_.size(); }
+
+        /// <summary>Discards all jobs that have not been started.</summary>
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.clear();
+        }
+
+        /// <summary>Queues <paramref name="job"/> for processing.</summary>
+        void post(Job job)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                queue_.push_back(std::move(job));
+            }
+            job_posted_.notify_one();
+        }
+
+        /// <summary>Blocks until all posted jobs have been processed.</summary>
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            idle_.wait(lock, [this] { return queue_.empty() && busy_ == 0; });
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable job_posted_;
+        std::condition_variable idle_;
+        std::deque<Job> queue_;
+        unsigned int busy_ = 0;
+        bool running_ = true;
+
+        // Threads must be initialised last as they will start using the
+        // members above immediately.
+        std::vector<std::thread> threads_;
+
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true) {
+                job_posted_.wait(
+                    lock, [this] { return !queue_.empty() || !running_; });
+                if (!running_)
+                    break;
+
+                Job job = std::move(queue_.front());
+                queue_.pop_front();
+                ++busy_;
+
+                lock.unlock();
+                job();
+                lock.lock();
+
+                --busy_;
+                if (queue_.empty() && busy_ == 0)
+                    idle_.notify_all();
+            }
+
+            idle_.notify_all();
+        }
+    };
+}  // namespace rainbow
+
+#endif
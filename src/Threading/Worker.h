@@ -0,0 +1,119 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+#ifndef THREADING_WORKER_H_
+#define THREADING_WORKER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "Common/NonCopyable.h"
+
+namespace rainbow
+{
+    /// <summary>
+    ///   Processes jobs on a dedicated thread in the order they were posted.
+    /// </summary>
+    /// <remarks>
+    ///   Jobs that have not been started when the worker is destroyed, are
+    ///   discarded. Call <see cref="wait"/> first if they must be processed.
+    /// </remarks>
+    template <typename T>
+    class Worker : private NonCopyable<Worker<T>>
+    {
+    public:
+        template <typename F>
+        explicit Worker(F&& process)
+            : thread_([this, process = std::forward<F>(process)]() mutable {
+                  run(process);
+              })
+        {
+        }
+
+        ~Worker()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_ = false;
+            }
+            job_posted_.notify_one();
+            thread_.join();
+        }
+
+        /// <summary>Returns whether there are no unfinished jobs.</summary>
+        [[nodiscard]] auto is_idle() -> bool
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return queue_.empty() && !busy_;
+        }
+
+        /// <summary>Discards all jobs that have not been started.</summary>
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.clear();
+        }
+
+        /// <summary>Queues <paramref name="job"/> for processing.</summary>
+        void post(T job)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                queue_.push_back(std::move(job));
+            }
+            job_posted_.notify_one();
+        }
+
+        /// <summary>Blocks until all posted jobs have been processed.</summary>
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            idle_.wait(lock, [this] { return queue_.empty() && !busy_; });
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable job_posted_;
+        std::condition_variable idle_;
+        std::deque<T> queue_;
+        bool busy_ = false;
+        bool running_ = true;
+
+        // The thread must be initialised last as it will start using the
+        // members above immediately.
+        std::thread thread_;
+
+        template <typename F>
+        void run(F& process)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true) {
+                job_posted_.wait(
+                    lock, [this] { return !queue_.empty() || !running_; });
+                if (!running_)
+                    break;
+
+                T job = std::move(queue_.front());
+                queue_.pop_front();
+                busy_ = true;
+
+                lock.unlock();
+                process(job);
+                lock.lock();
+
+                busy_ = false;
+                if (queue_.empty())
+                    idle_.notify_all();
+            }
+
+            busy_ = false;
+            idle_.notify_all();
+        }
+    };
+}  // namespace rainbow
+
+#endif
@@ -0,0 +1,268 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+// @ts-check
+"use strict";
+
+/**
+ * Converts PNG images to QOI, which decodes several times faster.
+ *
+ * Usage: node tools/convert-qoi.js <image.png>...
+ *
+ * Each image is written next to the original with a `.qoi` extension.
+ * See https://qoiformat.org/qoi-specification.pdf
+ */
+
+const fs = require("fs");
+const path = require("path");
+const zlib = require("zlib");
+
+const PNG_SIGNATURE = Buffer.from([137, 80, 78, 71, 13, 10, 26, 10]);
+
+const QOI_OP_INDEX = 0x00;
+const QOI_OP_DIFF = 0x40;
+const QOI_OP_LUMA = 0x80;
+const QOI_OP_RUN = 0xc0;
+const QOI_OP_RGB = 0xfe;
+const QOI_OP_RGBA = 0xff;
+const QOI_PADDING = [0, 0, 0, 0, 0, 0, 0, 1];
+
+/**
+ * @typedef {{ width: number; height: number; pixels: Uint8Array; }} Bitmap
+ */
+
+/**
+ * Returns the Paeth predictor for the specified neighbours.
+ * @param {number} a
+ * @param {number} b
+ * @param {number} c
+ * @returns {number}
+ */
+function paeth(a, b, c) {
+  const p = a + b - c;
+  const pa = Math.abs(p - a);
+  const pb = Math.abs(p - b);
+  const pc = Math.abs(p - c);
+  return pa <= pb && pa <= pc ? a : pb <= pc ? b : c;
+}
+
+/**
+ * Decodes a non-interlaced PNG into RGBA pixels.
+ * @param {Buffer} png
+ * @returns {Bitmap}
+ */
+function decodePNG(png) {
+  if (!png.subarray(0, PNG_SIGNATURE.length).equals(PNG_SIGNATURE)) {
+    throw new Error("Not a PNG file");
+  }
+
+  let width = 0;
+  let height = 0;
+  let bitDepth = 0;
+  let colorType = 0;
+  /** @type {Buffer} */
+  let palette = Buffer.alloc(0);
+  /** @type {Buffer} */
+  let transparency = Buffer.alloc(0);
+  /** @type {Buffer[]} */
+  const idat = [];
+
+  for (let offset = PNG_SIGNATURE.length; offset < png.length; ) {
+    const length = png.readUInt32BE(offset);
+    const type = png.toString("ascii", offset + 4, offset + 8);
+    const data = png.subarray(offset + 8, offset + 8 + length);
+    switch (type) {
+      case "IHDR":
+        width = data.readUInt32BE(0);
+        height = data.readUInt32BE(4);
+        bitDepth = data[8];
+        colorType = data[9];
+        if (data[12] !== 0) {
+          throw new Error("Interlaced PNGs are not supported");
+        }
+        break;
+      case "PLTE":
+        palette = data;
+        break;
+      case "tRNS":
+        transparency = data;
+        break;
+      case "IDAT":
+        idat.push(data);
+        break;
+    }
+    offset += length + 12;
+  }
+
+  if (bitDepth !== 8 && bitDepth !== 16) {
+    throw new Error(`Unsupported bit depth: ${bitDepth}`);
+  }
+
+  const channels = { 0: 1, 2: 3, 3: 1, 4: 2, 6: 4 }[colorType];
+  if (!channels) {
+    throw new Error(`Unsupported color type: ${colorType}`);
+  }
+
+  const bpp = (channels * bitDepth) / 8;
+  const stride = width * bpp;
+  const raw = zlib.inflateSync(Buffer.concat(idat));
+  const scanlines = Buffer.alloc(stride * height);
+  for (let y = 0; y < height; ++y) {
+    const filter = raw[y * (stride + 1)];
+    const src = y * (stride + 1) + 1;
+    const dst = y * stride;
+    for (let x = 0; x < stride; ++x) {
+      const a = x >= bpp ? scanlines[dst + x - bpp] : 0;
+      const b = y > 0 ? scanlines[dst + x - stride] : 0;
+      const c = x >= bpp && y > 0 ? scanlines[dst + x - stride - bpp] : 0;
+      const predictor = [0, a, b, (a + b) >> 1, paeth(a, b, c)][filter];
+      scanlines[dst + x] = (raw[src + x] + predictor) & 0xff;
+    }
+  }
+
+  // Only the most significant byte of 16-bit samples is kept
+  const step = bitDepth / 8;
+  const pixels = new Uint8Array(width * height * 4);
+  for (let i = 0; i < width * height; ++i) {
+    /** @type {(n: number) => number} */
+    const sample = (n) => scanlines[(i * channels + n) * step];
+    const out = i * 4;
+    switch (colorType) {
+      case 0:
+        pixels.set([sample(0), sample(0), sample(0), 255], out);
+        break;
+      case 2:
+        pixels.set([sample(0), sample(1), sample(2), 255], out);
+        break;
+      case 3: {
+        const index = sample(0);
+        const alpha = index < transparency.length ? transparency[index] : 255;
+        pixels.set([...palette.subarray(index * 3, index * 3 + 3), alpha], out);
+        break;
+      }
+      case 4:
+        pixels.set([sample(0), sample(0), sample(0), sample(1)], out);
+        break;
+      case 6:
+        pixels.set([sample(0), sample(1), sample(2), sample(3)], out);
+        break;
+    }
+  }
+
+  return { width, height, pixels };
+}
+
+/**
+ * Encodes RGBA pixels as QOI.
+ * @param {Bitmap} bitmap
+ * @returns {Buffer}
+ */
+function encodeQOI({ width, height, pixels }) {
+  const header = Buffer.alloc(14);
+  header.write("qoif", 0, "ascii");
+  header.writeUInt32BE(width, 4);
+  header.writeUInt32BE(height, 8);
+  header[12] = 4; // channels
+  header[13] = 0; // sRGB with linear alpha
+
+  /** @type {number[]} */
+  const bytes = [];
+  const index = new Uint8Array(64 * 4);
+  let [pr, pg, pb, pa] = [0, 0, 0, 255];
+  let run = 0;
+
+  const count = width * height;
+  for (let i = 0; i < count; ++i) {
+    const [r, g, b, a] = pixels.subarray(i * 4, i * 4 + 4);
+    if (r === pr && g === pg && b === pb && a === pa) {
+      ++run;
+      if (run === 62 || i === count - 1) {
+        bytes.push(QOI_OP_RUN | (run - 1));
+        run = 0;
+      }
+      continue;
+    }
+
+    if (run > 0) {
+      bytes.push(QOI_OP_RUN | (run - 1));
+      run = 0;
+    }
+
+    const hash = ((r * 3 + g * 5 + b * 7 + a * 11) % 64) * 4;
+    if (
+      index[hash] === r &&
+      index[hash + 1] === g &&
+      index[hash + 2] === b &&
+      index[hash + 3] === a
+    ) {
+      bytes.push(QOI_OP_INDEX | (hash / 4));
+    } else {
+      index.set([r, g, b, a], hash);
+      if (a === pa) {
+        /** @type {(d: number) => number} */
+        const wrap = (d) => ((d + 128) & 0xff) - 128;
+        const vr = wrap(r - pr);
+        const vg = wrap(g - pg);
+        const vb = wrap(b - pb);
+        const vgr = vr - vg;
+        const vgb = vb - vg;
+        if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+          bytes.push(
+            QOI_OP_DIFF | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2)
+          );
+        } else if (
+          vgr > -9 &&
+          vgr < 8 &&
+          vg > -33 &&
+          vg < 32 &&
+          vgb > -9 &&
+          vgb < 8
+        ) {
+          bytes.push(QOI_OP_LUMA | (vg + 32), ((vgr + 8) << 4) | (vgb + 8));
+        } else {
+          bytes.push(QOI_OP_RGB, r, g, b);
+        }
+      } else {
+        bytes.push(QOI_OP_RGBA, r, g, b, a);
+      }
+    }
+
+    [pr, pg, pb, pa] = [r, g, b, a];
+  }
+
+  return Buffer.concat([header, Buffer.from(bytes), Buffer.from(QOI_PADDING)]);
+}
+
+/**
+ * Converts the specified PNG to QOI.
+ * @param {string} image
+ * @returns {boolean}
+ */
+function convert(image) {
+  try {
+    const qoi = encodeQOI(decodePNG(fs.readFileSync(image)));
+    const output = path.join(
+      path.dirname(image),
+      path.basename(image, path.extname(image)) + ".qoi"
+    );
+    fs.writeFileSync(output, qoi, { mode: 0o644 });
+
+    // eslint-disable-next-line no-console
+    console.log(`${image} -> ${output}`);
+    return true;
+  } catch (e) {
+    // eslint-disable-next-line no-console
+    console.warn(`${image}: ${e instanceof Error ? e.message : e}`);
+    return false;
+  }
+}
+
+if (require.main && require.main.filename === __filename) {
+  process.argv.slice(process.argv.indexOf(__filename) + 1).forEach(convert);
+}
+
+module.exports = {
+  decodePNG,
+  encodeQOI,
+};
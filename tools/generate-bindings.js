@@ -173,6 +173,11 @@ const modules = [
         parameters: [{ type: "TextAlignment", name: "alignment" }],
         returnType: "this",
       },
+      {
+        name: "append",
+        parameters: [{ type: "czstring", name: "text" }],
+        returnType: "this",
+      },
       { name: "angle", parameters: [], returnType: "float" },
       {
         name: "angle",
@@ -465,6 +470,18 @@ const modules = [
       },
     ],
   },
+  {
+    type: "module",
+    name: "Prefetcher",
+    source: "FileSystem/Prefetcher.h",
+    sourceName: "Prefetcher",
+    functions: [
+      {
+        name: "prefetch",
+        parameters: [{ type: "czstring", name: "path" }],
+      },
+    ],
+  },
   {
     type: "module",
     name: "RenderQueue",
@@ -0,0 +1,420 @@
+// Copyright (c) 2010-present Bifrost Entertainment AS and Tommy Nguyen
+// Distributed under the MIT License.
+// (See accompanying file LICENSE or copy at http://opensource.org/licenses/MIT)
+
+// @ts-check
+"use strict";
+
+/**
+ * Packs a directory of assets into a Rainbow pack (.rpak).
+ *
+ * Usage: node tools/pack-assets.js [options] <directory> <output.rpak>
+ *
+ * Options:
+ *   --lz4          Compress entries with LZ4 instead of deflate. LZ4 compresses
+ *                  less, but decompresses several times faster, which pays off
+ *                  when loading is bound by slow storage.
+ *   --no-compress  Store entries uncompressed.
+ *
+ * Layout (all integers are little-endian):
+ *
+ *   0      magic "RPAK"
+ *   4      u32 version
+ *   8      u32 number of entries
+ *   12     u32 size of name table
+ *   16     u32[256] fan-out table; element i is the number of entries whose
+ *          hash has a top byte less than or equal to i
+ *   1040   entries sorted by hash, 32 bytes each:
+ *            u64 FNV-1a hash of the path
+ *            u64 offset of the data from the start of the pack
+ *            u32 stored size
+ *            u32 uncompressed size
+ *            u32 offset of the path in the name table
+ *            u16 length of the path
+ *            u16 compression (0 = none, 1 = deflate, 2 = LZ4)
+ *   ...    u64[n] FNV-1a hash of the uncompressed data of each entry, in the
+ *          same order as the entries (since version 2)
+ *   ...    name table; paths are relative to the packed directory, separated
+ *          by '/', and not null-terminated
+ *   ...    data; entries of 4 KiB or more are aligned to 4096 bytes so that
+ *          they can be mapped directly, others to 16 bytes. Every entry is
+ *          followed by at least one null byte. Files with identical
+ *          contents are stored once, and their entries share the data.
+ *
+ * LZ4 entries are split into blocks of 64 KiB that are compressed
+ * independently, so that they can be decompressed in parallel or streamed:
+ *
+ *   0      u32[n] offset to the end of each block, relative to the end of
+ *          this table
+ *   4 * n  LZ4 blocks (without frames); blocks that do not compress are
+ *          stored as is
+ *
+ * See src/FileSystem/Pack.h
+ */
+
+const fs = require("fs");
+const path = require("path");
+const zlib = require("zlib");
+
+const PACK_MAGIC = "RPAK";
+const PACK_VERSION = 2;
+const HEADER_SIZE = 16 + 256 * 4;
+const ENTRY_SIZE = 32;
+const CONTENT_HASH_SIZE = 8;
+const PAGE_SIZE = 4096;
+const MIN_ALIGNMENT = 16;
+
+const COMPRESSION_NONE = 0;
+const COMPRESSION_DEFLATE = 1;
+const COMPRESSION_LZ4 = 2;
+
+const LZ4_BLOCK_SIZE = 64 * 1024;
+const LZ4_HASH_BITS = 16;
+const LZ4_MIN_MATCH = 4;
+const LZ4_MAX_OFFSET = 65535;
+const LZ4_LAST_LITERALS = 5; // The last bytes of a block must be literals
+const LZ4_MATCH_LIMIT = 12; // The last match must start before this
+
+// Compressed entries must be at least this much smaller to be worth
+// decompressing at load time.
+const MIN_COMPRESSION_RATIO = 0.9;
+
+const FNV1A_OFFSET_BASIS = 0xcbf29ce484222325n;
+const FNV1A_PRIME = 0x100000001b3n;
+const UINT64_MASK = 0xffffffffffffffffn;
+
+/**
+ * @typedef {{
+ *   name: string;
+ *   hash: bigint;
+ *   contentHash: bigint;
+ *   data: Buffer;
+ *   size: number;
+ *   compression: number;
+ * }} Entry
+ *
+ * @typedef {"deflate" | "lz4" | "none"} Compression
+ */
+
+/**
+ * Returns the 64-bit FNV-1a hash of the specified bytes.
+ * @param {Buffer} bytes
+ * @returns {bigint}
+ */
+function fnv1a(bytes) {
+  let hash = FNV1A_OFFSET_BASIS;
+  for (const byte of bytes) {
+    hash ^= BigInt(byte);
+    hash = (hash * FNV1A_PRIME) & UINT64_MASK;
+  }
+  return hash;
+}
+
+/**
+ * Writes an LZ4 length that did not fit in the token.
+ * @param {Buffer} out
+ * @param {number} offset
+ * @param {number} length
+ * @returns {number} Offset past the written bytes
+ */
+function writeLZ4Length(out, offset, length) {
+  for (; length >= 255; length -= 255) {
+    out[offset++] = 255;
+  }
+  out[offset++] = length;
+  return offset;
+}
+
+/**
+ * Writes an LZ4 sequence; the match is omitted if its length is 0.
+ * @param {Buffer} out
+ * @param {number} op
+ * @param {Buffer} literals
+ * @param {number} matchOffset
+ * @param {number} matchLength
+ * @returns {number} Offset past the written sequence
+ */
+function writeLZ4Sequence(out, op, literals, matchOffset, matchLength) {
+  const extraMatch = matchLength - LZ4_MIN_MATCH;
+  const token = op++;
+  out[token] =
+    (Math.min(literals.length, 15) << 4) |
+    (matchLength > 0 ? Math.min(extraMatch, 15) : 0);
+  if (literals.length >= 15) {
+    op = writeLZ4Length(out, op, literals.length - 15);
+  }
+  op += literals.copy(out, op);
+  if (matchLength > 0) {
+    op = out.writeUInt16LE(matchOffset, op);
+    if (extraMatch >= 15) {
+      op = writeLZ4Length(out, op, extraMatch - 15);
+    }
+  }
+  return op;
+}
+
+/**
+ * Compresses a single LZ4 block using a greedy, single-probe match finder.
+ * @param {Buffer} input
+ * @returns {Buffer}
+ */
+function lz4CompressBlock(input) {
+  const out = Buffer.alloc(input.length + Math.ceil(input.length / 255) + 16);
+  const table = new Int32Array(1 << LZ4_HASH_BITS).fill(-1);
+  const hash = (/** @type {number} */ i) =>
+    Math.imul(input.readUInt32LE(i), 2654435761) >>> (32 - LZ4_HASH_BITS);
+
+  let op = 0;
+  let anchor = 0;
+  let ip = 0;
+  while (ip + LZ4_MATCH_LIMIT <= input.length) {
+    const h = hash(ip);
+    let ref = table[h];
+    table[h] = ip;
+    if (
+      ref < 0 ||
+      ip - ref > LZ4_MAX_OFFSET ||
+      input.readUInt32LE(ref) !== input.readUInt32LE(ip)
+    ) {
+      ++ip;
+      continue;
+    }
+
+    while (ip > anchor && ref > 0 && input[ip - 1] === input[ref - 1]) {
+      --ip;
+      --ref;
+    }
+
+    const matchEnd = input.length - LZ4_LAST_LITERALS;
+    let length = LZ4_MIN_MATCH;
+    while (
+      ip + length < matchEnd &&
+      input[ref + length] === input[ip + length]
+    ) {
+      ++length;
+    }
+
+    const literals = input.subarray(anchor, ip);
+    op = writeLZ4Sequence(out, op, literals, ip - ref, length);
+    ip += length;
+    anchor = ip;
+  }
+
+  op = writeLZ4Sequence(out, op, input.subarray(anchor), 0, 0);
+  return out.subarray(0, op);
+}
+
+/**
+ * Compresses the specified data into independent LZ4 blocks.
+ * @param {Buffer} data
+ * @returns {Buffer}
+ */
+function lz4Compress(data) {
+  const blocks = [];
+  for (let offset = 0; offset < data.length; offset += LZ4_BLOCK_SIZE) {
+    const block = data.subarray(offset, offset + LZ4_BLOCK_SIZE);
+    const compressed = lz4CompressBlock(block);
+    blocks.push(compressed.length < block.length ? compressed : block);
+  }
+
+  const table = Buffer.alloc(blocks.length * 4);
+  blocks.reduce((end, block, i) => {
+    table.writeUInt32LE(end + block.length, i * 4);
+    return end + block.length;
+  }, 0);
+  return Buffer.concat([table, ...blocks]);
+}
+
+/**
+ * Returns all files under the specified directory, relative to it.
+ * @param {string} directory
+ * @param {string=} prefix
+ * @returns {string[]}
+ */
+function listFiles(directory, prefix = "") {
+  return fs
+    .readdirSync(path.join(directory, prefix), { withFileTypes: true })
+    .flatMap((entry) => {
+      const name = prefix ? `${prefix}/${entry.name}` : entry.name;
+      if (entry.isDirectory()) {
+        return listFiles(directory, name);
+      }
+      return entry.isFile() ? [name] : [];
+    });
+}
+
+/**
+ * Returns the specified offset rounded up to a multiple of alignment.
+ * @param {number} offset
+ * @param {number} alignment
+ * @returns {number}
+ */
+function align(offset, alignment) {
+  return Math.ceil(offset / alignment) * alignment;
+}
+
+/**
+ * Serializes the specified entries into a pack.
+ * @param {Entry[]} entries
+ * @returns {Buffer}
+ */
+function encodePack(entries) {
+  entries.sort((a, b) =>
+    a.hash === b.hash ? (a.name < b.name ? -1 : 1) : a.hash < b.hash ? -1 : 1
+  );
+
+  const names = Buffer.from(entries.map(({ name }) => name).join(""), "utf8");
+  const contentHashesOffset = HEADER_SIZE + entries.length * ENTRY_SIZE;
+  const namesOffset = contentHashesOffset + entries.length * CONTENT_HASH_SIZE;
+  const indexEnd = namesOffset + names.length;
+
+  // The trailing null byte lets readers use entries as strings without
+  // copying them.
+  /** @type {Map<bigint, { data: Buffer; offset: number }[]>} */
+  const stored = new Map();
+  const offsets = [];
+  let offset = indexEnd;
+  for (const { contentHash, data } of entries) {
+    const candidates = stored.get(contentHash) || [];
+    const duplicate = candidates.find((other) => other.data.equals(data));
+    if (duplicate) {
+      offsets.push(duplicate.offset);
+      continue;
+    }
+
+    const alignment = data.length >= PAGE_SIZE ? PAGE_SIZE : MIN_ALIGNMENT;
+    offset = align(offset, alignment);
+    offsets.push(offset);
+    stored.set(contentHash, [...candidates, { data, offset }]);
+    offset += data.length + 1;
+  }
+
+  const pack = Buffer.alloc(offset);
+  pack.write(PACK_MAGIC, 0, "ascii");
+  pack.writeUInt32LE(PACK_VERSION, 4);
+  pack.writeUInt32LE(entries.length, 8);
+  pack.writeUInt32LE(names.length, 12);
+
+  const fanout = new Array(256).fill(0);
+  for (const { hash } of entries) {
+    ++fanout[Number(hash >> 56n)];
+  }
+  fanout.reduce((count, n, i) => {
+    pack.writeUInt32LE(count + n, 16 + i * 4);
+    return count + n;
+  }, 0);
+
+  let nameOffset = 0;
+  entries.forEach(({ name, hash, contentHash, data, size, compression }, i) => {
+    const nameLength = Buffer.byteLength(name, "utf8");
+    const entry = HEADER_SIZE + i * ENTRY_SIZE;
+    pack.writeBigUInt64LE(hash, entry);
+    pack.writeBigUInt64LE(BigInt(offsets[i]), entry + 8);
+    pack.writeUInt32LE(data.length, entry + 16);
+    pack.writeUInt32LE(size, entry + 20);
+    pack.writeUInt32LE(nameOffset, entry + 24);
+    pack.writeUInt16LE(nameLength, entry + 28);
+    pack.writeUInt16LE(compression, entry + 30);
+    pack.writeBigUInt64LE(
+      contentHash,
+      contentHashesOffset + i * CONTENT_HASH_SIZE
+    );
+    data.copy(pack, offsets[i]);
+    nameOffset += nameLength;
+  });
+  names.copy(pack, namesOffset);
+
+  return pack;
+}
+
+/**
+ * Reads and optionally compresses the file at the specified path.
+ * @param {string} directory
+ * @param {string} name
+ * @param {Compression} compression
+ * @returns {Entry}
+ */
+function readEntry(directory, name, compression) {
+  const data = fs.readFileSync(path.join(directory, name));
+  const hash = fnv1a(Buffer.from(name, "utf8"));
+  const contentHash = fnv1a(data);
+  if (compression !== "none" && data.length > 0) {
+    const compressed =
+      compression === "lz4"
+        ? lz4Compress(data)
+        : zlib.deflateSync(data, { level: 9 });
+    if (compressed.length < data.length * MIN_COMPRESSION_RATIO) {
+      return {
+        name,
+        hash,
+        contentHash,
+        data: compressed,
+        size: data.length,
+        compression:
+          compression === "lz4" ? COMPRESSION_LZ4 : COMPRESSION_DEFLATE,
+      };
+    }
+  }
+  return {
+    name,
+    hash,
+    contentHash,
+    data,
+    size: data.length,
+    compression: COMPRESSION_NONE,
+  };
+}
+
+/**
+ * Packs the specified directory.
+ * @param {string} directory
+ * @param {string} output
+ * @param {{ compression: Compression }} options
+ */
+function pack(directory, output, { compression }) {
+  const entries = listFiles(directory)
+    .filter((name) => path.resolve(directory, name) !== path.resolve(output))
+    .map((name) => readEntry(directory, name, compression));
+  const packed = encodePack(entries);
+  fs.writeFileSync(output, packed, { mode: 0o644 });
+
+  const compressed = entries.filter(
+    ({ compression }) => compression !== COMPRESSION_NONE
+  ).length;
+  const unique = new Set(entries.map(({ contentHash }) => contentHash));
+  const duplicates = entries.length - unique.size;
+  const size = entries.reduce((size, entry) => size + entry.size, 0);
+  const ratio = size > 0 ? ((packed.length / size) * 100).toFixed(1) : "100";
+  /* eslint-disable no-console */
+  console.log(`${directory} -> ${output}`);
+  console.log(
+    `  ${entries.length} files, ${compressed} compressed (${compression}), ` +
+      `${duplicates} duplicates`
+  );
+  console.log(`  ${size} -> ${packed.length} bytes (${ratio}%)`);
+  /* eslint-enable no-console */
+}
+
+if (require.main && require.main.filename === __filename) {
+  const args = process.argv.slice(process.argv.indexOf(__filename) + 1);
+  const compression = args.includes("--no-compress")
+    ? "none"
+    : args.includes("--lz4")
+    ? "lz4"
+    : "deflate";
+  const [directory, output] = args.filter((arg) => !arg.startsWith("--"));
+  if (!directory || !output) {
+    // eslint-disable-next-line no-console
+    console.log(
+      "Usage: node tools/pack-assets.js [options] <directory> <output.rpak>"
+    );
+    process.exit(1);
+  }
+  pack(directory, output, { compression });
+}
+
+module.exports = {
+  encodePack,
+  fnv1a,
+  lz4Compress,
+};